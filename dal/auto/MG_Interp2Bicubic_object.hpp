@@ -0,0 +1,7 @@
+// This file is auto-generated by machinist. Please don't modify it manually.
+#pragma once
+#include <dal/utilities/dictionary.hpp>
+
+class UIRow_;
+class Storable_;
+
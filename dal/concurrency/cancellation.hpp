@@ -0,0 +1,58 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <dal/platform/platform.hpp>
+#include <memory>
+
+namespace Dal {
+    /*
+     * Cooperative cancellation
+     * copies of a token share their state, so the requester keeps one copy and hands others to the workers;
+     * long-running loops poll IsCancelled() and stop early
+     * an optional deadline makes the token cancel itself once passed
+     */
+
+    class CancellationToken_ {
+    public:
+        using Clock_ = std::chrono::steady_clock;
+
+    private:
+        struct State_ {
+            std::atomic<bool> cancelled_;
+            const bool hasDeadline_;
+            const Clock_::time_point deadline_;
+            State_(bool has_deadline, const Clock_::time_point& deadline)
+                : cancelled_(false), hasDeadline_(has_deadline), deadline_(deadline) {}
+        };
+        std::shared_ptr<State_> state_;
+
+    public:
+        CancellationToken_() : state_(std::make_shared<State_>(false, Clock_::time_point())) {}
+        explicit CancellationToken_(const Clock_::time_point& deadline)
+            : state_(std::make_shared<State_>(true, deadline)) {}
+
+        template <class D_> static CancellationToken_ WithTimeout(const D_& timeout) {
+            return CancellationToken_(Clock_::now() + timeout);
+        }
+
+        void Cancel() const { state_->cancelled_.store(true, std::memory_order_relaxed); }
+
+        bool IsCancelled() const {
+            if (state_->cancelled_.load(std::memory_order_relaxed))
+                return true;
+            if (state_->hasDeadline_ && Clock_::now() >= state_->deadline_) {
+                Cancel();
+                return true;
+            }
+            return false;
+        }
+
+        bool HasDeadline() const { return state_->hasDeadline_; }
+        const Clock_::time_point& Deadline() const { return state_->deadline_; }
+    };
+} // namespace Dal
@@ -0,0 +1,86 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/concurrency/taskgraph.hpp>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/platform/strict.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+namespace Dal {
+    int TaskGraph_::Add(const String_& name, Job_ job, const Vector_<int>& dependencies) {
+        const int ret_val = static_cast<int>(nodes_.size());
+        for (auto d : dependencies)
+            REQUIRE(d >= 0 && d < ret_val, "Task graph dependency must refer to an existing node");
+        Node_ node;
+        node.name_ = name;
+        node.job_ = std::move(job);
+        node.nDependencies_ = static_cast<int>(Unique(dependencies).size());
+        nodes_.push_back(std::move(node));
+        for (auto d : Unique(dependencies))
+            nodes_[d].dependants_.push_back(ret_val);
+        return ret_val;
+    }
+
+    void TaskGraph_::Schedule(ThreadPool_* pool, int node, const CancellationToken_& token, const Done_& all_done) {
+        pool->SpawnTask([this, pool, node, token, all_done]() {
+            Execute(pool, node, token, all_done);
+            return true;
+        });
+    }
+
+    void TaskGraph_::Execute(ThreadPool_* pool, int node, const CancellationToken_& token, const Done_& all_done) {
+        if (upstreamFailed_[node].load(std::memory_order_acquire) || token.IsCancelled())
+            status_[node] = Status_::SKIPPED;
+        else {
+            try {
+                nodes_[node].job_();
+                status_[node] = Status_::DONE;
+            } catch (...) {
+                errors_[node] = std::current_exception();
+                status_[node] = Status_::FAILED;
+            }
+        }
+
+        const bool ok = status_[node] == Status_::DONE;
+        for (auto d : nodes_[node].dependants_) {
+            if (!ok)
+                upstreamFailed_[d].store(true, std::memory_order_release);
+            if (remaining_[d].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Schedule(pool, d, token, all_done);
+        }
+        // must be the last access to this graph: the waiting thread may return as soon as it is set,
+        // while this task's copy of all_done keeps the promise alive until set_value has returned
+        if (unsettled_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            all_done->set_value(true);
+    }
+
+    void TaskGraph_::Run(ThreadPool_* pool, const CancellationToken_& token) {
+        if (!pool)
+            pool = ThreadPool_::GetInstance();
+        const int n = static_cast<int>(nodes_.size());
+        if (n == 0)
+            return;
+
+        remaining_.reset(new std::atomic<int>[n]);
+        upstreamFailed_.reset(new std::atomic<bool>[n]);
+        status_ = Vector_<Status_>(n, Status_::PENDING);
+        errors_ = Vector_<std::exception_ptr>(n);
+        for (int i = 0; i < n; ++i) {
+            remaining_[i] = nodes_[i].nDependencies_;
+            upstreamFailed_[i] = false;
+        }
+        unsettled_ = n;
+
+        const Done_ allDone = std::make_shared<std::promise<bool>>();
+        TaskHandle_ done = allDone->get_future();
+        for (int i = 0; i < n; ++i)
+            if (nodes_[i].nDependencies_ == 0)
+                Schedule(pool, i, token, allDone);
+        pool->ActiveWaite(done);
+
+        for (int i = 0; i < n; ++i)
+            if (errors_[i])
+                std::rethrow_exception(errors_[i]);
+    }
+} // namespace Dal
@@ -0,0 +1,73 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <atomic>
+#include <dal/concurrency/cancellation.hpp>
+#include <dal/math/vectors.hpp>
+#include <dal/platform/platform.hpp>
+#include <dal/string/strings.hpp>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace Dal {
+    class ThreadPool_;
+
+    /*
+     * Dependency graph of jobs, run on a ThreadPool_
+     * a node becomes runnable as soon as all of its dependencies have completed,
+     * so independent branches (e.g. curves of different currencies) overlap instead of waiting on a barrier
+     * if a job throws, its dependants (direct and indirect) are skipped, while independent branches carry on
+     */
+
+    class TaskGraph_ : noncopyable {
+    public:
+        using Job_ = std::function<void()>;
+        enum class Status_ { PENDING, DONE, FAILED, SKIPPED };
+
+    private:
+        struct Node_ {
+            String_ name_;
+            Job_ job_;
+            Vector_<int> dependants_;
+            int nDependencies_ = 0;
+        };
+        Vector_<Node_> nodes_;
+
+        // run-time state, reset by each Run()
+        std::unique_ptr<std::atomic<int>[]> remaining_;
+        std::unique_ptr<std::atomic<bool>[]> upstreamFailed_;
+        Vector_<Status_> status_;
+        Vector_<std::exception_ptr> errors_;
+        std::atomic<int> unsettled_;
+
+        // the tasks share ownership of the promise, so that the last one can still be setting it when Run returns
+        using Done_ = std::shared_ptr<std::promise<bool>>;
+        void Schedule(ThreadPool_* pool, int node, const CancellationToken_& token, const Done_& all_done);
+        void Execute(ThreadPool_* pool, int node, const CancellationToken_& token, const Done_& all_done);
+
+    public:
+        TaskGraph_() : unsettled_(0) {}
+
+        // dependencies must have been added before, which keeps the graph acyclic; returns the id of the new node
+        int Add(const String_& name, Job_ job, const Vector_<int>& dependencies = Vector_<int>());
+
+        size_t Size() const { return nodes_.size(); }
+        const String_& Name(int node) const { return nodes_[node].name_; }
+
+        /*
+         * runs all nodes on the pool (default pool if null) and returns when every node is settled
+         * the waiting thread executes queued tasks meanwhile
+         * nodes not yet started when the token is cancelled are skipped
+         * rethrows the exception of the first failed node (in order of Add), if any
+         */
+        void Run(ThreadPool_* pool = nullptr, const CancellationToken_& token = CancellationToken_());
+
+        Status_ Status(int node) const { return status_.empty() ? Status_::PENDING : status_[node]; }
+        std::exception_ptr Error(int node) const { return errors_.empty() ? nullptr : errors_[node]; }
+    };
+} // namespace Dal
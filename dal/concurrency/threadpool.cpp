@@ -7,21 +7,84 @@
 
 namespace Dal {
 
-    ThreadPool_ ThreadPool_::instance_;
+    double ThreadPoolStats_::Utilisation(size_t i_worker) const {
+        const double total = busySeconds_[i_worker] + idleSeconds_[i_worker];
+        return total > 0.0 ? busySeconds_[i_worker] / total : 0.0;
+    }
+
+    ThreadPool_ ThreadPool_::instance_("default");
     thread_local size_t ThreadPool_::tlsNum_ = 0;
+    thread_local const ThreadPool_* ThreadPool_::tlsPool_ = nullptr;
+
+    namespace {
+        size_t LatencyBucket(int64_t nanoseconds) {
+            size_t ret_val = 0;
+            for (int64_t us = nanoseconds / 1000; us > 0 && ret_val < ThreadPoolStats_::N_LATENCY_BUCKETS - 1; us >>= 1)
+                ++ret_val;
+            return ret_val;
+        }
+
+        template <class T_> void UpdateMax(std::atomic<T_>* dst, const T_& val) {
+            T_ prev = dst->load(std::memory_order_relaxed);
+            while (prev < val && !dst->compare_exchange_weak(prev, val, std::memory_order_relaxed))
+                ;
+        }
+    } // namespace
+
+    ThreadPool_::ThreadPool_(const String_& name)
+        : name_(name), active_(false), interrupt_(false), instrumented_(false), queueDepth_(0), queueHighWater_(0),
+          submitted_(0), completed_(0), executedInline_(0) {
+        for (auto& l : latencies_)
+            l = 0;
+    }
+
+    void ThreadPool_::Push(Task_ t) {
+        QueuedTask_ q;
+        q.task_ = std::move(t);
+        if (IsInstrumented()) {
+            q.enqueued_ = Now();
+            ++submitted_;
+            UpdateMax(&queueHighWater_, queueDepth_.fetch_add(1, std::memory_order_relaxed) + 1);
+        }
+        queue_.Push(std::move(q));
+    }
+
+    void ThreadPool_::Run(QueuedTask_& t, bool is_inline) {
+        // only tasks stamped on the way in were counted into the depth
+        if (t.enqueued_ > 0)
+            queueDepth_.fetch_sub(1, std::memory_order_relaxed);
+        if (IsInstrumented()) {
+            if (t.enqueued_ > 0)
+                ++latencies_[LatencyBucket(Now() - t.enqueued_)];
+            if (is_inline)
+                ++executedInline_;
+        }
+        t.task_();
+    }
 
     void ThreadPool_::ThreadFunc(const size_t& num) {
         tlsNum_ = num;
-        Task_ t;
+        tlsPool_ = this;
+        WorkerCounters_& counters = workers_[num - 1];
+        QueuedTask_ t;
         while (!interrupt_) {
+            const int64_t waitFrom = IsInstrumented() ? Now() : 0;
             bool flag = queue_.Pop(t);
-            if (flag && !interrupt_)
-                t();
+            if (flag && !interrupt_) {
+                if (waitFrom > 0) {
+                    const int64_t runFrom = Now();
+                    counters.idle_.fetch_add(runFrom - waitFrom, std::memory_order_relaxed);
+                    Run(t, false);
+                    counters.busy_.fetch_add(Now() - runFrom, std::memory_order_relaxed);
+                } else
+                    Run(t, false);
+            }
         }
     }
 
     void ThreadPool_::Start(const size_t& nThread) {
         if (!active_) {
+            workers_.reset(new WorkerCounters_[nThread]);
             threads_.reserve(nThread);
             for (size_t i = 0; i < nThread; ++i)
                 threads_.push_back(std::thread(&ThreadPool_::ThreadFunc, this, i + 1));
@@ -36,6 +99,7 @@ namespace Dal {
             for_each(threads_.begin(), threads_.end(), std::mem_fn(&std::thread::join));
             threads_.clear();
             queue_.Clear();
+            queueDepth_ = 0;
             queue_.ResetInterrupt();
             active_ = false;
             interrupt_ = false;
@@ -43,16 +107,49 @@ namespace Dal {
     }
 
     bool ThreadPool_::ActiveWaite(const TaskHandle_& f) {
-        Task_ t;
+        QueuedTask_ t;
         bool b = false;
 
         while (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
             if (queue_.TryPop(t)) {
-                t();
+                Run(t, true);
                 b = true;
             } else
                 f.wait();
         }
         return b;
     }
-} // namespace Dal
\ No newline at end of file
+
+    ThreadPoolStats_ ThreadPool_::Stats() const {
+        ThreadPoolStats_ ret_val;
+        ret_val.submitted_ = submitted_;
+        ret_val.completed_ = completed_;
+        ret_val.executedInline_ = executedInline_;
+        ret_val.queueDepth_ = static_cast<size_t>(Max<int64_t>(0, queueDepth_));
+        ret_val.queueHighWater_ = static_cast<size_t>(queueHighWater_);
+        ret_val.latencyHistogram_.Resize(ThreadPoolStats_::N_LATENCY_BUCKETS);
+        for (size_t i = 0; i < ThreadPoolStats_::N_LATENCY_BUCKETS; ++i)
+            ret_val.latencyHistogram_[i] = latencies_[i];
+        const size_t n = NumThreads();
+        ret_val.busySeconds_.Resize(n);
+        ret_val.idleSeconds_.Resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            ret_val.busySeconds_[i] = 1.0e-9 * workers_[i].busy_;
+            ret_val.idleSeconds_[i] = 1.0e-9 * workers_[i].idle_;
+        }
+        return ret_val;
+    }
+
+    void ThreadPool_::ResetStats() {
+        submitted_ = 0;
+        completed_ = 0;
+        executedInline_ = 0;
+        queueHighWater_ = queueDepth_.load();
+        for (auto& l : latencies_)
+            l = 0;
+        for (size_t i = 0; i < NumThreads(); ++i) {
+            workers_[i].busy_ = 0;
+            workers_[i].idle_ = 0;
+        }
+    }
+} // namespace Dal
@@ -12,34 +12,109 @@
 
 #pragma once
 
+#include <dal/concurrency/cancellation.hpp>
 #include <dal/concurrency/concurrentqueue.hpp>
+#include <dal/concurrency/workspace.hpp>
 #include <dal/math/vectors.hpp>
 #include <dal/platform/platform.hpp>
+#include <dal/string/strings.hpp>
+#include <atomic>
+#include <chrono>
 #include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <typeindex>
 
 namespace Dal {
     using Task_ = std::packaged_task<bool(void)>;
     using TaskHandle_ = std::future<bool>;
 
+    /*
+     * Snapshot of the counters of a ThreadPool_
+     * all counts are since the last ResetStats(), and only accumulate while the pool is instrumented
+     */
+
+    struct ThreadPoolStats_ {
+        // latency bucket i counts tasks which waited less than 2^i microseconds (and at least 2^(i-1)),
+        // the last bucket counts all longer waits
+        static constexpr size_t N_LATENCY_BUCKETS = 24;
+
+        size_t submitted_ = 0;
+        size_t completed_ = 0;
+        size_t executedInline_ = 0; // run by ActiveWaite on the waiting thread
+        size_t queueDepth_ = 0;     // tasks queued while instrumented and not yet started
+        size_t queueHighWater_ = 0;
+        Vector_<size_t> latencyHistogram_;
+        Vector_<double> busySeconds_; // element i for the worker with ThreadNum() == i + 1
+        Vector_<double> idleSeconds_;
+
+        double Utilisation(size_t i_worker) const;
+    };
+
+    /*
+     * A pool of worker threads sharing one task queue
+     * GetInstance() gives the process-wide default pool,
+     * further pools may be constructed to isolate workloads (e.g. intraday vs. batch)
+     */
+
     class ThreadPool_ {
+        using Clock_ = std::chrono::steady_clock;
+        struct QueuedTask_ {
+            Task_ task_;
+            int64_t enqueued_ = 0; // nanoseconds since epoch, only stamped (and counted in depth) when instrumented
+        };
+        // each worker writes only to its own counters, kept on separate cache lines
+        struct alignas(CACHE_LINE_SIZE) WorkerCounters_ {
+            std::atomic<int64_t> busy_{0};
+            std::atomic<int64_t> idle_{0};
+        };
+
         static ThreadPool_ instance_;
-        ConcurrentQueue_<Task_> queue_;
+        const String_ name_;
+        ConcurrentQueue_<QueuedTask_> queue_;
         Vector_<std::thread> threads_;
         bool active_;
-        bool interrupt_;
+        std::atomic<bool> interrupt_;
         static thread_local size_t tlsNum_;
+        static thread_local const ThreadPool_* tlsPool_;
 
+        std::atomic<bool> instrumented_;
+        std::atomic<int64_t> queueDepth_;
+        std::atomic<int64_t> queueHighWater_;
+        std::atomic<size_t> submitted_;
+        std::atomic<size_t> completed_;
+        std::atomic<size_t> executedInline_;
+        std::atomic<size_t> latencies_[ThreadPoolStats_::N_LATENCY_BUCKETS];
+        std::unique_ptr<WorkerCounters_[]> workers_;
+
+        std::mutex workspaceMutex_;
+        std::map<std::type_index, std::shared_ptr<void>> workspaces_;
+
+        static int64_t Now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_::now().time_since_epoch()).count();
+        }
+        void Push(Task_ t);
+        void Run(QueuedTask_& t, bool is_inline);
         void ThreadFunc(const size_t& num);
-        //  The constructor stays private, ensuring single instance
-        ThreadPool_() : active_(false), interrupt_(false) {}
 
     public:
+        explicit ThreadPool_(const String_& name = String_());
+        ThreadPool_(const String_& name, const size_t& nThread) : ThreadPool_(name) { Start(nThread); }
+
         static ThreadPool_* GetInstance() { return &instance_; }
 
+        const String_& Name() const { return name_; }
+
         size_t NumThreads() const { return threads_.size(); }
 
-        static size_t ThreadNum() { return tlsNum_; }
+        /*
+         * number of the calling thread within this pool, in [1, NumThreads()] for the pool's own workers,
+         * 0 for any other thread (main thread, or a worker of another pool)
+         * several outside threads may run tasks inline at once, so per-thread state must not share a slot 0 among them
+         */
+        size_t ThreadNum() const { return tlsPool_ == this ? tlsNum_ : 0; }
 
         void Start(const size_t& nThread = std::thread::hardware_concurrency() - 1);
 
@@ -53,17 +128,78 @@ namespace Dal {
         ThreadPool_& operator=(ThreadPool_&& rhs) = delete;
 
         template <class C_> TaskHandle_ SpawnTask(C_ c) {
-            Task_ t(std::move(c));
+            Task_ t;
+            if (IsInstrumented()) {
+                // the completion is counted within the task, so it is seen by whoever waits on its future
+                t = Task_([this, c = std::move(c)]() mutable {
+                    const bool ret_val = c();
+                    ++completed_;
+                    return ret_val;
+                });
+            } else
+                t = Task_(std::move(c));
             TaskHandle_ f = t.get_future();
-            queue_.Push(move(t));
+            Push(std::move(t));
             return f;
         }
 
+        /*
+         * the task is dropped (returns false without running) if the token is cancelled before it starts;
+         * once started, it is up to the task itself to poll the token
+         */
+        template <class C_> TaskHandle_ SpawnTask(C_ c, const CancellationToken_& token) {
+            return SpawnTask([c = std::move(c), token]() mutable { return token.IsCancelled() ? false : c(); });
+        }
+
         /*
          * Run queued tasks synchronously
          * while waiting on a future,
          * return true if at least one task was run
          */
         bool ActiveWaite(const TaskHandle_& f);
+
+        /*
+         * Per-worker scratch space, distinguished by object type and by a tag type
+         * look it up once per call, then each task gets its own object with Mine(ThreadNum())
+         * the returned reference stays valid as long as the pool is not restarted with more threads
+         */
+        template <class T_, class Tag_ = T_> Workspace_<T_, Tag_>& Workspace() {
+            using workspace_t = Workspace_<T_, Tag_>;
+            std::lock_guard<std::mutex> lk(workspaceMutex_);
+            auto& slot = workspaces_[std::type_index(typeid(workspace_t))];
+            if (!slot)
+                slot = std::make_shared<workspace_t>();
+            auto& ret_val = *static_cast<workspace_t*>(slot.get());
+            ret_val.Reserve(NumThreads() + 1);
+            return ret_val;
+        }
+
+        /*
+         * Instrumentation -- off by default; when off, the only cost is a relaxed load per task
+         */
+        void Instrument(bool on) { instrumented_.store(on, std::memory_order_relaxed); }
+        bool IsInstrumented() const { return instrumented_.load(std::memory_order_relaxed); }
+        ThreadPoolStats_ Stats() const;
+        void ResetStats();
     };
+
+    /*
+     * Runs f(begin, end) over [0, n) in blocks of the given size:
+     * as one task per block on the pool if one is given and there is more than one block, else in turn on this thread
+     */
+    template <class F_> void ParallelBlocks(ThreadPool_* pool, int n, int block, const F_& f) {
+        if (!pool || n <= block) {
+            for (int begin = 0; begin < n; begin += block)
+                f(begin, Min(begin + block, n));
+            return;
+        }
+        Vector_<TaskHandle_> tasks;
+        for (int begin = 0; begin < n; begin += block)
+            tasks.push_back(pool->SpawnTask([&f, begin, block, n]() {
+                f(begin, Min(begin + block, n));
+                return true;
+            }));
+        for (auto& t : tasks)
+            pool->ActiveWaite(t);
+    }
 } // namespace Dal
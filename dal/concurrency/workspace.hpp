@@ -0,0 +1,40 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/vectors.hpp>
+#include <dal/platform/platform.hpp>
+
+namespace Dal {
+    // pads its content to whole cache lines, so that neighbours in an array never share a line
+    template <class T_> struct alignas(CACHE_LINE_SIZE) CacheAligned_ { T_ val_; };
+
+    /*
+     * Per-thread scratch objects of one type, Tag_ tells apart unrelated uses of the same type
+     * slot i belongs to the worker with ThreadNum() == i; the slots survive across tasks and calls,
+     * so buffers sized once are reused (warm) by subsequent calls
+     * slot 0 is not used: threads outside the pool get a thread-local object instead, see Mine()
+     */
+
+    template <class T_, class Tag_ = T_> class Workspace_ {
+        Vector_<CacheAligned_<T_>> slots_;
+
+    public:
+        void Reserve(size_t n_slots) {
+            if (slots_.size() < n_slots)
+                slots_.Resize(n_slots);
+        }
+        size_t Size() const { return slots_.size(); }
+        T_& operator[](size_t thread_num) { return slots_[thread_num].val_; }
+
+        // the object of the calling thread, given its ThreadNum() in the owning pool
+        T_& Mine(size_t thread_num) {
+            if (thread_num > 0)
+                return slots_[thread_num].val_;
+            static thread_local T_ outsider;
+            return outsider;
+        }
+    };
+} // namespace Dal
@@ -447,6 +447,18 @@ namespace Dal {
 
         void PutOnTape() { node_ = CreateMultiNode<0>(); }
 
+        // a function of n arguments whose value and partial derivatives are computed elsewhere, recorded as one node
+        static Number_ Record(double val, size_t n, const Number_* args, const double* ders) {
+            Number_ ret_val;
+            ret_val.value_ = val;
+            ret_val.node_ = tape_->RecordNode(n);
+            for (size_t i = 0; i < n; ++i) {
+                ret_val.node_->p_derivatives_[i] = ders[i];
+                ret_val.node_->p_adj_ptrs_[i] = Tape_::multi_ ? args[i].node_->p_adjoints_ : &args[i].node_->adjoint_;
+            }
+            return ret_val;
+        }
+
         double& Value() { return value_; }
         [[nodiscard]] double Value() const override { return value_; }
 
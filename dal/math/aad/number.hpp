@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include <dal/math/aad/tape.hpp>
+#include <dal/math/specialfunctions.hpp>
 #include <dal/platform/platform.hpp>
 #include <dal/utilities/exceptions.hpp>
 
@@ -77,6 +78,18 @@ namespace Dal {
 
         void PutOnTape() { CreateNode<0>(); }
 
+        // a function of n arguments whose value and partial derivatives are computed elsewhere, recorded as one node
+        static Number_ Record(double val, size_t n, const Number_* args, const double* ders) {
+            Number_ ret_val;
+            ret_val.value_ = val;
+            ret_val.node_ = tape_->RecordNode(n);
+            for (size_t i = 0; i < n; ++i) {
+                ret_val.node_->p_derivatives_[i] = ders[i];
+                ret_val.node_->p_adj_ptrs_[i] = Tape_::multi_ ? args[i].node_->p_adjoints_ : &args[i].node_->adjoint_;
+            }
+            return ret_val;
+        }
+
         explicit operator double&() { return value_; }
 
         explicit operator double() { return value_; }
@@ -347,6 +360,19 @@ namespace Dal {
             return result;
         }
 
+        inline friend Number_ NormalDens(const Number_& arg) {
+            const double e = NPDF(arg.Value());
+            Number_ result(arg.Node(), e);
+            result.Derivative() = -arg.Value() * e;
+            return result;
+        }
+
+        inline friend Number_ NormalCdf(const Number_& arg) {
+            Number_ result(arg.Node(), NCDF(arg.Value()));
+            result.Derivative() = NPDF(arg.Value());
+            return result;
+        }
+
         inline friend bool operator==(const Number_& lhs, const Number_& rhs) { return lhs.Value() == rhs.Value(); }
 
         inline friend bool operator==(const Number_& lhs, double rhs) { return lhs.Value() == rhs; }
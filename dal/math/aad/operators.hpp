@@ -5,12 +5,15 @@
 #pragma once
 #include <cmath>
 #include <dal/math/aad/number.hpp>
+#include <dal/math/specialfunctions.hpp>
 
 namespace Dal {
     template <class T_> inline T_ Sqrt(const T_& t) { return std::sqrt(t); }
     template <class T_> inline T_ Exp(const T_& t) { return std::exp(t); }
     template <class T_> inline T_ Fabs(const T_& t) { return std::fabs(t); }
     template <class T_> inline T_ Log(const T_& t) { return std::log(t); }
+    template <class T_> inline T_ NormalDens(const T_& t) { return NPDF(t); }
+    template <class T_> inline T_ NormalCdf(const T_& t) { return NCDF(t); }
     template <class T_, class U_> inline T_ Pow(const T_& t, const U_& u) { return std::pow(t, u); }
     template <class T_> inline T_ Plus(const T_& t1, const T_& t2) { return t1 + t2; }
 } // namespace Dal
@@ -10,7 +10,11 @@
 
 namespace Dal {
 
-    Matrix_<> MCSimulation(const Product_<>& prd, const Model_<>& mdl, const std::unique_ptr<Random_>& rng, int nPath) {
+    Matrix_<> MCSimulation(const Product_<>& prd,
+                           const Model_<>& mdl,
+                           const std::unique_ptr<Random_>& rng,
+                           int nPath,
+                           const CancellationToken_& token) {
         REQUIRE(CheckCompatibility(prd, mdl), "model and products are not compatible");
         auto cMdl = mdl.Clone();
 
@@ -25,6 +29,10 @@ namespace Dal {
         InitializePath(path);
 
         for (size_t i = 0; i < nPath; ++i) {
+            if (token.IsCancelled()) {
+                results.Resize(static_cast<int>(i), static_cast<int>(nPay));
+                break;
+            }
             rng->FillNormal(&gaussVec);
             cMdl->GeneratePath(gaussVec, &path);
             prd.Payoffs(path, results[i]);
@@ -34,10 +42,20 @@ namespace Dal {
 
     constexpr const int BATCH_SIZE = 65536;
 
+    namespace {
+        // per-worker buffers of MCParallelSimulation, kept warm in the pool between calls
+        struct MCScratch_ {
+            Vector_<> gaussVec_;
+            Scenario_<> path_;
+        };
+    } // namespace
+
     Matrix_<> MCParallelSimulation(const Product_<>& prd,
                                    const Model_<>& mdl,
                                    const std::unique_ptr<PseudoRandom_>& rng,
-                                   int nPath) {
+                                   int nPath,
+                                   ThreadPool_* pool,
+                                   const CancellationToken_& token) {
         REQUIRE(CheckCompatibility(prd, mdl), "model and products are not compatible");
         auto cMdl = mdl.Clone();
 
@@ -47,51 +65,75 @@ namespace Dal {
         cMdl->Allocate(prd.TimeLine(), prd.DefLine());
         cMdl->Init(prd.TimeLine(), prd.DefLine());
 
-        ThreadPool_* pool = ThreadPool_::GetInstance();
+        if (!pool)
+            pool = ThreadPool_::GetInstance();
         const size_t nThread = pool->NumThreads();
-        Vector_<Vector_<>> gaussVecs(nThread + 1);
-        Vector_<Scenario_<>> paths(nThread + 1);
-
-        for (auto& vec : gaussVecs)
-            vec.Resize(cMdl->SimDim());
-        for (auto& path : paths) {
-            AllocatePath(prd.DefLine(), path);
-            InitializePath(path);
-        }
+        auto& scratch = pool->Workspace<MCScratch_>();
 
+        // one generator per worker; slot 0 is not used, see below
         Vector_<std::unique_ptr<PseudoRandom_>> rng_s(nThread + 1);
-        for (auto& random : rng_s)
-            random = std::unique_ptr<PseudoRandom_>(rng->Clone());
+        for (size_t i = 1; i <= nThread; ++i)
+            rng_s[i] = std::unique_ptr<PseudoRandom_>(rng->Clone());
 
+        const size_t nBatch = nPath / BATCH_SIZE + 1;
         Vector_<TaskHandle_> futures;
-        futures.reserve(nPath / BATCH_SIZE + 1);
+        futures.reserve(nBatch);
+        // number of paths completed by each batch, written by the batch itself
+        Vector_<size_t> pathsDone(nBatch, 0);
 
         size_t firstPath = 0;
         size_t pathsLeft = nPath;
 
         while (pathsLeft > 0) {
             size_t pathsInTask = std::min<size_t>(pathsLeft, BATCH_SIZE);
-            futures.push_back(pool->SpawnTask([&, firstPath, pathsInTask]() {
-                const size_t threadNum = pool->ThreadNum();
-                Vector_<>& gaussVec = gaussVecs[threadNum];
-                Scenario_<>& path = paths[threadNum];
-
-                auto& random = rng_s[threadNum];
-                random->SkipTo(firstPath * nPay);
-
-                for (size_t i = 0; i < pathsInTask; ++i) {
-                    random->FillNormal(&gaussVec);
-                    cMdl->GeneratePath(gaussVec, &path);
-                    prd.Payoffs(path, results[firstPath + i]);
-                }
-                return true;
-            }));
+            const size_t iBatch = futures.size();
+            futures.push_back(pool->SpawnTask(
+                [&, firstPath, pathsInTask, iBatch]() {
+                    const size_t threadNum = pool->ThreadNum();
+                    MCScratch_& mine = scratch.Mine(threadNum);
+                    Vector_<>& gaussVec = mine.gaussVec_;
+                    Scenario_<>& path = mine.path_;
+                    gaussVec.Resize(cMdl->SimDim());
+                    AllocatePath(prd.DefLine(), path);
+                    InitializePath(path);
+
+                    // threads outside the pool all have ThreadNum() 0 and may run batches at the same time,
+                    // so each batch they take gets its own generator
+                    std::unique_ptr<PseudoRandom_> outsider;
+                    if (threadNum == 0)
+                        outsider.reset(rng->Clone());
+                    PseudoRandom_* random = threadNum == 0 ? outsider.get() : rng_s[threadNum].get();
+                    random->SkipTo(firstPath * nPay);
+
+                    size_t i = 0;
+                    for (; i < pathsInTask && !token.IsCancelled(); ++i) {
+                        random->FillNormal(&gaussVec);
+                        cMdl->GeneratePath(gaussVec, &path);
+                        prd.Payoffs(path, results[firstPath + i]);
+                    }
+                    pathsDone[iBatch] = i;
+                    return true;
+                },
+                token));
             pathsLeft -= pathsInTask;
             firstPath += pathsInTask;
         }
 
         for (auto& future : futures)
             pool->ActiveWaite(future);
+
+        if (token.IsCancelled()) {
+            // compact the completed rows of each batch to the front, preserving path order
+            size_t nDone = 0;
+            for (size_t iBatch = 0; iBatch < futures.size(); ++iBatch) {
+                const size_t first = iBatch * BATCH_SIZE;
+                for (size_t i = 0; i < pathsDone[iBatch]; ++i, ++nDone) {
+                    if (nDone != first + i)
+                        std::copy(results[first + i].begin(), results[first + i].end(), results[nDone].begin());
+                }
+            }
+            results.Resize(static_cast<int>(nDone), static_cast<int>(nPay));
+        }
         return results;
     }
 } // namespace Dal
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "dal/math/random/pseudorandom.hpp"
+#include <dal/concurrency/cancellation.hpp>
 #include <dal/math/aad/aad.hpp>
 #include <dal/math/matrix/matrixs.hpp>
 #include <dal/math/vectors.hpp>
@@ -20,6 +21,8 @@ namespace Dal {
 
     template <class T_> class Model_;
 
+    class ThreadPool_;
+
     /*
      * Template algorithms
      * check compatibility of model and products
@@ -31,19 +34,31 @@ namespace Dal {
         return prd.AssetNames() == mdl.AssetNames();
     }
 
+    /*
+     * returns one row of payoffs per path
+     * if the token is cancelled (or its deadline passes) the simulation stops early,
+     * and only the rows of the paths completed so far are returned
+     */
+
     Matrix_<> MCSimulation(const Product_<double>& prd,
                            const Model_<double>& mdl,
                            const std::unique_ptr<Random_>& rng,
-                           int nPath);
+                           int nPath,
+                           const CancellationToken_& token = CancellationToken_());
 
     /*
      * Parallel equivalent of MCSimulation
+     * runs on the given pool, or on ThreadPool_::GetInstance() if none is given
+     * on cancellation, queued batches are dropped, running batches stop after their current path,
+     * and the completed rows are returned (in path order, without gaps)
      */
 
     Matrix_<> MCParallelSimulation(const Product_<double>& prd,
                                    const Model_<double>& mdl,
                                    const std::unique_ptr<PseudoRandom_>& rng,
-                                   int nPath);
+                                   int nPath,
+                                   ThreadPool_* pool = nullptr,
+                                   const CancellationToken_& token = CancellationToken_());
 
     /*
      * MC simulation of AAD
@@ -47,6 +47,20 @@ namespace Dal {
             return node;
         }
 
+        // as above, with the number of arguments known only at run time
+        Node_* RecordNode(size_t n) {
+            Node_* node = nodes_.EmplaceBack(n);
+            if (multi_) {
+                node->p_adjoints_ = adjoints_multi_.EmplaceBackMulti(Node_::num_adj_);
+                std::fill(node->p_adjoints_, node->p_adjoints_ + Node_::num_adj_, 0.0);
+            }
+            if (n) {
+                node->p_derivatives_ = ders_.EmplaceBackMulti(n);
+                node->p_adj_ptrs_ = arg_ptrs_.EmplaceBackMulti(n);
+            }
+            return node;
+        }
+
         void ResetAdjoints() {
             if (multi_)
                 adjoints_multi_.Memset(0);
@@ -0,0 +1,201 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/analytics/black.hpp>
+#include <dal/platform/strict.hpp>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/simdmath.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+namespace Dal {
+    namespace {
+        // options per task when a pool is given
+        constexpr int BLACK_BLOCK = 2048;
+        constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+
+        // the book's arrays, and the outputs; the greeks are null when only prices are wanted
+        struct Lanes_ {
+            const double *omega_, *forward_, *strike_, *expiry_, *vol_, *discount_;
+            double *price_, *delta_, *gamma_, *vega_, *theta_;
+
+            Lanes_ Offset(int k) const {
+                Lanes_ ret_val = *this;
+                AdvanceLanes(k, ret_val.omega_, ret_val.forward_, ret_val.strike_, ret_val.expiry_, ret_val.vol_,
+                             ret_val.discount_, ret_val.price_, ret_val.delta_, ret_val.gamma_, ret_val.vega_,
+                             ret_val.theta_);
+                return ret_val;
+            }
+        };
+
+        void KernelScalar(const Lanes_& o, int n) {
+            for (int k = 0; k < n; ++k) {
+                const bool call = o.omega_[k] > 0.0;
+                const double f = o.forward_[k], strike = o.strike_[k], t = o.expiry_[k], df = o.discount_[k];
+                if (!o.delta_) {
+                    o.price_[k] = Black::Price(call, f, strike, t, o.vol_[k], df);
+                    continue;
+                }
+                const auto g = Black::Greeks(call, f, strike, t, o.vol_[k], df);
+                o.price_[k] = g.price_;
+                o.delta_[k] = g.delta_;
+                o.gamma_[k] = g.gamma_;
+                o.vega_[k] = g.vega_;
+                o.theta_[k] = g.theta_;
+            }
+        }
+
+#if DAL_SIMD_X86
+        DAL_TARGET_AVX2 void KernelAvx2(const Lanes_& o, int n) {
+            const __m256d zero = _mm256_setzero_pd();
+            for (int k = 0; k < n; k += 4) {
+                const __m256d omega = _mm256_loadu_pd(o.omega_ + k);
+                const __m256d f = _mm256_loadu_pd(o.forward_ + k);
+                const __m256d K = _mm256_loadu_pd(o.strike_ + k);
+                const __m256d vol = _mm256_loadu_pd(o.vol_ + k);
+                const __m256d df = _mm256_loadu_pd(o.discount_ + k);
+                const __m256d sqrtT = _mm256_sqrt_pd(_mm256_loadu_pd(o.expiry_ + k));
+                const __m256d stdDev = _mm256_mul_pd(vol, sqrtT);
+                const __m256d d1 = _mm256_fmadd_pd(_mm256_set1_pd(0.5), stdDev,
+                                                   _mm256_div_pd(Simd::LogAvx2(_mm256_div_pd(f, K)), stdDev));
+                const __m256d d2 = _mm256_sub_pd(d1, stdDev);
+                const __m256d nd1 = Simd::NcdfAvx2(_mm256_mul_pd(omega, d1));
+                const __m256d nd2 = Simd::NcdfAvx2(_mm256_mul_pd(omega, d2));
+                const __m256d dfOmega = _mm256_mul_pd(df, omega);
+                // lanes at expiry or without vol take the intrinsic value
+                const __m256d live = _mm256_cmp_pd(stdDev, zero, _CMP_GT_OQ);
+                const __m256d intrinsic = _mm256_mul_pd(omega, _mm256_sub_pd(f, K));
+                const __m256d inTheMoney = _mm256_cmp_pd(intrinsic, zero, _CMP_GT_OQ);
+                const __m256d price = _mm256_mul_pd(dfOmega, _mm256_fmsub_pd(f, nd1, _mm256_mul_pd(K, nd2)));
+                _mm256_storeu_pd(o.price_ + k,
+                                 _mm256_blendv_pd(_mm256_mul_pd(df, _mm256_max_pd(intrinsic, zero)), price, live));
+                if (!o.delta_)
+                    continue;
+
+                const __m256d phi = Simd::ExpAvx2(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(d1, d1)));
+                const __m256d dfF = _mm256_mul_pd(df, f);
+                const __m256d density = _mm256_mul_pd(dfF, _mm256_mul_pd(phi, _mm256_set1_pd(INV_SQRT_2PI)));
+                const __m256d delta = _mm256_mul_pd(dfOmega, nd1);
+                const __m256d gamma = _mm256_div_pd(density, _mm256_mul_pd(_mm256_mul_pd(f, f), stdDev));
+                const __m256d vega = _mm256_mul_pd(density, sqrtT);
+                const __m256d minusHalfVol = _mm256_mul_pd(_mm256_set1_pd(-0.5), vol);
+                const __m256d theta = _mm256_div_pd(_mm256_mul_pd(density, minusHalfVol), sqrtT);
+                _mm256_storeu_pd(o.delta_ + k, _mm256_blendv_pd(_mm256_and_pd(inTheMoney, dfOmega), delta, live));
+                _mm256_storeu_pd(o.gamma_ + k, _mm256_and_pd(live, gamma));
+                _mm256_storeu_pd(o.vega_ + k, _mm256_and_pd(live, vega));
+                _mm256_storeu_pd(o.theta_ + k, _mm256_and_pd(live, theta));
+            }
+        }
+
+        DAL_TARGET_AVX512 void KernelAvx512(const Lanes_& o, int n) {
+            const __m512d zero = _mm512_setzero_pd();
+            for (int k = 0; k < n; k += 8) {
+                const __m512d omega = _mm512_loadu_pd(o.omega_ + k);
+                const __m512d f = _mm512_loadu_pd(o.forward_ + k);
+                const __m512d K = _mm512_loadu_pd(o.strike_ + k);
+                const __m512d vol = _mm512_loadu_pd(o.vol_ + k);
+                const __m512d df = _mm512_loadu_pd(o.discount_ + k);
+                const __m512d sqrtT = _mm512_sqrt_pd(_mm512_loadu_pd(o.expiry_ + k));
+                const __m512d stdDev = _mm512_mul_pd(vol, sqrtT);
+                const __m512d d1 = _mm512_fmadd_pd(_mm512_set1_pd(0.5), stdDev,
+                                                   _mm512_div_pd(Simd::LogAvx512(_mm512_div_pd(f, K)), stdDev));
+                const __m512d d2 = _mm512_sub_pd(d1, stdDev);
+                const __m512d nd1 = Simd::NcdfAvx512(_mm512_mul_pd(omega, d1));
+                const __m512d nd2 = Simd::NcdfAvx512(_mm512_mul_pd(omega, d2));
+                const __m512d dfOmega = _mm512_mul_pd(df, omega);
+                const __mmask8 live = _mm512_cmp_pd_mask(stdDev, zero, _CMP_GT_OQ);
+                const __m512d intrinsic = _mm512_mul_pd(omega, _mm512_sub_pd(f, K));
+                const __mmask8 inTheMoney = _mm512_cmp_pd_mask(intrinsic, zero, _CMP_GT_OQ);
+                const __m512d price = _mm512_mul_pd(dfOmega, _mm512_fmsub_pd(f, nd1, _mm512_mul_pd(K, nd2)));
+                _mm512_storeu_pd(o.price_ + k,
+                                 _mm512_mask_blend_pd(live, _mm512_mul_pd(df, _mm512_max_pd(intrinsic, zero)), price));
+                if (!o.delta_)
+                    continue;
+
+                const __m512d phi = Simd::ExpAvx512(_mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_mul_pd(d1, d1)));
+                const __m512d dfF = _mm512_mul_pd(df, f);
+                const __m512d density = _mm512_mul_pd(dfF, _mm512_mul_pd(phi, _mm512_set1_pd(INV_SQRT_2PI)));
+                const __m512d delta = _mm512_mul_pd(dfOmega, nd1);
+                const __m512d gamma = _mm512_div_pd(density, _mm512_mul_pd(_mm512_mul_pd(f, f), stdDev));
+                const __m512d vega = _mm512_mul_pd(density, sqrtT);
+                const __m512d minusHalfVol = _mm512_mul_pd(_mm512_set1_pd(-0.5), vol);
+                const __m512d theta = _mm512_div_pd(_mm512_mul_pd(density, minusHalfVol), sqrtT);
+                const __m512d exercised = _mm512_maskz_mov_pd(inTheMoney, dfOmega);
+                _mm512_storeu_pd(o.delta_ + k, _mm512_mask_blend_pd(live, exercised, delta));
+                _mm512_storeu_pd(o.gamma_ + k, _mm512_maskz_mov_pd(live, gamma));
+                _mm512_storeu_pd(o.vega_ + k, _mm512_maskz_mov_pd(live, vega));
+                _mm512_storeu_pd(o.theta_ + k, _mm512_maskz_mov_pd(live, theta));
+            }
+        }
+#endif
+
+        // full vectors go through the widest kernel, the remaining options through the scalar one
+        void Kernel(const Lanes_& o, int n) {
+            int v = 0;
+#if DAL_SIMD_X86
+            v = DispatchHead(n, [&](int w) { KernelAvx512(o, w); }, [&](int w) { KernelAvx2(o, w); });
+#endif
+            if (v < n)
+                KernelScalar(o.Offset(v), n - v);
+        }
+
+        void Run(const Lanes_& o, int n, ThreadPool_* pool) {
+            ParallelBlocks(pool, n, BLACK_BLOCK, [&o](int begin, int end) { Kernel(o.Offset(begin), end - begin); });
+        }
+
+        Lanes_ Inputs(const Black::Book_& book) {
+            const int n = book.Size();
+            const auto size = static_cast<size_t>(n);
+            REQUIRE(book.omega_.size() == size && book.strike_.size() == size && book.expiry_.size() == size &&
+                        book.vol_.size() == size && book.discount_.size() == size,
+                    "Option book arrays should have equal sizes");
+            Lanes_ ret_val = {};
+            if (n > 0) {
+                ret_val.omega_ = &book.omega_[0];
+                ret_val.forward_ = &book.forward_[0];
+                ret_val.strike_ = &book.strike_[0];
+                ret_val.expiry_ = &book.expiry_[0];
+                ret_val.vol_ = &book.vol_[0];
+                ret_val.discount_ = &book.discount_[0];
+            }
+            return ret_val;
+        }
+    } // namespace
+
+    void Black::Book_::Add(bool call, double forward, double strike, double expiry, double vol, double discount) {
+        omega_.push_back(call ? 1.0 : -1.0);
+        forward_.push_back(forward);
+        strike_.push_back(strike);
+        expiry_.push_back(expiry);
+        vol_.push_back(vol);
+        discount_.push_back(discount);
+    }
+
+    void Black::Price(const Book_& book, Vector_<>* prices, ThreadPool_* pool) {
+        REQUIRE(prices, "Prices must not be null");
+        Lanes_ lanes = Inputs(book);
+        const int n = book.Size();
+        prices->Resize(n);
+        if (n == 0)
+            return;
+        lanes.price_ = &(*prices)[0];
+        Run(lanes, n, pool);
+    }
+
+    void Black::Greeks(const Book_& book, BookGreeks_* greeks, ThreadPool_* pool) {
+        REQUIRE(greeks, "Greeks must not be null");
+        Lanes_ lanes = Inputs(book);
+        const int n = book.Size();
+        for (auto* v : {&greeks->price_, &greeks->delta_, &greeks->gamma_, &greeks->vega_, &greeks->theta_})
+            v->Resize(n);
+        if (n == 0)
+            return;
+        lanes.price_ = &greeks->price_[0];
+        lanes.delta_ = &greeks->delta_[0];
+        lanes.gamma_ = &greeks->gamma_[0];
+        lanes.vega_ = &greeks->vega_[0];
+        lanes.theta_ = &greeks->theta_[0];
+        Run(lanes, n, pool);
+    }
+} // namespace Dal
@@ -0,0 +1,80 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/aad/operators.hpp>
+#include <dal/math/vectors.hpp>
+
+/*
+ * Black's formula for European options on a forward F, struck at K, expiring at T with vol sigma,
+ * discounted by DF: V = DF w (F N(w d1) - K N(w d2)), w = 1 for calls and -1 for puts
+ * greeks are by F (delta, gamma) and sigma (vega); theta is dV/dt = -dV/dT, at fixed F and DF
+ * the scalar functions are templated, so that Number_ arguments put the pricing on the tape;
+ * the batch functions run vectorised over a book of options, optionally spread over a pool
+ */
+
+namespace Dal {
+    class ThreadPool_;
+
+    namespace Black {
+        template <class T_> struct Greeks_ {
+            T_ price_, delta_, gamma_, vega_, theta_;
+        };
+
+        template <class T_>
+        Greeks_<T_> Greeks(
+            bool call, const T_& forward, const T_& strike, const T_& expiry, const T_& vol, const T_& discount) {
+            const double omega = call ? 1.0 : -1.0;
+            Greeks_<T_> ret_val;
+            const T_ sqrtT = Sqrt(expiry);
+            const T_ stdDev = vol * sqrtT;
+            if (!(stdDev > 0.0)) {
+                // at expiry, or without vol: the intrinsic value
+                const bool inTheMoney = omega * (forward - strike) > 0.0;
+                ret_val.price_ = inTheMoney ? discount * omega * (forward - strike) : T_(0.0);
+                ret_val.delta_ = inTheMoney ? discount * omega : T_(0.0);
+                ret_val.gamma_ = ret_val.vega_ = ret_val.theta_ = T_(0.0);
+                return ret_val;
+            }
+            const T_ d1 = Log(forward / strike) / stdDev + 0.5 * stdDev;
+            const T_ d2 = d1 - stdDev;
+            const T_ nd1 = NormalCdf(omega * d1);
+            const T_ density = discount * forward * NormalDens(d1);
+            ret_val.price_ = discount * omega * (forward * nd1 - strike * NormalCdf(omega * d2));
+            ret_val.delta_ = discount * omega * nd1;
+            ret_val.gamma_ = density / (forward * forward * stdDev);
+            ret_val.vega_ = density * sqrtT;
+            ret_val.theta_ = -0.5 * density * vol / sqrtT;
+            return ret_val;
+        }
+
+        template <class T_>
+        T_ Price(bool call, const T_& forward, const T_& strike, const T_& expiry, const T_& vol, const T_& discount) {
+            const double omega = call ? 1.0 : -1.0;
+            const T_ stdDev = vol * Sqrt(expiry);
+            if (!(stdDev > 0.0))
+                return omega * (forward - strike) > 0.0 ? discount * omega * (forward - strike) : T_(0.0);
+            const T_ d1 = Log(forward / strike) / stdDev + 0.5 * stdDev;
+            return discount * omega *
+                   (forward * NormalCdf(omega * d1) - strike * NormalCdf(omega * (d1 - stdDev)));
+        }
+
+        // one option per index, held as arrays so that consecutive options fill vector lanes
+        struct Book_ {
+            Vector_<> omega_; // 1 for a call, -1 for a put
+            Vector_<> forward_, strike_, expiry_, vol_, discount_;
+
+            int Size() const { return static_cast<int>(forward_.size()); }
+            void Add(bool call, double forward, double strike, double expiry, double vol, double discount);
+        };
+
+        struct BookGreeks_ {
+            Vector_<> price_, delta_, gamma_, vega_, theta_;
+        };
+
+        void Price(const Book_& book, Vector_<>* prices, ThreadPool_* pool = nullptr);
+        void Greeks(const Book_& book, BookGreeks_* greeks, ThreadPool_* pool = nullptr);
+    } // namespace Black
+} // namespace Dal
@@ -0,0 +1,477 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/analytics/impliedvol.hpp>
+#include <dal/platform/strict.hpp>
+#include <limits>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/rootfind.hpp>
+#include <dal/math/simdmath.hpp>
+#include <dal/math/specialfunctions.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+namespace Dal {
+    namespace {
+        // quotes per task when a pool is given
+        constexpr int IV_BLOCK = 2048;
+        constexpr int MAX_VECTOR_STEPS = 6;
+        constexpr int MAX_STEPS = 32;
+        constexpr int MAX_BRENT_STEPS = 200;
+        // the relative step at which the iteration has converged; the error is then far smaller
+        constexpr double STEP_TOL = 1e-10;
+        constexpr double MAX_STD_DEV = 1e3;
+        constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+        constexpr double HALF_LOG_2PI = 0.91893853320467274178;
+        constexpr double NOT_A_VOL = std::numeric_limits<double>::quiet_NaN();
+
+        // the normalised out-of-the-money problem: b(x, s) = beta, for x <= 0 and 0 < beta < exp(x/2)
+        struct Problem_ {
+            double x_, beta_, ex_; // ex_ = exp(x/2)
+
+            double B(double s) const { return ex_ * NCDF(x_ / s + 0.5 * s) - NCDF(x_ / s - 0.5 * s) / ex_; }
+        };
+
+        double NormalisedVega(double x, double s) {
+            const double xs = x / s;
+            return INV_SQRT_2PI * std::exp(-0.5 * xs * xs - 0.125 * s * s);
+        }
+
+        // reduces a quote to the out-of-the-money problem; false if the price is outside the no-arbitrage bounds
+        bool Normalise(
+            double omega, double forward, double strike, double expiry, double discount, double price, Problem_* p) {
+            const double x = std::log(forward / strike);
+            const double ex = std::exp(0.5 * x);
+            double beta = price / (discount * std::sqrt(forward * strike));
+            // in the money: take off the intrinsic value, leaving the out-of-the-money option by parity
+            if (omega * x > 0.0)
+                beta -= omega * (ex - 1.0 / ex);
+            p->x_ = -std::fabs(x);
+            p->ex_ = Min(ex, 1.0 / ex);
+            p->beta_ = beta;
+            return expiry > 0.0 && beta >= 0.0 && beta < p->ex_;
+        }
+
+        // the initial guess, and the bracket either side of the inflection point at sqrt(-2x) that holds the root
+        double Guess(const Problem_& p, double* lo, double* hi) {
+            const double sc = std::sqrt(-2.0 * p.x_);
+            const double bc = sc > 0.0 ? p.B(sc) : 0.0;
+            if (p.beta_ >= bc) {
+                *lo = sc;
+                *hi = INF;
+                // exact at the money, where b(0, s) = 1 - 2 N(-s/2)
+                return Max(sc, -2.0 * InverseNCDF((p.ex_ - p.beta_) / (p.ex_ + 1.0 / p.ex_), true, false));
+            }
+            *lo = 0.0;
+            *hi = sc;
+            // b ~ phi(x/s) s^3 / x^2 as s goes to 0, solved by fixed point; or the tangent to ln b at sc if higher
+            const double c = 2.0 * std::log(-p.x_) + HALF_LOG_2PI + std::log(p.beta_);
+            double s = sc;
+            for (int i = 0; i < 3; ++i) {
+                const double arg = 2.0 * (3.0 * std::log(s) - c);
+                if (arg > 0.0)
+                    s = Min(sc, -p.x_ / std::sqrt(arg));
+            }
+            return Max(s, sc + std::log(p.beta_ / bc) * bc / NormalisedVega(p.x_, sc));
+        }
+
+        // one Householder step on ln b below the inflection point, and on b above it
+        // steps that leave the bracket are replaced by bisection, unless they are within tolerance
+        double Step(const Problem_& p, bool upper, double s, double* lo, double* hi) {
+            const double b = p.B(s);
+            const double vega = NormalisedVega(p.x_, s);
+            if (b < p.beta_)
+                *lo = Max(*lo, s);
+            else
+                *hi = Min(*hi, s);
+            // b''/b' and b'''/b'
+            const double xs2 = Square(p.x_ / s);
+            const double h2 = xs2 / s - 0.25 * s;
+            const double h3 = h2 * h2 - 3.0 * xs2 / (s * s) - 0.25;
+            double nu = (p.beta_ - b) / vega, g2 = h2, g3 = h3;
+            if (!upper) {
+                const double r = vega / b;
+                nu = std::log(p.beta_ / b) / r;
+                g2 = h2 - r;
+                g3 = h3 - 3.0 * r * h2 + 2.0 * r * r;
+            }
+            const double next = s + nu * (1.0 + 0.5 * g2 * nu) / (1.0 + nu * (g2 + g3 * nu / 6.0));
+            if (std::fabs(next - s) <= STEP_TOL * s || (next > *lo && next < *hi))
+                return next;
+            return *hi < INF ? 0.5 * (*lo + *hi) : 2.0 * s;
+        }
+
+        double Bracketed(const Problem_& p, double lo, double hi) {
+            if (hi >= INF) {
+                for (hi = Max(2.0 * lo, 1.0); p.B(hi) < p.beta_; hi *= 2.0)
+                    if (hi > MAX_STD_DEV)
+                        return NOT_A_VOL;
+            }
+            BracketedBrent_ finder(std::make_pair(lo, p.B(lo) - p.beta_), std::make_pair(hi, p.B(hi) - p.beta_),
+                                   Dal::EPSILON);
+            const Converged_ done(STEP_TOL * hi, 0.0);
+            for (int i = 0; i < MAX_BRENT_STEPS; ++i) {
+                const double s = finder.NextX();
+                if (done(finder, p.B(s) - p.beta_))
+                    return s;
+            }
+            return NOT_A_VOL;
+        }
+
+        double Solve(const Problem_& p) {
+            double lo, hi;
+            double s = Guess(p, &lo, &hi);
+            const bool upper = hi >= INF;
+            for (int i = 0; i < MAX_STEPS; ++i) {
+                const double next = Step(p, upper, s, &lo, &hi);
+                if (std::fabs(next - s) <= STEP_TOL * s)
+                    return next;
+                s = next;
+            }
+            return Bracketed(p, lo, hi);
+        }
+
+        // the quotes' arrays, and the output
+        struct Lanes_ {
+            const double *omega_, *forward_, *strike_, *expiry_, *discount_, *price_;
+            double* vol_;
+
+            Lanes_ Offset(int k) const {
+                Lanes_ ret_val = *this;
+                AdvanceLanes(k, ret_val.omega_, ret_val.forward_, ret_val.strike_, ret_val.expiry_, ret_val.discount_,
+                             ret_val.price_, ret_val.vol_);
+                return ret_val;
+            }
+        };
+
+        void KernelScalar(const Lanes_& o, int n) {
+            for (int k = 0; k < n; ++k)
+                o.vol_[k] = Black::ImpliedVol(o.omega_[k] > 0.0, o.forward_[k], o.strike_[k], o.expiry_[k],
+                                              o.discount_[k], o.price_[k]);
+        }
+
+#if DAL_SIMD_X86
+        // Beasley-Springer-Moro without polishing, as InverseNCDF(p, true, false)
+        constexpr double BSM_A[4] = {2.50662823884, -18.61500062529, 41.39119773534, -25.44106049637};
+        constexpr double BSM_B[4] = {-8.47351093090, 23.08336743743, -21.06224101826, 3.13082909833};
+        constexpr double BSM_C[9] = {0.3374754822726147, 0.9761690190917186, 0.1607979714918209,
+                                     0.0276438810333863, 0.0038405729373609, 0.0003951896511919,
+                                     0.0000321767881768, 0.0000002888167364, 0.0000003960315187};
+        constexpr double BSM_CENTRAL = 0.42;
+
+        DAL_TARGET_AVX2 inline __m256d InverseNcdfAvx2(__m256d p) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d t = _mm256_sub_pd(p, _mm256_set1_pd(0.5));
+            const __m256d r = _mm256_mul_pd(t, t);
+            __m256d num = _mm256_set1_pd(BSM_A[3]), den = _mm256_set1_pd(BSM_B[3]);
+            for (int i = 2; i >= 0; --i) {
+                num = _mm256_fmadd_pd(num, r, _mm256_set1_pd(BSM_A[i]));
+                den = _mm256_fmadd_pd(den, r, _mm256_set1_pd(BSM_B[i]));
+            }
+            const __m256d central = _mm256_div_pd(_mm256_mul_pd(t, num), _mm256_fmadd_pd(den, r, one));
+
+            const __m256d q = _mm256_min_pd(p, _mm256_sub_pd(one, p));
+            const __m256d u = Simd::LogAvx2(_mm256_sub_pd(_mm256_setzero_pd(), Simd::LogAvx2(q)));
+            __m256d tail = _mm256_set1_pd(BSM_C[8]);
+            for (int i = 7; i >= 0; --i)
+                tail = _mm256_fmadd_pd(tail, u, _mm256_set1_pd(BSM_C[i]));
+            tail = _mm256_xor_pd(tail, _mm256_and_pd(t, _mm256_set1_pd(-0.0)));
+            const __m256d absT = _mm256_andnot_pd(_mm256_set1_pd(-0.0), t);
+            return _mm256_blendv_pd(tail, central, _mm256_cmp_pd(absT, _mm256_set1_pd(BSM_CENTRAL), _CMP_LT_OQ));
+        }
+
+        // b(x, s) = e N(x/s + s/2) - N(x/s - s/2) / e, with e = exp(x/2)
+        DAL_TARGET_AVX2 inline __m256d NormalisedAvx2(__m256d x, __m256d s, __m256d ex, __m256d emx) {
+            const __m256d xs = _mm256_div_pd(x, s);
+            const __m256d hs = _mm256_mul_pd(_mm256_set1_pd(0.5), s);
+            const __m256d right = _mm256_mul_pd(emx, Simd::NcdfAvx2(_mm256_sub_pd(xs, hs)));
+            return _mm256_fmsub_pd(ex, Simd::NcdfAvx2(_mm256_add_pd(xs, hs)), right);
+        }
+
+        DAL_TARGET_AVX2 inline __m256d VegaAvx2(__m256d x, __m256d s) {
+            const __m256d xs = _mm256_div_pd(x, s);
+            const __m256d arg = _mm256_fmadd_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(xs, xs),
+                                                _mm256_mul_pd(_mm256_set1_pd(-0.125), _mm256_mul_pd(s, s)));
+            return _mm256_mul_pd(_mm256_set1_pd(INV_SQRT_2PI), Simd::ExpAvx2(arg));
+        }
+
+        // lanes that have not converged, or that the vector solver does not handle, are left as NaN
+        DAL_TARGET_AVX2 void KernelAvx2(const Lanes_& o, int n) {
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d half = _mm256_set1_pd(0.5);
+            const __m256d two = _mm256_set1_pd(2.0);
+            const __m256d three = _mm256_set1_pd(3.0);
+            const __m256d inf = _mm256_set1_pd(INF);
+            const __m256d signBit = _mm256_set1_pd(-0.0);
+            for (int k = 0; k < n; k += 4) {
+                const __m256d omega = _mm256_loadu_pd(o.omega_ + k);
+                const __m256d f = _mm256_loadu_pd(o.forward_ + k);
+                const __m256d K = _mm256_loadu_pd(o.strike_ + k);
+                const __m256d t = _mm256_loadu_pd(o.expiry_ + k);
+                const __m256d df = _mm256_loadu_pd(o.discount_ + k);
+                const __m256d x0 = Simd::LogAvx2(_mm256_div_pd(f, K));
+                const __m256d e0 = Simd::ExpAvx2(_mm256_mul_pd(half, x0));
+                const __m256d e0Inv = _mm256_div_pd(one, e0);
+                const __m256d scale = _mm256_mul_pd(df, _mm256_sqrt_pd(_mm256_mul_pd(f, K)));
+                __m256d beta = _mm256_div_pd(_mm256_loadu_pd(o.price_ + k), scale);
+                const __m256d itm = _mm256_cmp_pd(_mm256_mul_pd(omega, x0), zero, _CMP_GT_OQ);
+                beta = _mm256_sub_pd(beta, _mm256_and_pd(itm, _mm256_mul_pd(omega, _mm256_sub_pd(e0, e0Inv))));
+                const __m256d x = _mm256_or_pd(x0, signBit);
+                const __m256d ex = _mm256_min_pd(e0, e0Inv);
+                const __m256d emx = _mm256_max_pd(e0, e0Inv);
+                const __m256d inBounds =
+                    _mm256_and_pd(_mm256_cmp_pd(beta, zero, _CMP_GT_OQ), _mm256_cmp_pd(beta, ex, _CMP_LT_OQ));
+                const __m256d valid = _mm256_and_pd(_mm256_cmp_pd(t, zero, _CMP_GT_OQ), inBounds);
+                if (!_mm256_movemask_pd(valid)) {
+                    _mm256_storeu_pd(o.vol_ + k, _mm256_set1_pd(NOT_A_VOL));
+                    continue;
+                }
+
+                const __m256d sc = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), x));
+                const __m256d bc = _mm256_and_pd(_mm256_cmp_pd(sc, zero, _CMP_GT_OQ), NormalisedAvx2(x, sc, ex, emx));
+                const __m256d upper = _mm256_cmp_pd(beta, bc, _CMP_GE_OQ);
+                const __m256d pUpper = _mm256_div_pd(_mm256_sub_pd(ex, beta), _mm256_add_pd(ex, emx));
+                const __m256d guessUpper =
+                    _mm256_max_pd(sc, _mm256_mul_pd(_mm256_set1_pd(-2.0), InverseNcdfAvx2(pUpper)));
+                const __m256d c = _mm256_add_pd(_mm256_fmadd_pd(two, Simd::LogAvx2(_mm256_sub_pd(zero, x)),
+                                                                _mm256_set1_pd(HALF_LOG_2PI)),
+                                                Simd::LogAvx2(beta));
+                __m256d guessLower = sc;
+                for (int i = 0; i < 3; ++i) {
+                    const __m256d arg = _mm256_mul_pd(two, _mm256_fmsub_pd(three, Simd::LogAvx2(guessLower), c));
+                    const __m256d next = _mm256_min_pd(sc, _mm256_div_pd(_mm256_sub_pd(zero, x), _mm256_sqrt_pd(arg)));
+                    guessLower = _mm256_blendv_pd(guessLower, next, _mm256_cmp_pd(arg, zero, _CMP_GT_OQ));
+                }
+                const __m256d tangent = _mm256_fmadd_pd(Simd::LogAvx2(_mm256_div_pd(beta, bc)),
+                                                        _mm256_div_pd(bc, VegaAvx2(x, sc)), sc);
+                guessLower = _mm256_max_pd(guessLower, tangent);
+
+                __m256d s = _mm256_blendv_pd(guessLower, guessUpper, upper);
+                __m256d lo = _mm256_and_pd(upper, sc);
+                __m256d hi = _mm256_blendv_pd(sc, inf, upper);
+                __m256d active = valid, done = zero;
+                for (int i = 0; i < MAX_VECTOR_STEPS && _mm256_movemask_pd(active); ++i) {
+                    const __m256d b = NormalisedAvx2(x, s, ex, emx);
+                    const __m256d vega = VegaAvx2(x, s);
+                    const __m256d below = _mm256_cmp_pd(b, beta, _CMP_LT_OQ);
+                    lo = _mm256_blendv_pd(lo, _mm256_max_pd(lo, s), below);
+                    hi = _mm256_blendv_pd(_mm256_min_pd(hi, s), hi, below);
+                    const __m256d xs = _mm256_div_pd(x, s);
+                    const __m256d xs2 = _mm256_mul_pd(xs, xs);
+                    const __m256d h2 = _mm256_sub_pd(_mm256_div_pd(xs2, s), _mm256_mul_pd(_mm256_set1_pd(0.25), s));
+                    const __m256d h3 = _mm256_sub_pd(
+                        _mm256_fmsub_pd(h2, h2, _mm256_div_pd(_mm256_mul_pd(three, xs2), _mm256_mul_pd(s, s))),
+                        _mm256_set1_pd(0.25));
+                    const __m256d r = _mm256_div_pd(vega, b);
+                    const __m256d nu = _mm256_blendv_pd(_mm256_div_pd(Simd::LogAvx2(_mm256_div_pd(beta, b)), r),
+                                                        _mm256_div_pd(_mm256_sub_pd(beta, b), vega), upper);
+                    const __m256d g2 = _mm256_blendv_pd(_mm256_sub_pd(h2, r), h2, upper);
+                    const __m256d g3 = _mm256_blendv_pd(
+                        _mm256_fmadd_pd(_mm256_mul_pd(two, r), r, _mm256_fnmadd_pd(_mm256_mul_pd(three, r), h2, h3)),
+                        h3, upper);
+                    const __m256d num = _mm256_fmadd_pd(_mm256_mul_pd(half, g2), nu, one);
+                    const __m256d den =
+                        _mm256_fmadd_pd(nu, _mm256_fmadd_pd(g3, _mm256_div_pd(nu, _mm256_set1_pd(6.0)), g2), one);
+                    __m256d next = _mm256_fmadd_pd(nu, _mm256_div_pd(num, den), s);
+                    const __m256d small = _mm256_cmp_pd(_mm256_andnot_pd(signBit, _mm256_sub_pd(next, s)),
+                                                        _mm256_mul_pd(_mm256_set1_pd(STEP_TOL), s), _CMP_LE_OQ);
+                    const __m256d inside =
+                        _mm256_and_pd(_mm256_cmp_pd(next, lo, _CMP_GT_OQ), _mm256_cmp_pd(next, hi, _CMP_LT_OQ));
+                    const __m256d bisect =
+                        _mm256_blendv_pd(_mm256_add_pd(s, s), _mm256_mul_pd(half, _mm256_add_pd(lo, hi)),
+                                         _mm256_cmp_pd(hi, inf, _CMP_LT_OQ));
+                    next = _mm256_blendv_pd(bisect, next, _mm256_or_pd(small, inside));
+                    s = _mm256_blendv_pd(s, next, active);
+                    done = _mm256_or_pd(done, _mm256_and_pd(active, small));
+                    active = _mm256_andnot_pd(small, active);
+                }
+                const __m256d vol = _mm256_div_pd(s, _mm256_sqrt_pd(t));
+                _mm256_storeu_pd(o.vol_ + k, _mm256_blendv_pd(_mm256_set1_pd(NOT_A_VOL), vol, done));
+            }
+        }
+
+        DAL_TARGET_AVX512 inline __m512d InverseNcdfAvx512(__m512d p) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d t = _mm512_sub_pd(p, _mm512_set1_pd(0.5));
+            const __m512d r = _mm512_mul_pd(t, t);
+            __m512d num = _mm512_set1_pd(BSM_A[3]), den = _mm512_set1_pd(BSM_B[3]);
+            for (int i = 2; i >= 0; --i) {
+                num = _mm512_fmadd_pd(num, r, _mm512_set1_pd(BSM_A[i]));
+                den = _mm512_fmadd_pd(den, r, _mm512_set1_pd(BSM_B[i]));
+            }
+            const __m512d central = _mm512_div_pd(_mm512_mul_pd(t, num), _mm512_fmadd_pd(den, r, one));
+
+            const __m512d q = _mm512_min_pd(p, _mm512_sub_pd(one, p));
+            const __m512d u = Simd::LogAvx512(_mm512_sub_pd(_mm512_setzero_pd(), Simd::LogAvx512(q)));
+            __m512d tail = _mm512_set1_pd(BSM_C[8]);
+            for (int i = 7; i >= 0; --i)
+                tail = _mm512_fmadd_pd(tail, u, _mm512_set1_pd(BSM_C[i]));
+            tail = _mm512_mask_sub_pd(tail, _mm512_cmp_pd_mask(t, _mm512_setzero_pd(), _CMP_LT_OQ),
+                                      _mm512_setzero_pd(), tail);
+            const __mmask8 isCentral = _mm512_cmp_pd_mask(_mm512_abs_pd(t), _mm512_set1_pd(BSM_CENTRAL), _CMP_LT_OQ);
+            return _mm512_mask_blend_pd(isCentral, tail, central);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d NormalisedAvx512(__m512d x, __m512d s, __m512d ex, __m512d emx) {
+            const __m512d xs = _mm512_div_pd(x, s);
+            const __m512d hs = _mm512_mul_pd(_mm512_set1_pd(0.5), s);
+            const __m512d right = _mm512_mul_pd(emx, Simd::NcdfAvx512(_mm512_sub_pd(xs, hs)));
+            return _mm512_fmsub_pd(ex, Simd::NcdfAvx512(_mm512_add_pd(xs, hs)), right);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d VegaAvx512(__m512d x, __m512d s) {
+            const __m512d xs = _mm512_div_pd(x, s);
+            const __m512d arg = _mm512_fmadd_pd(_mm512_set1_pd(-0.5), _mm512_mul_pd(xs, xs),
+                                                _mm512_mul_pd(_mm512_set1_pd(-0.125), _mm512_mul_pd(s, s)));
+            return _mm512_mul_pd(_mm512_set1_pd(INV_SQRT_2PI), Simd::ExpAvx512(arg));
+        }
+
+        DAL_TARGET_AVX512 void KernelAvx512(const Lanes_& o, int n) {
+            const __m512d zero = _mm512_setzero_pd();
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d half = _mm512_set1_pd(0.5);
+            const __m512d two = _mm512_set1_pd(2.0);
+            const __m512d three = _mm512_set1_pd(3.0);
+            const __m512d inf = _mm512_set1_pd(INF);
+            for (int k = 0; k < n; k += 8) {
+                const __m512d omega = _mm512_loadu_pd(o.omega_ + k);
+                const __m512d f = _mm512_loadu_pd(o.forward_ + k);
+                const __m512d K = _mm512_loadu_pd(o.strike_ + k);
+                const __m512d t = _mm512_loadu_pd(o.expiry_ + k);
+                const __m512d df = _mm512_loadu_pd(o.discount_ + k);
+                const __m512d x0 = Simd::LogAvx512(_mm512_div_pd(f, K));
+                const __m512d e0 = Simd::ExpAvx512(_mm512_mul_pd(half, x0));
+                const __m512d e0Inv = _mm512_div_pd(one, e0);
+                const __m512d scale = _mm512_mul_pd(df, _mm512_sqrt_pd(_mm512_mul_pd(f, K)));
+                __m512d beta = _mm512_div_pd(_mm512_loadu_pd(o.price_ + k), scale);
+                const __mmask8 itm = _mm512_cmp_pd_mask(_mm512_mul_pd(omega, x0), zero, _CMP_GT_OQ);
+                beta = _mm512_mask_sub_pd(beta, itm, beta, _mm512_mul_pd(omega, _mm512_sub_pd(e0, e0Inv)));
+                const __m512d x = _mm512_sub_pd(zero, _mm512_abs_pd(x0));
+                const __m512d ex = _mm512_min_pd(e0, e0Inv);
+                const __m512d emx = _mm512_max_pd(e0, e0Inv);
+                const __mmask8 valid = _mm512_cmp_pd_mask(t, zero, _CMP_GT_OQ) &
+                                       _mm512_cmp_pd_mask(beta, zero, _CMP_GT_OQ) &
+                                       _mm512_cmp_pd_mask(beta, ex, _CMP_LT_OQ);
+                if (!valid) {
+                    _mm512_storeu_pd(o.vol_ + k, _mm512_set1_pd(NOT_A_VOL));
+                    continue;
+                }
+
+                const __m512d sc = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0), x));
+                const __m512d bc =
+                    _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(sc, zero, _CMP_GT_OQ), NormalisedAvx512(x, sc, ex, emx));
+                const __mmask8 upper = _mm512_cmp_pd_mask(beta, bc, _CMP_GE_OQ);
+                const __m512d pUpper = _mm512_div_pd(_mm512_sub_pd(ex, beta), _mm512_add_pd(ex, emx));
+                const __m512d guessUpper =
+                    _mm512_max_pd(sc, _mm512_mul_pd(_mm512_set1_pd(-2.0), InverseNcdfAvx512(pUpper)));
+                const __m512d c = _mm512_add_pd(_mm512_fmadd_pd(two, Simd::LogAvx512(_mm512_sub_pd(zero, x)),
+                                                                _mm512_set1_pd(HALF_LOG_2PI)),
+                                                Simd::LogAvx512(beta));
+                __m512d guessLower = sc;
+                for (int i = 0; i < 3; ++i) {
+                    const __m512d arg = _mm512_mul_pd(two, _mm512_fmsub_pd(three, Simd::LogAvx512(guessLower), c));
+                    const __m512d next = _mm512_min_pd(sc, _mm512_div_pd(_mm512_sub_pd(zero, x), _mm512_sqrt_pd(arg)));
+                    guessLower = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(arg, zero, _CMP_GT_OQ), guessLower, next);
+                }
+                const __m512d tangent = _mm512_fmadd_pd(Simd::LogAvx512(_mm512_div_pd(beta, bc)),
+                                                        _mm512_div_pd(bc, VegaAvx512(x, sc)), sc);
+                guessLower = _mm512_max_pd(guessLower, tangent);
+
+                __m512d s = _mm512_mask_blend_pd(upper, guessLower, guessUpper);
+                __m512d lo = _mm512_maskz_mov_pd(upper, sc);
+                __m512d hi = _mm512_mask_blend_pd(upper, sc, inf);
+                __mmask8 active = valid, done = 0;
+                for (int i = 0; i < MAX_VECTOR_STEPS && active; ++i) {
+                    const __m512d b = NormalisedAvx512(x, s, ex, emx);
+                    const __m512d vega = VegaAvx512(x, s);
+                    const __mmask8 below = _mm512_cmp_pd_mask(b, beta, _CMP_LT_OQ);
+                    lo = _mm512_mask_max_pd(lo, below, lo, s);
+                    hi = _mm512_mask_min_pd(hi, static_cast<__mmask8>(~below), hi, s);
+                    const __m512d xs = _mm512_div_pd(x, s);
+                    const __m512d xs2 = _mm512_mul_pd(xs, xs);
+                    const __m512d h2 = _mm512_sub_pd(_mm512_div_pd(xs2, s), _mm512_mul_pd(_mm512_set1_pd(0.25), s));
+                    const __m512d h3 = _mm512_sub_pd(
+                        _mm512_fmsub_pd(h2, h2, _mm512_div_pd(_mm512_mul_pd(three, xs2), _mm512_mul_pd(s, s))),
+                        _mm512_set1_pd(0.25));
+                    const __m512d r = _mm512_div_pd(vega, b);
+                    const __m512d nu =
+                        _mm512_mask_blend_pd(upper, _mm512_div_pd(Simd::LogAvx512(_mm512_div_pd(beta, b)), r),
+                                             _mm512_div_pd(_mm512_sub_pd(beta, b), vega));
+                    const __m512d g2 = _mm512_mask_blend_pd(upper, _mm512_sub_pd(h2, r), h2);
+                    const __m512d g3 = _mm512_mask_blend_pd(
+                        upper,
+                        _mm512_fmadd_pd(_mm512_mul_pd(two, r), r, _mm512_fnmadd_pd(_mm512_mul_pd(three, r), h2, h3)),
+                        h3);
+                    const __m512d num = _mm512_fmadd_pd(_mm512_mul_pd(half, g2), nu, one);
+                    const __m512d den =
+                        _mm512_fmadd_pd(nu, _mm512_fmadd_pd(g3, _mm512_div_pd(nu, _mm512_set1_pd(6.0)), g2), one);
+                    __m512d next = _mm512_fmadd_pd(nu, _mm512_div_pd(num, den), s);
+                    const __mmask8 small = _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(next, s)),
+                                                              _mm512_mul_pd(_mm512_set1_pd(STEP_TOL), s), _CMP_LE_OQ);
+                    const __mmask8 inside =
+                        _mm512_cmp_pd_mask(next, lo, _CMP_GT_OQ) & _mm512_cmp_pd_mask(next, hi, _CMP_LT_OQ);
+                    const __m512d bisect =
+                        _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hi, inf, _CMP_LT_OQ), _mm512_add_pd(s, s),
+                                             _mm512_mul_pd(half, _mm512_add_pd(lo, hi)));
+                    next = _mm512_mask_blend_pd(small | inside, bisect, next);
+                    s = _mm512_mask_mov_pd(s, active, next);
+                    done |= active & small;
+                    active &= ~small;
+                }
+                const __m512d vol = _mm512_div_pd(s, _mm512_sqrt_pd(t));
+                _mm512_storeu_pd(o.vol_ + k, _mm512_mask_blend_pd(done, _mm512_set1_pd(NOT_A_VOL), vol));
+            }
+        }
+#endif
+
+        // full vectors go through the widest kernel, and whatever it leaves through the scalar solver
+        void Kernel(const Lanes_& o, int n) {
+            int v = 0;
+#if DAL_SIMD_X86
+            v = DispatchHead(n, [&](int w) { KernelAvx512(o, w); }, [&](int w) { KernelAvx2(o, w); });
+#endif
+            for (int k = 0; k < v; ++k)
+                if (std::isnan(o.vol_[k]))
+                    KernelScalar(o.Offset(k), 1);
+            if (v < n)
+                KernelScalar(o.Offset(v), n - v);
+        }
+
+        void Run(const Lanes_& o, int n, ThreadPool_* pool) {
+            ParallelBlocks(pool, n, IV_BLOCK, [&o](int begin, int end) { Kernel(o.Offset(begin), end - begin); });
+        }
+    } // namespace
+
+    double Black::ImpliedVol(bool call, double forward, double strike, double expiry, double discount, double price) {
+        Problem_ p;
+        if (!Normalise(call ? 1.0 : -1.0, forward, strike, expiry, discount, price, &p))
+            return NOT_A_VOL;
+        return p.beta_ > 0.0 ? Solve(p) / std::sqrt(expiry) : 0.0;
+    }
+
+    void Black::Quotes_::Add(bool call, double forward, double strike, double expiry, double discount, double price) {
+        omega_.push_back(call ? 1.0 : -1.0);
+        forward_.push_back(forward);
+        strike_.push_back(strike);
+        expiry_.push_back(expiry);
+        discount_.push_back(discount);
+        price_.push_back(price);
+    }
+
+    void Black::ImpliedVol(const Quotes_& quotes, Vector_<>* vols, ThreadPool_* pool) {
+        REQUIRE(vols, "Vols must not be null");
+        const int n = quotes.Size();
+        const auto size = static_cast<size_t>(n);
+        REQUIRE(quotes.omega_.size() == size && quotes.forward_.size() == size && quotes.strike_.size() == size &&
+                    quotes.expiry_.size() == size && quotes.discount_.size() == size,
+                "Quote arrays should have equal sizes");
+        vols->Resize(n);
+        if (n == 0)
+            return;
+        const Lanes_ lanes = {&quotes.omega_[0],    &quotes.forward_[0],  &quotes.strike_[0], &quotes.expiry_[0],
+                              &quotes.discount_[0], &quotes.price_[0], &(*vols)[0]};
+        Run(lanes, n, pool);
+    }
+} // namespace Dal
@@ -0,0 +1,36 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/vectors.hpp>
+
+/*
+ * implied Black vols: the sigma at which Black's formula (see black.hpp) reproduces a quoted price
+ * the solver works on the normalised out-of-the-money price b(x, s), with x = ln(F/K) and s = sigma sqrt(T),
+ * after Jaeckel, "Let's be rational" (2015): an initial guess from the asymptotics of the branch either side of
+ * the inflection point, then third-order Householder steps, safeguarded by a bracket; two or three steps usually do
+ * the batch version takes the steps vectorised across quotes, and hands lanes that have not converged to the scalar
+ * solver, which in turn falls back on Brent within the bracket
+ * prices outside the no-arbitrage bounds, or with no time to expiry, give NaN; the intrinsic value gives 0
+ */
+
+namespace Dal {
+    class ThreadPool_;
+
+    namespace Black {
+        double ImpliedVol(bool call, double forward, double strike, double expiry, double discount, double price);
+
+        // one quote per index, held as arrays so that consecutive quotes fill vector lanes
+        struct Quotes_ {
+            Vector_<> omega_; // 1 for a call, -1 for a put
+            Vector_<> forward_, strike_, expiry_, discount_, price_;
+
+            int Size() const { return static_cast<int>(price_.size()); }
+            void Add(bool call, double forward, double strike, double expiry, double discount, double price);
+        };
+
+        void ImpliedVol(const Quotes_& quotes, Vector_<>* vols, ThreadPool_* pool = nullptr);
+    } // namespace Black
+} // namespace Dal
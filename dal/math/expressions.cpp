@@ -0,0 +1,13 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/math/expressions.hpp>
+#include <dal/utilities/exceptions.hpp>
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    void Expr::RequireConform(bool conform) {
+        REQUIRE(conform, "Operands of an element-wise expression should have the same shape");
+    }
+} // namespace Dal
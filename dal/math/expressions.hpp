@@ -0,0 +1,213 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Lazy element-wise arithmetic on Vector_, matrix slices, Matrix_ and SquareMatrix_
+ * an expression such as b * c + d * s only records its operands; the loop runs once, when it is assigned
+ * named arrays are held by reference, so an expression must not outlive them; temporaries (e.g. m.Row(0)) are moved in
+ * elements are combined with the element type's own operators, so Number_ operands build one AAD expression per element
+ */
+
+namespace Dal {
+    namespace Expr {
+        // tag base of the expression nodes
+        struct Base_ {};
+
+        // containers which take part in expressions; specialised next to each container
+        template <class T_> struct IsArray_ : std::false_type {};
+
+        template <class T_> using Plain_ = std::remove_cv_t<std::remove_reference_t<T_>>;
+        template <class T_> constexpr bool IS_EXPRESSION = std::is_base_of_v<Base_, Plain_<T_>>;
+        template <class T_> constexpr bool IS_OPERAND = IsArray_<Plain_<T_>>::value || IS_EXPRESSION<T_>;
+
+        // T_ as deduced by a forwarding reference: arrays bound to an lvalue are held by reference,
+        // anything else by value -- temporary arrays, expressions, and scalars (broadcast to every element)
+        template <class T_>
+        using Held_ = std::conditional_t<std::is_lvalue_reference_v<T_> && IsArray_<Plain_<T_>>::value,
+                                         const Plain_<T_>&,
+                                         const Plain_<T_>>;
+
+        // matrices (and their expressions) conform by rows and columns, other arrays by size
+        template <class T_, class = void> struct HasRows_ : std::false_type {};
+        template <class T_>
+        struct HasRows_<T_, std::void_t<decltype(std::declval<const T_&>().Rows())>> : std::true_type {};
+        template <class T_> constexpr bool IsMatrix() {
+            if constexpr (IS_EXPRESSION<T_>)
+                return Plain_<T_>::MATRIX;
+            else
+                return HasRows_<Plain_<T_>>::value;
+        }
+
+        template <class L_, class R_> bool Conform(const L_& l, const R_& r) {
+            if constexpr (!IS_OPERAND<L_> || !IS_OPERAND<R_>)
+                return true;
+            else if constexpr (IsMatrix<L_>() && IsMatrix<R_>())
+                return l.Rows() == r.Rows() && l.Cols() == r.Cols();
+            else
+                return static_cast<size_t>(l.size()) == static_cast<size_t>(r.size());
+        }
+
+        // throws unless conform; out of line, since exceptions.hpp depends on this header through vectors.hpp
+        void RequireConform(bool conform);
+
+        template <class T_> decltype(auto) At(const T_& x, size_t i) {
+            if constexpr (IS_OPERAND<T_>)
+                return x[i];
+            else
+                return (x);
+        }
+
+        template <class T_> decltype(auto) At(const T_& x, int row, int col) {
+            if constexpr (IS_OPERAND<T_>)
+                return x(row, col);
+            else
+                return (x);
+        }
+
+        struct Plus_ {
+            template <class L_, class R_> static auto Apply(const L_& l, const R_& r) { return l + r; }
+        };
+        struct Minus_ {
+            template <class L_, class R_> static auto Apply(const L_& l, const R_& r) { return l - r; }
+        };
+        struct Multiplies_ {
+            template <class L_, class R_> static auto Apply(const L_& l, const R_& r) { return l * r; }
+        };
+        struct Divides_ {
+            template <class L_, class R_> static auto Apply(const L_& l, const R_& r) { return l / r; }
+        };
+
+        template <class L_, class R_, class OP_> class Binary_ : public Base_ {
+            Held_<L_> l_;
+            Held_<R_> r_;
+
+        public:
+            static constexpr bool MATRIX = IsMatrix<L_>() || IsMatrix<R_>();
+
+            template <class LL_, class RR_>
+            Binary_(LL_&& l, RR_&& r) : l_(std::forward<LL_>(l)), r_(std::forward<RR_>(r)) {
+                RequireConform(Conform(l_, r_));
+            }
+
+            // shapes come from the first array operand; the others conform, as checked on construction
+            size_t size() const {
+                if constexpr (IS_OPERAND<L_>)
+                    return l_.size();
+                else
+                    return r_.size();
+            }
+            int Rows() const {
+                if constexpr (IS_OPERAND<L_>)
+                    return l_.Rows();
+                else
+                    return r_.Rows();
+            }
+            int Cols() const {
+                if constexpr (IS_OPERAND<L_>)
+                    return l_.Cols();
+                else
+                    return r_.Cols();
+            }
+
+            auto operator[](size_t i) const { return OP_::Apply(At(l_, i), At(r_, i)); }
+            auto operator()(int row, int col) const { return OP_::Apply(At(l_, row, col), At(r_, row, col)); }
+        };
+
+        template <class A_> class Negate_ : public Base_ {
+            Held_<A_> a_;
+
+        public:
+            static constexpr bool MATRIX = IsMatrix<A_>();
+
+            // not a candidate for copies of the node itself
+            template <class AA_, class = std::enable_if_t<!std::is_same_v<Plain_<AA_>, Negate_>>>
+            explicit Negate_(AA_&& a) : a_(std::forward<AA_>(a)) {}
+            size_t size() const { return a_.size(); }
+            int Rows() const { return a_.Rows(); }
+            int Cols() const { return a_.Cols(); }
+            auto operator[](size_t i) const { return -a_[i]; }
+            auto operator()(int row, int col) const { return -a_(row, col); }
+        };
+
+        // element-wise f(x), e.g. with a generic lambda so that Number_ elements stay on the tape
+        template <class A_, class F_> class Apply_ : public Base_ {
+            Held_<A_> a_;
+            F_ f_;
+
+        public:
+            static constexpr bool MATRIX = IsMatrix<A_>();
+
+            template <class AA_> Apply_(AA_&& a, F_ f) : a_(std::forward<AA_>(a)), f_(f) {}
+            size_t size() const { return a_.size(); }
+            int Rows() const { return a_.Rows(); }
+            int Cols() const { return a_.Cols(); }
+            auto operator[](size_t i) const { return f_(a_[i]); }
+            auto operator()(int row, int col) const { return f_(a_(row, col)); }
+        };
+
+        // lazy counterpart of Apply in algorithms.hpp
+        template <class A_, class F_, class = std::enable_if_t<IS_OPERAND<A_>>> auto Map(A_&& a, F_ f) {
+            return Apply_<A_, F_>(std::forward<A_>(a), f);
+        }
+
+        template <class L_, class R_>
+        using EnableBinary_ = std::enable_if_t<IS_OPERAND<L_> || IS_OPERAND<R_>>;
+
+        // the fused loops; dst[i] may be read by src[i] (e.g. a = a * s), but no other element of dst may be
+        // an array or expression src must conform to dst, a scalar is broadcast
+        template <class D_, class X_> void Assign(D_* dst, const X_& src) {
+            RequireConform(Conform(*dst, src));
+            const size_t n = dst->size();
+            for (size_t i = 0; i < n; ++i)
+                (*dst)[i] = At(src, i);
+        }
+
+        template <class D_, class X_> void AddTo(D_* dst, const X_& src) {
+            RequireConform(Conform(*dst, src));
+            const size_t n = dst->size();
+            for (size_t i = 0; i < n; ++i)
+                (*dst)[i] += At(src, i);
+        }
+
+        template <class D_, class X_> void SubtractFrom(D_* dst, const X_& src) {
+            RequireConform(Conform(*dst, src));
+            const size_t n = dst->size();
+            for (size_t i = 0; i < n; ++i)
+                (*dst)[i] -= At(src, i);
+        }
+
+        template <class D_, class X_> void MultiplyBy(D_* dst, const X_& src) {
+            RequireConform(Conform(*dst, src));
+            const size_t n = dst->size();
+            for (size_t i = 0; i < n; ++i)
+                (*dst)[i] *= At(src, i);
+        }
+    } // namespace Expr
+
+    template <class L_, class R_, class = Expr::EnableBinary_<L_, R_>> auto operator+(L_&& l, R_&& r) {
+        return Expr::Binary_<L_, R_, Expr::Plus_>(std::forward<L_>(l), std::forward<R_>(r));
+    }
+
+    template <class L_, class R_, class = Expr::EnableBinary_<L_, R_>> auto operator-(L_&& l, R_&& r) {
+        return Expr::Binary_<L_, R_, Expr::Minus_>(std::forward<L_>(l), std::forward<R_>(r));
+    }
+
+    template <class L_, class R_, class = Expr::EnableBinary_<L_, R_>> auto operator*(L_&& l, R_&& r) {
+        return Expr::Binary_<L_, R_, Expr::Multiplies_>(std::forward<L_>(l), std::forward<R_>(r));
+    }
+
+    template <class L_, class R_, class = Expr::EnableBinary_<L_, R_>> auto operator/(L_&& l, R_&& r) {
+        return Expr::Binary_<L_, R_, Expr::Divides_>(std::forward<L_>(l), std::forward<R_>(r));
+    }
+
+    template <class A_, class = std::enable_if_t<Expr::IS_OPERAND<A_>>> auto operator-(A_&& a) {
+        return Expr::Negate_<A_>(std::forward<A_>(a));
+    }
+} // namespace Dal
@@ -4,6 +4,7 @@
 
 #include <dal/platform/platform.hpp>
 #include <dal/math/interp/interp.hpp>
+#include <dal/math/interp/pieces.hpp>
 #include <dal/platform/strict.hpp>
 
 #include <dal/storage/archive.hpp>
@@ -12,15 +13,24 @@
 namespace Dal {
     Interp1_::Interp1_(const String_& name) : Storable_("Interp1", name) {}
 
+    void Interp1_::Evaluate(const Vector_<>& xs, Vector_<>* out) const {
+        REQUIRE(out && out != &xs, "Output should be distinct from the queries");
+        out->Resize(xs.size());
+        for (int k = 0; k < xs.size(); ++k)
+            (*out)[k] = (*this)(xs[k]);
+    }
+
     Interp1Linear_::Interp1Linear_(const String_& name, const Vector_<>& x, const Vector_<>& f)
         : Interp1_(name), x_(x), f_(f) {
         REQUIRE(x_.size() == f_.size(), "x_ size must be equal to f_ size");
         REQUIRE(IsMonotonic(x_, std::less_equal<>()), "x_ array should be monotonic");
+        pieces_ = Interp::LinearPieces(x_, f_);
     }
 
     Interp1Linear_::Interp1Linear_(const String_& name, const std::map<double, double>& f)
         : Interp1_(name), x_(Keys(f)), f_(MapValues(f)) {
         REQUIRE(IsMonotonic(x_, std::less_equal<>()), "x_ array should be monotonic");
+        pieces_ = Interp::LinearPieces(x_, f_);
     }
 
     double Interp1Linear_::operator()(double x) const {
@@ -37,6 +47,13 @@ namespace Dal {
         }
     }
 
+    // agrees with operator() up to rounding: a query within EPSILON below a knot is interpolated, not snapped
+    void Interp1Linear_::Evaluate(const Vector_<>& xs, Vector_<>* out) const {
+        Vector_<int> segment;
+        Interp::Locate(x_, xs, &segment);
+        Interp::EvaluatePieces(pieces_, xs, segment, out);
+    }
+
     namespace Interp {
         Interp1_* NewLinear(const String_& name, const Vector_<>& x, const Vector_<>& f) {
             return new Interp1Linear_(name, x, f);
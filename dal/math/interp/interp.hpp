@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <dal/math/matrix/matrixs.hpp>
 #include <dal/storage/archive.hpp>
 #include <map>
 
@@ -13,6 +14,8 @@ namespace Dal {
         Interp1_(const String_& name);
         virtual double operator()(double x) const = 0;
         virtual bool IsInBounds(double x) const { return true; }
+        // (*out)[k] = (*this)(xs[k]); fastest when xs is sorted, or nearly so
+        virtual void Evaluate(const Vector_<>& xs, Vector_<>* out) const;
     };
 } // namespace Dal
 
@@ -30,12 +33,14 @@ namespace Dal {
     class Interp1Linear_ : public Interp1_ {
         Vector_<> x_;
         Vector_<> f_;
+        Matrix_<> pieces_; // row s is the segment which LowerBound(x_, .) maps to s, flat beyond the ends
 
     public:
         Interp1Linear_(const String_& name, const Vector_<>& x, const Vector_<>& f);
         Interp1Linear_(const String_& name, const std::map<double, double>& f);
         void Write(Archive::Store_& dst) const override;
         double operator()(double x) const override;
+        void Evaluate(const Vector_<>& xs, Vector_<>* out) const override;
         const Vector_<>& x() const { return x_; }
         const Vector_<>& f() const { return f_; }
     };
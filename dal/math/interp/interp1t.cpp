@@ -0,0 +1,79 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/interp/interp1t.hpp>
+#include <dal/platform/strict.hpp>
+#include <initializer_list>
+
+namespace Dal {
+    namespace {
+        Number_ Record(double val, std::initializer_list<Number_> args, std::initializer_list<double> ders) {
+            return Number_::Record(val, args.size(), args.begin(), ders.begin());
+        }
+    } // namespace
+
+    Vector_<Number_> Interp::SplineSecondDerivatives(const Vector_<>& x,
+                                                     const Vector_<Number_>& f,
+                                                     const Boundary_& lhs,
+                                                     const Boundary_& rhs) {
+        REQUIRE(x.size() > 2 && IsMonotonic(x), "x size should be greater than 2 and monotonic");
+        REQUIRE(x.size() == f.size(), "x and f size should be same");
+        const int n = static_cast<int>(x.size());
+        Vector_<> values(n);
+        for (int j = 0; j < n; ++j)
+            values[j] = f[j].Value();
+        const Vector_<> fpp = SplineSecondDerivatives(x, values, lhs, rhs);
+
+        // the steps of the fit as in the double version, with the boundary values dropped (they only shift fpp)
+        // the forward sweep nodes carry only derivatives, their values are not used
+        Vector_<Number_> ret_val(n);
+        Vector_<> u(n - 1);
+        switch (lhs.order_) {
+        default:
+            THROW("Invalid boundary order");
+        case 1: {
+            const double dx = x[1] - x[0];
+            ret_val[0] = Record(0.0, {f[0], f[1]}, {-3.0 / Square(dx), 3.0 / Square(dx)});
+            u[0] = -0.5;
+        } break;
+        case 2:
+        case 3:
+            ret_val[0] = Number_(0.0);
+            u[0] = lhs.order_ == 2 ? 0.0 : 1.0;
+            break;
+        }
+        for (int i = 1; i < n - 1; ++i) {
+            const double dx = x[i] - x[i - 1];
+            const double d2 = x[i + 1] - x[i - 1];
+            const double h = x[i + 1] - x[i];
+            const double sig = dx / d2;
+            const double p = sig * u[i - 1] + 2.0;
+            u[i] = (sig - 1.0) / p;
+            const double scale = 6.0 / (p * d2);
+            ret_val[i] = Record(0.0, {f[i - 1], f[i], f[i + 1], ret_val[i - 1]},
+                                {scale / dx, -scale * (1.0 / h + 1.0 / dx), scale / h, -dx / (p * d2)});
+        }
+        switch (rhs.order_) {
+        default:
+            THROW("Invalid boundary order");
+        case 1: {
+            const double dx = x[n - 1] - x[n - 2];
+            const double scale = 6.0 / (Square(dx) * (2.0 + u[n - 2]));
+            ret_val[n - 1] =
+                Record(fpp[n - 1], {f[n - 2], f[n - 1], ret_val[n - 2]}, {scale, -scale, -1.0 / (2.0 + u[n - 2])});
+        } break;
+        case 2:
+            ret_val[n - 1] = Number_(fpp[n - 1]);
+            break;
+        case 3:
+            ret_val[n - 1] = Record(fpp[n - 1], {ret_val[n - 2]}, {1.0 / (1.0 - u[n - 2])});
+            break;
+        }
+        // back substitution: the adjoint sweep runs it forward, so the whole fit costs O(n) on the tape
+        for (int k = n - 2; k >= 0; --k)
+            ret_val[k] = Record(fpp[k], {ret_val[k], ret_val[k + 1]}, {1.0, u[k]});
+        return ret_val;
+    }
+} // namespace Dal
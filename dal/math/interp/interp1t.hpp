@@ -0,0 +1,76 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/aad/aad.hpp>
+#include <dal/math/interp/interpcubic.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+/*
+ * Interpolators on node values of type T_, e.g. Number_, so that one adjoint sweep through a curve read
+ * gives the sensitivities to all of its nodes; the abscissas (times, strikes) stay double
+ */
+
+namespace Dal {
+    template <class T_ = double> class Interp1T_ {
+    public:
+        virtual ~Interp1T_() = default;
+        virtual T_ operator()(double x) const = 0;
+    };
+
+    // as Interp1Linear_
+    template <class T_ = double> class Interp1LinearT_ : public Interp1T_<T_> {
+        Vector_<> x_;
+        Vector_<T_> f_;
+
+    public:
+        Interp1LinearT_(const Vector_<>& x, const Vector_<T_>& f) : x_(x), f_(f) {
+            REQUIRE(!x_.empty() && x_.size() == f_.size(), "x_ size must be equal to f_ size");
+            REQUIRE(IsMonotonic(x_, std::less_equal<>()), "x_ array should be monotonic");
+        }
+
+        T_ operator()(double x) const override {
+            auto pge = LowerBound(x_, x);
+            if (pge == x_.end())
+                return f_.back();
+            const ptrdiff_t ige = pge - x_.begin();
+            if (ige == 0 || IsZero(x - *pge))
+                return f_[ige];
+            const double gFrac = (x - x_[ige - 1]) / (x_[ige] - x_[ige - 1]);
+            return f_[ige - 1] + gFrac * (f_[ige] - f_[ige - 1]);
+        }
+    };
+
+    namespace Interp {
+        /*
+         * the values are fitted in double; the tape records each step of the tri-diagonal solve as a node on at
+         * most four arguments, so that the adjoint sweep solves the transposed system, in O(n) time and tape
+         */
+        Vector_<Number_> SplineSecondDerivatives(const Vector_<>& x,
+                                                 const Vector_<Number_>& f,
+                                                 const Boundary_& lhs,
+                                                 const Boundary_& rhs);
+    } // namespace Interp
+
+    // as NewCubic: splint's formula, extrapolating the end cubics
+    template <class T_ = double> class Cubic1T_ : public Interp1T_<T_> {
+        Vector_<> x_;
+        Vector_<T_> f_, fpp_;
+
+    public:
+        Cubic1T_(const Vector_<>& x, const Vector_<T_>& f, const Interp::Boundary_& lhs, const Interp::Boundary_& rhs)
+            : x_(x), f_(f), fpp_(Interp::SplineSecondDerivatives(x, f, lhs, rhs)) {}
+
+        T_ operator()(double x) const override {
+            const ptrdiff_t iGE = Min<ptrdiff_t>(x_.size() - 1, Max<ptrdiff_t>(1, LowerBound(x_, x) - x_.begin()));
+            const ptrdiff_t iLT = iGE - 1;
+            const double h = x_[iGE] - x_[iLT];
+            const double b = (x - x_[iLT]) / h;
+            const double a = 1.0 - b;
+            const double c = a * b * Square(h) / 6.0;
+            return a * f_[iLT] + b * f_[iGE] - (c * (1.0 + a)) * fpp_[iLT] - (c * (1.0 + b)) * fpp_[iGE];
+        }
+    };
+} // namespace Dal
@@ -0,0 +1,286 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/interp/interp2.hpp>
+#include <dal/platform/strict.hpp>
+#include <cmath>
+#include <dal/math/interp/interpcubic.hpp>
+#include <dal/math/interp/pieces.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+/*IF--------------------------------------------------------------------------
+storable Interp2Bilinear
+        Bilinear interpolator on a grid
+&members
+name is ?string
+        Name of the object
+x is number[]
+        Knots in the first dimension
+y is number[]
+        Knots in the second dimension
+z is number[][]
+        Values on the grid, one row per x and one column per y
+-IF-------------------------------------------------------------------------*/
+
+/*IF--------------------------------------------------------------------------
+storable Interp2Bicubic
+        Bicubic spline interpolator on a grid
+&members
+name is ?string
+        Name of the object
+x is number[]
+        Knots in the first dimension
+y is number[]
+        Knots in the second dimension
+z is number[][]
+        Values on the grid, one row per x and one column per y
+-IF-------------------------------------------------------------------------*/
+
+/*IF--------------------------------------------------------------------------
+storable Interp2TotalVariance
+        Implied vol surface, splined in strike and linear in total variance across expiries
+&members
+name is ?string
+        Name of the object
+x is number[]
+        Expiries, which must be positive
+y is number[]
+        Strikes
+z is number[][]
+        Implied vols, one row per expiry and one column per strike
+-IF-------------------------------------------------------------------------*/
+
+namespace {
+    using namespace Dal;
+#include <dal/auto/MG_Interp2Bicubic_Write.inc>
+#include <dal/auto/MG_Interp2Bilinear_Write.inc>
+#include <dal/auto/MG_Interp2TotalVariance_Write.inc>
+} // namespace
+
+namespace Dal {
+    Interp2Slice_::Interp2Slice_(const Vector_<>& y, const Matrix_<>& pieces, bool sqrt_of_pieces)
+        : y_(y), pieces_(pieces), sqrt_(sqrt_of_pieces) {
+        REQUIRE(pieces_.Rows() == static_cast<int>(y_.size()) + 1,
+                "Slice needs one piece per interval between knots, and two more");
+    }
+
+    double Interp2Slice_::operator()(double y) const {
+        const double* p = pieces_.Row(static_cast<int>(LowerBound(y_, y) - y_.begin())).Data();
+        const double t = y - p[0];
+        double ret_val = 0.0;
+        for (int c = pieces_.Cols() - 1; c > 0; --c)
+            ret_val = ret_val * t + p[c];
+        return sqrt_ ? std::sqrt(Max(0.0, ret_val)) : ret_val;
+    }
+
+    void Interp2Slice_::Evaluate(const Vector_<>& ys, Vector_<>* out) const {
+        Vector_<int> segment;
+        Interp::Locate(y_, ys, &segment);
+        Interp::EvaluatePieces(pieces_, ys, segment, out);
+        if (sqrt_)
+            for (auto& v : *out)
+                v = std::sqrt(Max(0.0, v));
+    }
+
+    Interp2_::Interp2_(const String_& name) : Storable_("Interp2", name) {}
+
+    namespace {
+        // flat beyond the knots, instead of extending the end cubics
+        void Flatten(const Vector_<>& f, Matrix_<>* pieces) {
+            const int last = pieces->Rows() - 1;
+            for (int c = 2; c < pieces->Cols(); ++c)
+                (*pieces)(0, c) = (*pieces)(last, c) = 0.0;
+            (*pieces)(0, 1) = f.front();
+            (*pieces)(last, 1) = f.back();
+        }
+
+        Matrix_<> NaturalCubicPieces(const Vector_<>& y, const Vector_<>& f) {
+            const Interp::Boundary_ natural(2, 0.0);
+            Matrix_<> ret_val = Interp::CubicPieces(y, f, Interp::SplineSecondDerivatives(y, f, natural, natural));
+            Flatten(f, &ret_val);
+            return ret_val;
+        }
+
+        /*
+         * a value at x is sum_i weights(x)[i] * rows_[i](y); the row pieces share their left knots (column 0)
+         * so any linear combination of them is a piecewise polynomial on the same intervals
+         */
+        class Grid2_ : public Interp2_ {
+        protected:
+            Vector_<> x_, y_;
+            Matrix_<> z_;
+            Vector_<Matrix_<>> rows_;
+            bool sqrt_;
+
+            virtual Vector_<> Weights(double x) const = 0;
+
+            Grid2_(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z, int min_knots)
+                : Interp2_(name), x_(x), y_(y), z_(z), sqrt_(false) {
+                const int nx = static_cast<int>(x_.size()), ny = static_cast<int>(y_.size());
+                REQUIRE(nx >= min_knots && ny >= min_knots, "Too few knots for the surface");
+                REQUIRE(IsMonotonic(x_) && IsMonotonic(y_), "Surface knots should be increasing");
+                REQUIRE(z_.Rows() == nx && z_.Cols() == ny, "Surface values should be x by y");
+            }
+
+            // the linear weights of the x knots around x, flat beyond the ends
+            Vector_<> LinearWeights(double x) const {
+                const int n = static_cast<int>(x_.size());
+                Vector_<> ret_val(n, 0.0);
+                const int hi = static_cast<int>(LowerBound(x_, x) - x_.begin());
+                if (hi == 0)
+                    ret_val.front() = 1.0;
+                else if (hi == n)
+                    ret_val.back() = 1.0;
+                else {
+                    const double b = (x - x_[hi - 1]) / (x_[hi] - x_[hi - 1]);
+                    ret_val[hi - 1] = 1.0 - b;
+                    ret_val[hi] = b;
+                }
+                return ret_val;
+            }
+
+        public:
+            double operator()(double x, double y) const override {
+                const Vector_<> w = Weights(x);
+                const int n = static_cast<int>(w.size());
+                const int s = static_cast<int>(LowerBound(y_, y) - y_.begin());
+                double ret_val = 0.0;
+                for (int i = 0; i < n; ++i) {
+                    if (w[i] == 0.0)
+                        continue;
+                    const double* p = rows_[i].Row(s).Data();
+                    const double t = y - p[0];
+                    double v = 0.0;
+                    for (int c = rows_[i].Cols() - 1; c > 0; --c)
+                        v = v * t + p[c];
+                    ret_val += w[i] * v;
+                }
+                return sqrt_ ? std::sqrt(Max(0.0, ret_val)) : ret_val;
+            }
+
+            Interp2Slice_ Slice(double x) const override {
+                const Vector_<> w = Weights(x);
+                const int n = static_cast<int>(w.size());
+                Matrix_<> pieces(rows_[0].Rows(), rows_[0].Cols());
+                for (int i = 0; i < n; ++i)
+                    if (w[i] != 0.0)
+                        pieces += rows_[i] * w[i];
+                for (int s = 0; s < pieces.Rows(); ++s)
+                    pieces(s, 0) = rows_[0](s, 0);
+                return Interp2Slice_(y_, pieces, sqrt_);
+            }
+        };
+
+        struct Interp2Bilinear_ : Grid2_ {
+            Interp2Bilinear_(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z)
+                : Grid2_(name, x, y, z, 2) {
+                const int n = static_cast<int>(x_.size());
+                for (int i = 0; i < n; ++i)
+                    rows_.push_back(Interp::LinearPieces(y_, Copy(z_.Row(i))));
+            }
+
+            Vector_<> Weights(double x) const override { return LinearWeights(x); }
+            void Write(Archive::Store_& dst) const override { Interp2Bilinear::XWrite(dst, name_, x_, y_, z_); }
+        };
+
+        struct Interp2Bicubic_ : Grid2_ {
+            Matrix_<> dfpp_; // dfpp_(i, j) is the derivative of the natural spline's fpp at x_i by its value at x_j
+
+            Interp2Bicubic_(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z)
+                : Grid2_(name, x, y, z, 3), dfpp_(x_.size(), x_.size()) {
+                const int n = static_cast<int>(x_.size());
+                for (int i = 0; i < n; ++i)
+                    rows_.push_back(NaturalCubicPieces(y_, Copy(z_.Row(i))));
+                const Interp::Boundary_ natural(2, 0.0);
+                for (int j = 0; j < n; ++j) {
+                    Vector_<> unit(n, 0.0);
+                    unit[j] = 1.0;
+                    const Vector_<> fpp = Interp::SplineSecondDerivatives(x_, unit, natural, natural);
+                    for (int i = 0; i < n; ++i)
+                        dfpp_(i, j) = fpp[i];
+                }
+            }
+
+            // splint's formula, as weights on the values at the x knots
+            Vector_<> Weights(double x) const override {
+                const int n = static_cast<int>(x_.size());
+                const int hi = static_cast<int>(LowerBound(x_, x) - x_.begin());
+                if (hi == 0 || hi == n)
+                    return LinearWeights(x);
+                const double h = x_[hi] - x_[hi - 1];
+                const double b = (x - x_[hi - 1]) / h;
+                const double a = 1.0 - b;
+                const double c = a * b * h * h / 6.0;
+                Vector_<> ret_val(n);
+                for (int j = 0; j < n; ++j)
+                    ret_val[j] = -c * ((1.0 + a) * dfpp_(hi - 1, j) + (1.0 + b) * dfpp_(hi, j));
+                ret_val[hi - 1] += a;
+                ret_val[hi] += b;
+                return ret_val;
+            }
+
+            void Write(Archive::Store_& dst) const override { Interp2Bicubic::XWrite(dst, name_, x_, y_, z_); }
+        };
+
+        // rows_ hold total variance; the weights give variance per unit time, whose square root is the vol
+        struct Interp2TotalVariance_ : Grid2_ {
+            Interp2TotalVariance_(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z)
+                : Grid2_(name, x, y, z, 3) {
+                REQUIRE(x_.front() > 0.0, "Expiries should be positive");
+                sqrt_ = true;
+                const int n = static_cast<int>(x_.size());
+                for (int i = 0; i < n; ++i) {
+                    Vector_<> w = Copy(z_.Row(i));
+                    for (auto& v : w)
+                        v *= v * x_[i];
+                    rows_.push_back(NaturalCubicPieces(y_, w));
+                }
+            }
+
+            Vector_<> Weights(double x) const override {
+                Vector_<> ret_val = LinearWeights(x);
+                const int n = static_cast<int>(x_.size());
+                const int hi = static_cast<int>(LowerBound(x_, x) - x_.begin());
+                if (hi == 0)
+                    ret_val.front() = 1.0 / x_.front();
+                else if (hi == n)
+                    ret_val.back() = 1.0 / x_.back();
+                else {
+                    ret_val[hi - 1] /= x;
+                    ret_val[hi] /= x;
+                }
+                return ret_val;
+            }
+
+            void Write(Archive::Store_& dst) const override { Interp2TotalVariance::XWrite(dst, name_, x_, y_, z_); }
+        };
+
+#include <dal/auto/MG_Interp2Bicubic_Read.inc>
+#include <dal/auto/MG_Interp2Bilinear_Read.inc>
+#include <dal/auto/MG_Interp2TotalVariance_Read.inc>
+    } // namespace
+
+    Interp2_* Interp::NewBilinear(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z) {
+        return new Interp2Bilinear_(name, x, y, z);
+    }
+
+    Interp2_* Interp::NewBicubic(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z) {
+        return new Interp2Bicubic_(name, x, y, z);
+    }
+
+    Interp2_* Interp::NewTotalVariance(const String_& name,
+                                       const Vector_<>& x,
+                                       const Vector_<>& y,
+                                       const Matrix_<>& z) {
+        return new Interp2TotalVariance_(name, x, y, z);
+    }
+
+    Vector_<Interp2Slice_> Interp::Slices(const Interp2_& surface, const Vector_<>& xs) {
+        Vector_<Interp2Slice_> ret_val;
+        for (const auto& x : xs)
+            ret_val.push_back(surface.Slice(x));
+        return ret_val;
+    }
+} // namespace Dal
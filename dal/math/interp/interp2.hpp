@@ -0,0 +1,55 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/matrix/matrixs.hpp>
+#include <dal/storage/archive.hpp>
+
+/*
+ * Surfaces z(x, y) on a grid of x (e.g. expiries) by y (e.g. strikes)
+ * each surface caches the pieces of its splines in y, one set per x knot; a slice at fixed x combines them
+ * into a single piecewise polynomial in y, which is cheap to evaluate and can be built once per timeline date
+ */
+
+namespace Dal {
+    // the surface at a fixed x, as a function of y
+    class Interp2Slice_ {
+        Vector_<> y_;
+        Matrix_<> pieces_; // as for Interp::EvaluatePieces, row s is the piece which LowerBound(y_, .) maps to s
+        bool sqrt_;        // if set, the pieces hold a variance and values are its square root
+
+    public:
+        Interp2Slice_() : sqrt_(false) {}
+        Interp2Slice_(const Vector_<>& y, const Matrix_<>& pieces, bool sqrt_of_pieces);
+        double operator()(double y) const;
+        // (*out)[k] = (*this)(ys[k]); fastest when ys is sorted
+        void Evaluate(const Vector_<>& ys, Vector_<>* out) const;
+    };
+
+    class Interp2_ : public Storable_ {
+    public:
+        Interp2_(const String_& name);
+        virtual double operator()(double x, double y) const = 0;
+        virtual Interp2Slice_ Slice(double x) const = 0;
+    };
+
+    namespace Interp {
+        // z has one row per x and one column per y; all three surfaces are flat beyond the grid
+
+        // linear in each direction
+        Interp2_* NewBilinear(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z);
+        // natural cubic splines in y, then in x through the splined rows; needs at least three knots each way
+        Interp2_* NewBicubic(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z);
+        /*
+         * implied vols z at expiries x > 0 and strikes y: a natural cubic spline in strike of the total variance
+         * z^2 x at each expiry, interpolated linearly in x between expiries; vol is flat before the first
+         * expiry and after the last
+         */
+        Interp2_* NewTotalVariance(const String_& name, const Vector_<>& x, const Vector_<>& y, const Matrix_<>& z);
+
+        // one slice per x, e.g. per simulation date
+        Vector_<Interp2Slice_> Slices(const Interp2_& surface, const Vector_<>& xs);
+    } // namespace Interp
+} // namespace Dal
@@ -4,7 +4,10 @@
 
 #include <dal/platform/platform.hpp>
 #include <dal/math/interp/interpcubic.hpp>
+#include <dal/math/interp/pieces.hpp>
 #include <dal/platform/strict.hpp>
+#include <algorithm>
+#include <dal/math/matrix/tridiagonal.hpp>
 #include <dal/storage/archive.hpp>
 
 /*IF--------------------------------------------------------------------------
@@ -29,9 +32,24 @@ namespace {
 
 namespace Dal {
     namespace {
+        // based on Numerical Recipes' splint
+        double Splint(const Vector_<>& xs, const Vector_<>& f, const Vector_<>& fpp, double x) {
+            auto pGE = LowerBound(xs, x);
+            if (pGE != xs.end() && *pGE == x)
+                return f[pGE - xs.begin()];
+            const ptrdiff_t iGE = Min<ptrdiff_t>(xs.size() - 1, Max<ptrdiff_t>(1, pGE - xs.begin()));
+            const ptrdiff_t iLT = iGE - 1;
+            const double h = xs[iGE] - xs[iLT];
+            const double b = (x - xs[iLT]) / h;
+            const double a = 1.0 - b;
+            return a * f[iLT] + b * f[iGE] - a * b * ((1.0 + a) * fpp[iLT] + (1.0 + b) * fpp[iGE]) * Square(h) / 6.0;
+        }
+
         struct Cubic1_ : Interp1_ {
             Vector_<> x_, f_, fpp_;
+            Matrix_<> pieces_;
             double operator()(double x) const override;
+            void Evaluate(const Vector_<>& xs, Vector_<>* out) const override;
             bool IsInBounds(double x) const override {
                 return x >= x_.front() && x <= x_.back();
             } // simply forbid extrapolation
@@ -43,89 +61,219 @@ namespace Dal {
                     const Interp::Boundary_& rhs);
 
             Cubic1_(const String_& name, const Vector_<>& x, const Vector_<>& f, const Vector_<>& fpp)
-                : Interp1_(name), x_(x), f_(f), fpp_(fpp) {}
+                : Interp1_(name), x_(x), f_(f), fpp_(fpp), pieces_(Interp::CubicPieces(x_, f_, fpp_)) {}
 
             void Write(Archive::Store_& dst) const override { Cubic1::XWrite(dst, name_, x_, f_, fpp_); }
         };
 
 #include <dal/auto/MG_Cubic1_Read.inc>
 
-        // based on Numerical Recipes' splint
-        double Cubic1_::operator()(double x) const {
-            auto pGE = LowerBound(x_, x);
-            if (pGE != x_.end() && *pGE == x)
-                return f_[pGE - x_.begin()];
-            const ptrdiff_t iGE = Min<ptrdiff_t>(x_.size() - 1, Max<ptrdiff_t>(1, pGE - x_.begin()));
-            const ptrdiff_t iLT = iGE - 1;
-            const double h = x_[iGE] - x_[iLT];
-            const double b = (x - x_[iLT]) / h;
-            const double a = 1.0 - b;
-            return a * f_[iLT] + b * f_[iGE] -
-                   a * b * ((1.0 + a) * fpp_[iLT] + (1.0 + b) * fpp_[iGE]) * Square(h) / 6.0;
+        double Cubic1_::operator()(double x) const { return Splint(x_, f_, fpp_, x); }
+
+        void Cubic1_::Evaluate(const Vector_<>& xs, Vector_<>* out) const {
+            Vector_<int> segment;
+            Interp::Locate(x_, xs, &segment);
+            Interp::EvaluatePieces(pieces_, xs, segment, out);
         }
 
-        // the spline-fitting process
         Cubic1_::Cubic1_(const String_& name,
                          const Vector_<>& x,
                          const Vector_<>& f,
                          const Interp::Boundary_& lhs,
                          const Interp::Boundary_& rhs)
-            : Interp1_(name), x_(x), f_(f), fpp_(f_.size()) {
-            REQUIRE(x_.size() > 2 && IsMonotonic(x_), "x size should be greater than 2 and monotonic");
-            REQUIRE(x_.size() == f_.size(), "x and f size should be same");
-            const int n = static_cast<int>(x_.size());
-            Vector_<> u(n - 1);
-            switch (lhs.order_) // set left boundary
-            {
+            : Interp1_(name), x_(x), f_(f), fpp_(Interp::SplineSecondDerivatives(x, f, lhs, rhs)),
+              pieces_(Interp::CubicPieces(x_, f_, fpp_)) {}
+    } // namespace
+
+    // the spline-fitting process
+    Vector_<> Interp::SplineSecondDerivatives(const Vector_<>& x,
+                                              const Vector_<>& f,
+                                              const Boundary_& lhs,
+                                              const Boundary_& rhs) {
+        Vector_<> ret_val(f.size());
+        REQUIRE(x.size() > 2 && IsMonotonic(x), "x size should be greater than 2 and monotonic");
+        REQUIRE(x.size() == f.size(), "x and f size should be same");
+        const int n = static_cast<int>(x.size());
+        Vector_<> u(n - 1);
+        switch (lhs.order_) // set left boundary
+        {
+        default:
+            THROW("Invalid boundary order");
+        case 1: {
+            const double dx = x[1] - x[0];
+            ret_val[0] = ((f[1] - f[0]) / dx - lhs.value_) * (3.0 / dx);
+            u[0] = -0.5;
+        } break;
+        case 2:
+            ret_val[0] = lhs.value_;
+            u[0] = 0.0;
+            break;
+        case 3:
+            ret_val[0] = -(x[1] - x[0]) * lhs.value_;
+            u[0] = 1.0;
+            break;
+        }
+        for (int i = 1; i < n - 1; ++i) // decomposition
+        {
+            const double dx = x[i] - x[i - 1];
+            const double d2 = x[i + 1] - x[i - 1];
+            const double sig = dx / d2;
+            const double p = sig * u[i - 1] + 2.0;
+            u[i] = (sig - 1.0) / p;
+            const double temp = (f[i + 1] - f[i]) / (x[i + 1] - x[i]) - (f[i] - f[i - 1]) / dx;
+            ret_val[i] = (6.0 * temp - dx * ret_val[i - 1]) / (p * d2);
+        }
+        switch (rhs.order_) // set right boundary
+        {
+        default:
+            THROW("Invalid boundary order");
+        case 1: {
+            const double dx = x[n - 1] - x[n - 2];
+            const double un = (3.0 / dx) * (rhs.value_ - (f[n - 1] - f[n - 2]) / dx);
+            ret_val[n - 1] = (2.0 * un - ret_val[n - 2]) / (2.0 + u[n - 2]);
+        } break;
+        case 2:
+            ret_val[n - 1] = rhs.value_;
+            break;
+        case 3:
+            ret_val[n - 1] = ((x[n - 1] - x[n - 2]) * rhs.value_ + ret_val[n - 2]) / (1.0 - u[n - 2]);
+            break;
+        }
+        for (int k = n - 2; k >= 0; --k) // backsubstitution
+            ret_val[k] += u[k] * ret_val[k + 1];
+        return ret_val;
+    }
+
+    Interp1_* Interp::NewCubic(
+        const String_& name, const Vector_<>& x, const Vector_<>& f, const Boundary_& lhs, const Boundary_& rhs) {
+        return new Cubic1_(name, x, f, lhs, rhs);
+    }
+
+    /*
+     * the spline equations h_{i-1} fpp_{i-1} / 6 + (h_{i-1} + h_i) fpp_i / 3 + h_i fpp_{i+1} / 6 = s_i - s_{i-1},
+     * where s_i is the slope of f on [x_i, x_{i+1}], with the boundary conditions as the first and last rows
+     */
+    struct Interp::CubicGrid_ {
+        Vector_<> x_;
+        Boundary_ lhs_, rhs_;
+        TriDiagonalFactor_ factor_;
+
+        static TriDiagonalFactor_ Factor(const Vector_<>& x, const Boundary_& lhs, const Boundary_& rhs) {
+            const int n = x.size();
+            Vector_<> below(n, 0.0), diag(n, 0.0), above(n, 0.0);
+            for (int i = 1; i < n - 1; ++i) {
+                below[i] = (x[i] - x[i - 1]) / 6.0;
+                diag[i] = (x[i + 1] - x[i - 1]) / 3.0;
+                above[i] = (x[i + 1] - x[i]) / 6.0;
+            }
+            const double h0 = x[1] - x[0], hn = x[n - 1] - x[n - 2];
+            switch (lhs.order_) {
             default:
                 THROW("Invalid boundary order");
-            case 1: {
-                const double dx = x_[1] - x_[0];
-                fpp_[0] = ((f_[1] - f_[0]) / dx - lhs.value_) * (3.0 / dx);
-                u[0] = -0.5;
-            } break;
+            case 1:
+                diag[0] = h0 / 3.0;
+                above[0] = h0 / 6.0;
+                break;
             case 2:
-                fpp_[0] = lhs.value_;
-                u[0] = 0.0;
+                diag[0] = 1.0;
                 break;
             case 3:
-                fpp_[0] = -(x_[1] - x_[0]) * lhs.value_;
-                u[0] = 1.0;
+                diag[0] = 1.0;
+                above[0] = -1.0;
                 break;
             }
-            for (int i = 1; i < n - 1; ++i) // decomposition
-            {
-                const double dx = x_[i] - x_[i - 1];
-                const double d2 = x_[i + 1] - x_[i - 1];
-                const double sig = dx / d2;
-                const double p = sig * u[i - 1] + 2.0;
-                u[i] = (sig - 1.0) / p;
-                const double temp = (f_[i + 1] - f_[i]) / (x_[i + 1] - x_[i]) - (f_[i] - f_[i - 1]) / dx;
-                fpp_[i] = (6.0 * temp - dx * fpp_[i - 1]) / (p * d2);
-            }
-            switch (rhs.order_) // set right boundary
-            {
+            switch (rhs.order_) {
             default:
                 THROW("Invalid boundary order");
-            case 1: {
-                const double dx = x_[n - 1] - x_[n - 2];
-                const double un = (3.0 / dx) * (rhs.value_ - (f_[n - 1] - f_[n - 2]) / dx);
-                fpp_[n - 1] = (2.0 * un - fpp_[n - 2]) / (2.0 + u[n - 2]);
-            } break;
+            case 1:
+                below[n - 1] = hn / 6.0;
+                diag[n - 1] = hn / 3.0;
+                break;
             case 2:
-                fpp_[n - 1] = rhs.value_;
+                diag[n - 1] = 1.0;
                 break;
             case 3:
-                fpp_[n - 1] = ((x_[n - 1] - x_[n - 2]) * rhs.value_ + fpp_[n - 2]) / (1.0 - u[n - 2]);
+                below[n - 1] = -1.0;
+                diag[n - 1] = 1.0;
                 break;
             }
-            for (int k = n - 2; k >= 0; --k) // backsubstitution
-                fpp_[k] += u[k] * fpp_[k + 1];
+            return TriDiagonalFactor_(below, diag, above);
         }
+
+        CubicGrid_(const Vector_<>& x, const Boundary_& lhs, const Boundary_& rhs)
+            : x_(x), lhs_(lhs), rhs_(rhs), factor_(Factor(x, lhs, rhs)) {}
+    };
+
+    namespace {
+        // a spline from CubicBuilder_, sharing its knots with the other curves
+        struct SharedCubic1_ : Interp1_ {
+            std::shared_ptr<const Interp::CubicGrid_> grid_;
+            Vector_<> f_, fpp_;
+
+            SharedCubic1_(const String_& name,
+                          const std::shared_ptr<const Interp::CubicGrid_>& grid,
+                          Vector_<> f,
+                          Vector_<> fpp)
+                : Interp1_(name), grid_(grid), f_(std::move(f)), fpp_(std::move(fpp)) {}
+
+            double operator()(double x) const override { return Splint(grid_->x_, f_, fpp_, x); }
+            bool IsInBounds(double x) const override { return x >= grid_->x_.front() && x <= grid_->x_.back(); }
+            void Write(Archive::Store_& dst) const override { ::Cubic1::XWrite(dst, name_, grid_->x_, f_, fpp_); }
+        };
     } // namespace
 
-    Interp1_* Interp::NewCubic(
-        const String_& name, const Vector_<>& x, const Vector_<>& f, const Boundary_& lhs, const Boundary_& rhs) {
-        return new Cubic1_(name, x, f, lhs, rhs);
+    Interp::CubicBuilder_::CubicBuilder_(const Vector_<>& x, const Boundary_& lhs, const Boundary_& rhs) {
+        REQUIRE(x.size() > 2 && IsMonotonic(x), "x size should be greater than 2 and monotonic");
+        grid_ = std::make_shared<const CubicGrid_>(x, lhs, rhs);
+    }
+
+    Matrix_<> Interp::CubicBuilder_::SecondDerivatives(const Matrix_<>& f, ThreadPool_* pool) const {
+        const Vector_<>& x = grid_->x_;
+        const int n = x.size();
+        REQUIRE(f.Rows() == n, "f should have one row per knot");
+        Matrix_<> ret_val(n, f.Cols());
+        for (int i = 1; i < n - 1; ++i)
+            ret_val.Row(i) =
+                (f.Row(i + 1) - f.Row(i)) / (x[i + 1] - x[i]) - (f.Row(i) - f.Row(i - 1)) / (x[i] - x[i - 1]);
+        auto fill = [&](int i, double v) {
+            auto row = ret_val.Row(i);
+            std::fill(row.begin(), row.end(), v);
+        };
+        const double h0 = x[1] - x[0], hn = x[n - 1] - x[n - 2];
+        const double lhs = grid_->lhs_.value_, rhs = grid_->rhs_.value_;
+        switch (grid_->lhs_.order_) {
+        case 1:
+            ret_val.Row(0) = (f.Row(1) - f.Row(0)) / h0 - lhs;
+            break;
+        case 2:
+            fill(0, lhs);
+            break;
+        default:
+            fill(0, -h0 * lhs);
+            break;
+        }
+        switch (grid_->rhs_.order_) {
+        case 1:
+            ret_val.Row(n - 1) = rhs - (f.Row(n - 1) - f.Row(n - 2)) / hn;
+            break;
+        case 2:
+            fill(n - 1, rhs);
+            break;
+        default:
+            fill(n - 1, hn * rhs);
+            break;
+        }
+        grid_->factor_.Solve(ret_val, &ret_val, pool);
+        return ret_val;
+    }
+
+    Vector_<Handle_<Interp1_>> Interp::CubicBuilder_::Build(const String_& name,
+                                                             const Matrix_<>& f,
+                                                             ThreadPool_* pool) const {
+        const Matrix_<> fpp = SecondDerivatives(f, pool);
+        Vector_<Handle_<Interp1_>> ret_val;
+        for (int j = 0; j < f.Cols(); ++j)
+            ret_val.emplace_back(new SharedCubic1_(name, grid_, Copy(f.Col(j)), Copy(fpp.Col(j))));
+        return ret_val;
     }
-} // namespace Dal
\ No newline at end of file
+} // namespace Dal
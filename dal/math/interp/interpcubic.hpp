@@ -4,9 +4,11 @@
 
 #pragma once
 #include <dal/math/interp/interp.hpp>
+#include <memory>
 
 namespace Dal {
     class String_;
+    class ThreadPool_;
     namespace Interp {
         struct Boundary_ {
             int order_;
@@ -14,7 +16,31 @@ namespace Dal {
             Boundary_(int o, double v) : order_(o), value_(v) {}
         };
 
+        // the splined second derivatives of f at each x, as fitted by NewCubic
+        Vector_<> SplineSecondDerivatives(const Vector_<>& x,
+                                          const Vector_<>& f,
+                                          const Boundary_& lhs,
+                                          const Boundary_& rhs);
+
         Interp1_* NewCubic(
             const String_& name, const Vector_<>& x, const Vector_<>& f, const Boundary_& lhs, const Boundary_& rhs);
+
+        struct CubicGrid_;
+        /*
+         * fits splines to many curves on the same knots and boundary conditions, as NewCubic would:
+         * the spline equations are factored once, then solved for all the curves together
+         * the splines built share the knots, and are stored as ordinary Cubic1 objects
+         */
+        class CubicBuilder_ {
+            std::shared_ptr<const CubicGrid_> grid_;
+
+        public:
+            CubicBuilder_(const Vector_<>& x, const Boundary_& lhs, const Boundary_& rhs);
+            // f has one row per knot and one column per curve, and so has the result
+            Matrix_<> SecondDerivatives(const Matrix_<>& f, ThreadPool_* pool = nullptr) const;
+            // one spline per column of f
+            Vector_<Handle_<Interp1_>>
+            Build(const String_& name, const Matrix_<>& f, ThreadPool_* pool = nullptr) const;
+        };
     } // namespace Interp
 } // namespace Dal
\ No newline at end of file
@@ -0,0 +1,180 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/interp/interpuniform.hpp>
+#include <dal/platform/strict.hpp>
+#include <cmath>
+#include <dal/math/interp/pieces.hpp>
+#include <dal/storage/archive.hpp>
+#include <dal/utilities/algorithms.hpp>
+
+/*IF--------------------------------------------------------------------------
+storable Interp1Uniform
+        Linear interpolator on equally spaced knots
+&members
+name is ?string
+        Name of the object
+lo is number
+        First knot
+hi is number
+        Last knot
+f is number[]
+        Values at the knots
+-IF-------------------------------------------------------------------------*/
+
+/*IF--------------------------------------------------------------------------
+storable Interp1LogUniform
+        Linear interpolator on knots equally spaced in log(x)
+&members
+name is ?string
+        Name of the object
+lo is number
+        First knot, which must be positive
+hi is number
+        Last knot
+f is number[]
+        Values at the knots
+-IF-------------------------------------------------------------------------*/
+
+/*IF--------------------------------------------------------------------------
+storable Interp1Table
+        Lookup table accelerating another interpolator on a fixed range
+&members
+name is ?string
+        Name of the object
+base is handle Interp1
+        Interpolator which is tabulated, and evaluated outside the range
+lo is number
+        Start of the tabulated range
+hi is number
+        End of the tabulated range
+size is integer
+        Number of samples of base, equally spaced from lo to hi
+-IF-------------------------------------------------------------------------*/
+
+namespace {
+    using namespace Dal;
+#include <dal/auto/MG_Interp1LogUniform_Write.inc>
+#include <dal/auto/MG_Interp1Table_Write.inc>
+#include <dal/auto/MG_Interp1Uniform_Write.inc>
+} // namespace
+
+namespace Dal {
+    namespace {
+        /*
+         * linear interpolation on knots at u = (T(x) - T(lo)) / du equal to 0, 1, ..., n - 1, where T is x or log(x)
+         * pieces_ are as for Interp1Linear_, indexed as LowerBound would index the knots
+         */
+        class UniformLinear_ : public Interp1_ {
+            bool log_;
+            double lo_, hi_, origin_, inverseStep_;
+            Vector_<> x_, f_;
+            Matrix_<> pieces_;
+
+            // the LowerBound index of x, up to rounding next to a knot (where the two pieces agree)
+            int Segment(double x) const {
+                if (!(x > lo_))
+                    return 0;
+                if (x > hi_)
+                    return static_cast<int>(x_.size());
+                const double u = ((log_ ? std::log(x) : x) - origin_) * inverseStep_;
+                return Min(static_cast<int>(x_.size()) - 1, 1 + static_cast<int>(u));
+            }
+
+        protected:
+            UniformLinear_(const String_& name, double lo, double hi, const Vector_<>& f, bool log_spaced)
+                : Interp1_(name), log_(log_spaced), lo_(lo), hi_(hi), f_(f) {
+                const int n = f_.size();
+                REQUIRE(n >= 2, "Uniform interpolation needs at least two knots");
+                REQUIRE(lo < hi, "Uniform knots should be increasing");
+                REQUIRE(!log_spaced || lo > 0.0, "Log-uniform knots should be positive");
+                origin_ = log_ ? std::log(lo) : lo;
+                const double step = ((log_ ? std::log(hi) : hi) - origin_) / (n - 1);
+                inverseStep_ = 1.0 / step;
+                x_.Resize(n);
+                for (int i = 0; i < n; ++i)
+                    x_[i] = log_ ? std::exp(origin_ + i * step) : origin_ + i * step;
+                x_.front() = lo;
+                x_.back() = hi;
+                pieces_ = Interp::LinearPieces(x_, f_);
+            }
+
+        public:
+            double operator()(double x) const override {
+                const double* p = pieces_.Row(Segment(x)).Data();
+                return p[1] + (x - p[0]) * p[2];
+            }
+
+            void Evaluate(const Vector_<>& xs, Vector_<>* out) const override {
+                Vector_<int> segment(xs.size());
+                for (int k = 0; k < xs.size(); ++k)
+                    segment[k] = Segment(xs[k]);
+                Interp::EvaluatePieces(pieces_, xs, segment, out);
+            }
+
+            double Lo() const { return lo_; }
+            double Hi() const { return hi_; }
+            const Vector_<>& F() const { return f_; }
+        };
+
+        struct Interp1Uniform_ : UniformLinear_ {
+            Interp1Uniform_(const String_& name, double lo, double hi, const Vector_<>& f)
+                : UniformLinear_(name, lo, hi, f, false) {}
+            void Write(Archive::Store_& dst) const override { Interp1Uniform::XWrite(dst, name_, Lo(), Hi(), F()); }
+        };
+
+        struct Interp1LogUniform_ : UniformLinear_ {
+            Interp1LogUniform_(const String_& name, double lo, double hi, const Vector_<>& f)
+                : UniformLinear_(name, lo, hi, f, true) {}
+            void Write(Archive::Store_& dst) const override {
+                Interp1LogUniform::XWrite(dst, name_, Lo(), Hi(), F());
+            }
+        };
+
+        struct Interp1Table_ : Interp1_ {
+            Handle_<Interp1_> base_;
+            double lo_, hi_;
+            int size_;
+            Handle_<Interp1_> table_;
+
+            Interp1Table_(const String_& name, const Handle_<Interp1_>& base, double lo, double hi, int size)
+                : Interp1_(name), base_(base), lo_(lo), hi_(hi), size_(size) {
+                REQUIRE(base_, "Tabulated interpolator should not be null");
+                REQUIRE(size_ >= 2 && lo_ < hi_, "Lookup table needs an increasing range and two samples");
+                Vector_<> samples;
+                base_->Evaluate(Vector::XRange(lo_, hi_, size_), &samples);
+                table_.reset(new Interp1Uniform_(name, lo_, hi_, samples));
+            }
+
+            double operator()(double x) const override { return x >= lo_ && x <= hi_ ? (*table_)(x) : (*base_)(x); }
+            bool IsInBounds(double x) const override { return base_->IsInBounds(x); }
+
+            void Evaluate(const Vector_<>& xs, Vector_<>* out) const override {
+                table_->Evaluate(xs, out);
+                for (int k = 0; k < xs.size(); ++k)
+                    if (!(xs[k] >= lo_ && xs[k] <= hi_))
+                        (*out)[k] = (*base_)(xs[k]);
+            }
+
+            void Write(Archive::Store_& dst) const override { Interp1Table::XWrite(dst, name_, base_, lo_, hi_, size_); }
+        };
+
+#include <dal/auto/MG_Interp1LogUniform_Read.inc>
+#include <dal/auto/MG_Interp1Table_Read.inc>
+#include <dal/auto/MG_Interp1Uniform_Read.inc>
+    } // namespace
+
+    Interp1_* Interp::NewUniform(const String_& name, double lo, double hi, const Vector_<>& f) {
+        return new Interp1Uniform_(name, lo, hi, f);
+    }
+
+    Interp1_* Interp::NewLogUniform(const String_& name, double lo, double hi, const Vector_<>& f) {
+        return new Interp1LogUniform_(name, lo, hi, f);
+    }
+
+    Interp1_* Interp::NewTable(const String_& name, const Handle_<Interp1_>& base, double lo, double hi, int size) {
+        return new Interp1Table_(name, base, lo, hi, size);
+    }
+} // namespace Dal
@@ -0,0 +1,27 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+#include <dal/math/interp/interp.hpp>
+
+/*
+ * Interpolators whose bucket is found arithmetically rather than by search
+ */
+
+namespace Dal {
+    class String_;
+    namespace Interp {
+        // linear in x on f.size() knots equally spaced from lo to hi, flat beyond them (as Interp1Linear_)
+        Interp1_* NewUniform(const String_& name, double lo, double hi, const Vector_<>& f);
+        // as above, with knots equally spaced in log(x); requires 0 < lo
+        Interp1_* NewLogUniform(const String_& name, double lo, double hi, const Vector_<>& f);
+
+        /*
+         * a lookup table in front of base: base is sampled at size points equally spaced on [lo, hi],
+         * and queries in that range are linearly interpolated between the samples, others go to base
+         * the error in range is that of linear interpolation at spacing (hi - lo) / (size - 1)
+         */
+        Interp1_* NewTable(const String_& name, const Handle_<Interp1_>& base, double lo, double hi, int size);
+    } // namespace Interp
+} // namespace Dal
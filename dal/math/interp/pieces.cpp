@@ -0,0 +1,142 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <algorithm>
+#include <dal/math/interp/pieces.hpp>
+#include <dal/platform/simd.hpp>
+#include <dal/utilities/algorithms.hpp>
+#if DAL_SIMD_X86
+#include <immintrin.h>
+#endif
+#include <dal/platform/strict.hpp>
+
+namespace Dal::Interp {
+    namespace {
+        /*
+         * Horner's rule for queries [0, m); row s of the pieces starts at p + s * ld, with degree + 2 entries
+         * the vector versions require m to be a multiple of their width
+         */
+        void PiecesScalar(int m, const double* x, const int* seg, const double* p, int ld, int degree, double* out) {
+            for (int k = 0; k < m; ++k) {
+                const double* row = p + static_cast<ptrdiff_t>(seg[k]) * ld;
+                const double t = x[k] - row[0];
+                double v = row[degree + 1];
+                for (int q = degree; q > 0; --q)
+                    v = v * t + row[q];
+                out[k] = v;
+            }
+        }
+
+#if DAL_SIMD_X86
+        DAL_TARGET_AVX2 void PiecesAvx2(int m, const double* x, const int* seg, const double* p, int ld, int degree,
+                                        double* out) {
+            const __m128i stride = _mm_set1_epi32(ld);
+            for (int k = 0; k < m; k += 4) {
+                const __m128i offsets =
+                    _mm_mullo_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(seg + k)), stride);
+                const __m256d t = _mm256_sub_pd(_mm256_loadu_pd(x + k), _mm256_i32gather_pd(p, offsets, 8));
+                __m256d v = _mm256_i32gather_pd(p + degree + 1, offsets, 8);
+                for (int q = degree; q > 0; --q)
+                    v = _mm256_fmadd_pd(v, t, _mm256_i32gather_pd(p + q, offsets, 8));
+                _mm256_storeu_pd(out + k, v);
+            }
+        }
+
+        DAL_TARGET_AVX512 void PiecesAvx512(int m, const double* x, const int* seg, const double* p, int ld,
+                                            int degree, double* out) {
+            const __m256i stride = _mm256_set1_epi32(ld);
+            for (int k = 0; k < m; k += 8) {
+                const __m256i offsets =
+                    _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(seg + k)), stride);
+                const __m512d t = _mm512_sub_pd(_mm512_loadu_pd(x + k), _mm512_i32gather_pd(offsets, p, 8));
+                __m512d v = _mm512_i32gather_pd(offsets, p + degree + 1, 8);
+                for (int q = degree; q > 0; --q)
+                    v = _mm512_fmadd_pd(v, t, _mm512_i32gather_pd(offsets, p + q, 8));
+                _mm512_storeu_pd(out + k, v);
+            }
+        }
+#endif
+    } // namespace
+
+    void Locate(const Vector_<>& knots, const Vector_<>& xs, Vector_<int>* index) {
+        const int n = knots.size();
+        index->Resize(xs.size());
+        const double* kn = knots.empty() ? nullptr : &knots[0];
+        int j = 0; // the previous answer
+        for (int k = 0; k < xs.size(); ++k) {
+            const double x = xs[k];
+            if (j < n && kn[j] < x) {
+                // gallop right while knots[lo] < x, then bisect (lo, hi)
+                int lo = j, step = 1, hi = j + 1;
+                while (hi < n && kn[hi] < x) {
+                    lo = hi;
+                    step *= 2;
+                    hi = lo + step;
+                }
+                hi = Min(hi, n);
+                j = static_cast<int>(std::lower_bound(kn + lo + 1, kn + hi, x) - kn);
+            } else if (j > 0 && kn[j - 1] >= x) {
+                // gallop left while knots[hi] >= x
+                int hi = j - 1, step = 1, lo = j - 2;
+                while (lo >= 0 && kn[lo] >= x) {
+                    hi = lo;
+                    step *= 2;
+                    lo = hi - step;
+                }
+                lo = Max(lo, -1);
+                j = static_cast<int>(std::lower_bound(kn + lo + 1, kn + hi, x) - kn);
+            }
+            (*index)[k] = j;
+        }
+    }
+
+    void EvaluatePieces(const Matrix_<>& pieces, const Vector_<>& xs, const Vector_<int>& segment, Vector_<>* out) {
+        REQUIRE(out && out != &xs, "Output should be distinct from the queries");
+        REQUIRE(segment.size() == xs.size(), "Need one segment per query");
+        REQUIRE(pieces.Cols() >= 2, "Pieces need a left end and at least one coefficient");
+        const int m = xs.size(), degree = pieces.Cols() - 2, ld = pieces.Stride();
+        out->Resize(m);
+        if (m == 0)
+            return;
+        const double* x = &xs[0];
+        const int* seg = &segment[0];
+        double* dst = &(*out)[0];
+        int v = 0;
+#if DAL_SIMD_X86
+        v = DispatchHead(
+            m, [&](int w) { PiecesAvx512(w, x, seg, pieces.Data(), ld, degree, dst); },
+            [&](int w) { PiecesAvx2(w, x, seg, pieces.Data(), ld, degree, dst); });
+#endif
+        if (v < m)
+            PiecesScalar(m - v, x + v, seg + v, pieces.Data(), ld, degree, dst + v);
+    }
+
+    Matrix_<> LinearPieces(const Vector_<>& x, const Vector_<>& f) {
+        const int n = x.size();
+        Matrix_<> ret_val(n + 1, 3);
+        for (int s = 0; s <= n; ++s) {
+            const int left = Max(0, Min(s - 1, n - 1));
+            ret_val(s, 0) = x.empty() ? 0.0 : x[left];
+            ret_val(s, 1) = x.empty() ? 0.0 : f[left];
+            ret_val(s, 2) = s > 0 && s < n && x[s] > x[s - 1] ? (f[s] - f[s - 1]) / (x[s] - x[s - 1]) : 0.0;
+        }
+        return ret_val;
+    }
+
+    // splint's formula expanded in t = x - x_i, for the segment [x_i, x_{i+1}]
+    Matrix_<> CubicPieces(const Vector_<>& x, const Vector_<>& f, const Vector_<>& fpp) {
+        const int n = x.size();
+        Matrix_<> ret_val(n + 1, 5);
+        for (int s = 0; s <= n && n > 1; ++s) {
+            const int i = Max(0, Min(s - 1, n - 2));
+            const double h = x[i + 1] - x[i];
+            ret_val(s, 0) = x[i];
+            ret_val(s, 1) = f[i];
+            ret_val(s, 2) = (f[i + 1] - f[i]) / h - h * (2.0 * fpp[i] + fpp[i + 1]) / 6.0;
+            ret_val(s, 3) = 0.5 * fpp[i];
+            ret_val(s, 4) = (fpp[i + 1] - fpp[i]) / (6.0 * h);
+        }
+        return ret_val;
+    }
+} // namespace Dal::Interp
@@ -0,0 +1,35 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+
+/*
+ * Batch evaluation of piecewise polynomials, shared by the one-dimensional interpolators
+ * locating all queries first leaves a branch-free loop over the pieces, vectorised with gathers
+ */
+
+namespace Dal {
+    namespace Interp {
+        /*
+         * index[k] is the position LowerBound(knots, xs[k]) would give
+         * each search hunts outwards from the previous answer: sorted queries cost O(n + m) in all,
+         * nearly sorted ones little more, and unsorted ones O(log n) each
+         */
+        void Locate(const Vector_<>& knots, const Vector_<>& xs, Vector_<int>* index);
+
+        /*
+         * each row of pieces is (x_left, c_0, ..., c_d), so that on row s the polynomial is sum_p c_p (x - x_left)^p
+         * out[k] is the polynomial of row segment[k] at xs[k]; out may not be &xs
+         */
+        void EvaluatePieces(const Matrix_<>& pieces, const Vector_<>& xs, const Vector_<int>& segment, Vector_<>* out);
+
+        // linear interpolation of f on knots x, flat beyond the ends; row s is the piece that Locate maps to s
+        Matrix_<> LinearPieces(const Vector_<>& x, const Vector_<>& f);
+        // the cubic spline with second derivatives fpp, indexed likewise; the end cubics extend beyond the knots
+        Matrix_<> CubicPieces(const Vector_<>& x, const Vector_<>& f, const Vector_<>& fpp);
+    } // namespace Interp
+} // namespace Dal
@@ -6,10 +6,13 @@
 #include <dal/math/matrix/banded.hpp>
 #include <dal/platform/strict.hpp>
 #include <cmath>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/matrixarithmetic.hpp>
 #include <dal/math/matrix/sparse.hpp>
 #include <dal/math/matrix/squarematrix.hpp>
 #include <dal/utilities/algorithms.hpp>
 #include <dal/utilities/numerics.hpp>
+#include <mutex>
 
 namespace Dal {
     namespace {
@@ -24,7 +27,7 @@ namespace Dal {
             for (auto px = x.begin() + 1, pa = above.begin(); pa != above.end(); ++px, ++pa, ++pr)
                 *pr += *px * *pa;
             pr = r->begin() + 1;
-            for (auto px = x.begin(), pb = below.begin(); px != below.end(); ++px, ++pb, ++pr)
+            for (auto px = x.begin(), pb = below.begin(); pb != below.end(); ++px, ++pb, ++pr)
                 *pr += *px * *pb;
         }
 
@@ -58,6 +61,20 @@ namespace Dal {
                 (*x)[j - 1] -= below[j - 1] * beta_inv[j - 1] * (*x)[j];
         }
 
+        // TriSolve for all columns of bx at once, each step of the sweep updating a whole row
+        void TriSolveRows(const Vector_<>& above, const Vector_<>& below, const Vector_<>& beta_inv, Matrix_<>* bx) {
+            const int n = beta_inv.size();
+            const int m = bx->Cols();
+            REQUIRE(bx->Rows() == n, "Size must be compatible");
+            Blas::Scale(m, beta_inv[0], bx->Row(0).Data());
+            for (int j = 1; j < n; ++j) {
+                Blas::Axpy(m, -above[j - 1], bx->Row(j - 1).Data(), bx->Row(j).Data());
+                Blas::Scale(m, beta_inv[j], bx->Row(j).Data());
+            }
+            for (int j = n - 1; j > 0; --j)
+                Blas::Axpy(m, -below[j - 1] * beta_inv[j - 1], bx->Row(j).Data(), bx->Row(j - 1).Data());
+        }
+
         struct TriDecomp_ : SquareMatrixDecomposition_ {
             Vector_<> diag_, above_, below_;
             Vector_<> betaInv_;
@@ -82,6 +99,8 @@ namespace Dal {
                 REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
                 TriSolve(b, diag_, above_, below_, betaInv_, x);
             }
+            void XSolveLeftInPlace(Matrix_<>* bx) const override { TriSolveRows(below_, above_, betaInv_, bx); }
+            void XSolveRightInPlace(Matrix_<>* bx) const override { TriSolveRows(above_, below_, betaInv_, bx); }
         };
 
         // Simplified version for symmetric case
@@ -101,6 +120,8 @@ namespace Dal {
                 REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
                 TriSolve(b, diag_, above_, above_, betaInv_, x);
             }
+            void XSolveInPlace(Matrix_<>* bx) const override { TriSolveRows(above_, above_, betaInv_, bx); }
+            using Sparse::SymmetricDecomposition_::MakeCorrelated;
             Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
                                                      Vector_<>* correlated) const override {
                 THROW("Tri-diagonal correlation matrices are not supported");
@@ -192,6 +213,12 @@ namespace Dal {
 
         // first some free functions supporting implementation
 
+        // element (i, j) of band storage, which must be inside the band; a row of the band is contiguous
+        inline const double* BandAt(const BandElements_& val, int i, int j) {
+            return val.view_.Row(i).Data() + (j - i + val.nBelow_);
+        }
+        inline int NAbove(const BandElements_& val) { return val.view_.Cols() - val.nBelow_ - 1; }
+
         // left-multiplication
         template <bool transpose> void BandedMultiply(const BandElements_& val, const Vector_<>& x, Vector_<>* b) {
             REQUIRE(b != &x, "no aliasing here");
@@ -200,10 +227,12 @@ namespace Dal {
             b->Resize(n);
             b->Fill(0.0);
             for (int ii = 0; ii < n; ++ii) {
-                const int jStop = Min(n, ii + val.view_.Cols() - val.nBelow_);
-                for (int jj = Max(0, ii - val.nBelow_); jj < jStop; ++jj) {
-                    (*b)[transpose ? jj : ii] += x[transpose ? ii : jj] * val(ii, jj);
-                }
+                const int jStart = Max(0, ii - val.nBelow_);
+                const int jStop = Min(n, ii + NAbove(val) + 1);
+                if (transpose)
+                    Blas::Axpy(jStop - jStart, x[ii], BandAt(val, ii, jStart), &(*b)[jStart]);
+                else
+                    (*b)[ii] = Blas::Dot(jStop - jStart, BandAt(val, ii, jStart), &x[jStart]);
             }
         }
 
@@ -214,58 +243,201 @@ namespace Dal {
             REQUIRE(val.view_.Rows() == n, "Size should be compatible with b and the matrix");
             x->Resize(n);
             for (int ii = 0; ii < n; ++ii) {
-                double residual = b[ii];
-                for (int jj = Max(0, ii - val.nBelow_); jj < ii; ++jj)
-                    residual -= (*x)[jj] * val(ii, jj);
+                const int jStart = Max(0, ii - val.nBelow_);
+                const double residual = b[ii] - Blas::Dot(ii - jStart, BandAt(val, ii, jStart), &(*x)[jStart]);
                 REQUIRE(!IsZero(val(ii, ii)), "Overflow in banded L-solve");
                 (*x)[ii] = residual / val(ii, ii);
             }
         }
 
-        // this works even if x == &b
+        // this works even if x == &b; column-oriented, so that the updates run along rows of the band
         void BandedLTransposeSolve(const BandElements_& val, const Vector_<>& b, Vector_<>* x) {
             REQUIRE(val.view_.Cols() == val.nBelow_ + 1, "n_below and cols are not matched");
             const int n = b.size();
             REQUIRE(val.view_.Rows() == n, "Size should be compatible with b and the matrix");
-            x->Resize(n);
+            if (x != &b)
+                *x = b;
             for (int ii = n - 1; ii >= 0; --ii) {
-                double residual = b[ii];
-                for (int jj = Max(n - 1, ii + val.nBelow_); jj > ii; --jj)
-                    residual -= (*x)[jj] * val(jj, ii);
                 REQUIRE(!IsZero(val(ii, ii)), "Overflow in banded L-solve");
-                (*x)[ii] = residual / val(ii, ii);
+                (*x)[ii] /= val(ii, ii);
+                const int jStart = Max(0, ii - val.nBelow_);
+                Blas::Axpy(ii - jStart, -(*x)[ii], BandAt(val, ii, jStart), &(*x)[jStart]);
             }
         }
 
-        // decomposition
-        class BandedCholesky_ : public Sparse::SymmetricDecomposition_ {
-            BandElements_ val_;
+        // many right-hand sides, one per column of bx: each step subtracts whole rows
+        void BandedLSolveRows(const BandElements_& val, Matrix_<>* bx) {
+            REQUIRE(val.view_.Cols() == val.nBelow_ + 1, "n_below and cols are not matched");
+            const int n = bx->Rows();
+            const int m = bx->Cols();
+            REQUIRE(val.view_.Rows() == n, "Size should be compatible with b and the matrix");
+            for (int ii = 0; ii < n; ++ii) {
+                double* xi = bx->Row(ii).Data();
+                for (int jj = Max(0, ii - val.nBelow_); jj < ii; ++jj)
+                    Blas::Axpy(m, -val(ii, jj), bx->Row(jj).Data(), xi);
+                REQUIRE(!IsZero(val(ii, ii)), "Overflow in banded L-solve");
+                Blas::Scale(m, 1.0 / val(ii, ii), xi);
+            }
+        }
 
-        public:
-            explicit BandedCholesky_(const BandElements_& llt) : val_(llt.view_.Rows(), llt.nBelow_, 0) {
-                static const double SMALL = 1.0e-11;
-                REQUIRE(llt.view_.Cols() == 2 * llt.nBelow_ + 1, "Cols should be 2 * n_below + 1");
-                const int n = llt.view_.Rows();
-                for (int ii = 0; ii < n; ++ii) {
-                    const int iMin = Max(0, ii - llt.nBelow_);
-                    for (int jj = iMin; jj <= ii; ++jj) {
-                        double residual = llt(ii, jj);
-                        for (int kk = iMin; kk < jj; ++kk)
-                            residual -= val_(ii, kk) * val_(jj, kk);
-                        if (jj < ii) {
-                            if (IsZero(residual))
-                                val_.At(ii, jj) = 0.0;
-                            else {
-                                REQUIRE(!IsZero(val_(jj, jj)), "Overflow");
-                                val_.At(ii, jj) = residual / val_(jj, jj);
-                            }
-                        } else {
-                            REQUIRE(residual > -SMALL, "Non-positive-definite matrix");
-                            val_.At(ii, ii) = std::sqrt(residual);
+        void BandedLTransposeSolveRows(const BandElements_& val, Matrix_<>* bx) {
+            REQUIRE(val.view_.Cols() == val.nBelow_ + 1, "n_below and cols are not matched");
+            const int n = bx->Rows();
+            const int m = bx->Cols();
+            REQUIRE(val.view_.Rows() == n, "Size should be compatible with b and the matrix");
+            for (int ii = n - 1; ii >= 0; --ii) {
+                double* xi = bx->Row(ii).Data();
+                for (int jj = Min(n - 1, ii + val.nBelow_); jj > ii; --jj)
+                    Blas::Axpy(m, -val(jj, ii), bx->Row(jj).Data(), xi);
+                REQUIRE(!IsZero(val(ii, ii)), "Overflow in banded L-solve");
+                Blas::Scale(m, 1.0 / val(ii, ii), xi);
+            }
+        }
+
+        // A = L L^T into l (n_below + 1 columns); the inner products run along rows of the band
+        void BandedCholeskyFactor(const BandElements_& a, BandElements_* l) {
+            static const double SMALL = 1.0e-11;
+            const int n = a.view_.Rows();
+            const int nBelow = l->nBelow_;
+            REQUIRE(l->view_.Rows() == n && l->view_.Cols() == nBelow + 1, "Cholesky factor has the wrong shape");
+            for (int ii = 0; ii < n; ++ii) {
+                const int iMin = Max(0, ii - nBelow);
+                for (int jj = iMin; jj <= ii; ++jj) {
+                    const double residual = a(ii, jj) - Blas::Dot(jj - iMin, BandAt(*l, ii, iMin), BandAt(*l, jj, iMin));
+                    if (jj < ii) {
+                        if (IsZero(residual))
+                            l->At(ii, jj) = 0.0;
+                        else {
+                            REQUIRE(!IsZero((*l)(jj, jj)), "Overflow");
+                            l->At(ii, jj) = residual / (*l)(jj, jj);
                         }
+                    } else {
+                        REQUIRE(residual > -SMALL, "Non-positive-definite matrix");
+                        l->At(ii, ii) = std::sqrt(Max(0.0, residual));
                     }
                 }
             }
+        }
+
+        /*
+         * A = L U without pivoting (so A should be e.g. diagonally dominant, as PDE operators are), into lu
+         * which has the shape of a: L has unit diagonal and sits below it, U on and above
+         * each elimination step is one axpy along the upper band
+         */
+        void BandedLUFactor(const BandElements_& a, BandElements_* lu) {
+            REQUIRE(lu->view_.Cols() == a.view_.Cols() && lu->nBelow_ == a.nBelow_, "LU factor has the wrong shape");
+            lu->store_ = a.view_;
+            const int n = a.view_.Rows();
+            const int nBelow = a.nBelow_, nAbove = NAbove(a);
+            for (int kk = 0; kk < n; ++kk) {
+                double* rk = lu->store_.Row(kk).Data();
+                const double pivot = rk[nBelow];
+                REQUIRE(!IsZero(pivot), "Banded LU decomposition failed: zero pivot");
+                const int len = Min(n - 1, kk + nAbove) - kk;
+                for (int ii = kk + 1; ii <= Min(n - 1, kk + nBelow); ++ii) {
+                    double* ri = lu->store_.Row(ii).Data() + (kk - ii + nBelow);
+                    const double l = (*ri /= pivot);
+                    if (l != 0.0)
+                        Blas::Axpy(len, -l, rk + nBelow + 1, ri + 1);
+                }
+            }
+        }
+
+        // (LU)^{-1} x in place
+        void BandedLUSolve(const BandElements_& lu, Vector_<>* x) {
+            const int n = x->size();
+            const int nAbove = NAbove(lu);
+            double* px = &(*x)[0];
+            for (int ii = 0; ii < n; ++ii) {
+                const int jStart = Max(0, ii - lu.nBelow_);
+                px[ii] -= Blas::Dot(ii - jStart, BandAt(lu, ii, jStart), px + jStart);
+            }
+            for (int ii = n - 1; ii >= 0; --ii) {
+                const int len = Min(n - 1, ii + nAbove) - ii;
+                px[ii] = (px[ii] - Blas::Dot(len, BandAt(lu, ii, ii) + 1, px + ii + 1)) / *BandAt(lu, ii, ii);
+            }
+        }
+
+        // (LU)^{-T} x in place
+        void BandedLUTransposeSolve(const BandElements_& lu, Vector_<>* x) {
+            const int n = x->size();
+            const int nAbove = NAbove(lu);
+            double* px = &(*x)[0];
+            for (int ii = 0; ii < n; ++ii) {
+                px[ii] /= *BandAt(lu, ii, ii);
+                Blas::Axpy(Min(n - 1, ii + nAbove) - ii, -px[ii], BandAt(lu, ii, ii) + 1, px + ii + 1);
+            }
+            for (int ii = n - 1; ii >= 0; --ii) {
+                const int jStart = Max(0, ii - lu.nBelow_);
+                Blas::Axpy(ii - jStart, -px[ii], BandAt(lu, ii, jStart), px + jStart);
+            }
+        }
+
+        void BandedLUSolveRows(const BandElements_& lu, Matrix_<>* bx) {
+            const int n = bx->Rows();
+            const int m = bx->Cols();
+            const int nAbove = NAbove(lu);
+            REQUIRE(lu.view_.Rows() == n, "Size should be compatible with b and the matrix");
+            for (int ii = 0; ii < n; ++ii)
+                for (int jj = Max(0, ii - lu.nBelow_); jj < ii; ++jj)
+                    Blas::Axpy(m, -*BandAt(lu, ii, jj), bx->Row(jj).Data(), bx->Row(ii).Data());
+            for (int ii = n - 1; ii >= 0; --ii) {
+                double* xi = bx->Row(ii).Data();
+                for (int jj = ii + 1; jj <= Min(n - 1, ii + nAbove); ++jj)
+                    Blas::Axpy(m, -*BandAt(lu, ii, jj), bx->Row(jj).Data(), xi);
+                Blas::Scale(m, 1.0 / *BandAt(lu, ii, ii), xi);
+            }
+        }
+
+        void BandedLUTransposeSolveRows(const BandElements_& lu, Matrix_<>* bx) {
+            const int n = bx->Rows();
+            const int m = bx->Cols();
+            const int nAbove = NAbove(lu);
+            REQUIRE(lu.view_.Rows() == n, "Size should be compatible with b and the matrix");
+            for (int ii = 0; ii < n; ++ii) {
+                const double* xi = bx->Row(ii).Data();
+                Blas::Scale(m, 1.0 / *BandAt(lu, ii, ii), bx->Row(ii).Data());
+                for (int jj = ii + 1; jj <= Min(n - 1, ii + nAbove); ++jj)
+                    Blas::Axpy(m, -*BandAt(lu, ii, jj), xi, bx->Row(jj).Data());
+            }
+            for (int ii = n - 1; ii >= 0; --ii)
+                for (int jj = Max(0, ii - lu.nBelow_); jj < ii; ++jj)
+                    Blas::Axpy(m, -*BandAt(lu, ii, jj), bx->Row(ii).Data(), bx->Row(jj).Data());
+        }
+
+        // b = L U x, or b = (LU)^T x if transpose
+        template <bool transpose> void BandedLUMultiply(const BandElements_& lu, const Vector_<>& x, Vector_<>* b) {
+            const int n = x.size();
+            const int nAbove = NAbove(lu);
+            Vector_<> z(n, 0.0);
+            b->Resize(n);
+            if (transpose) {
+                z = x; // L^T x, then U^T
+                for (int ii = 0; ii < n; ++ii) {
+                    const int jStart = Max(0, ii - lu.nBelow_);
+                    Blas::Axpy(ii - jStart, x[ii], BandAt(lu, ii, jStart), &z[jStart]);
+                }
+                b->Fill(0.0);
+                for (int ii = 0; ii < n; ++ii)
+                    Blas::Axpy(Min(n - 1, ii + nAbove) - ii + 1, z[ii], BandAt(lu, ii, ii), &(*b)[ii]);
+            } else {
+                for (int ii = 0; ii < n; ++ii)
+                    z[ii] = Blas::Dot(Min(n - 1, ii + nAbove) - ii + 1, BandAt(lu, ii, ii), &x[ii]);
+                for (int ii = 0; ii < n; ++ii) {
+                    const int jStart = Max(0, ii - lu.nBelow_);
+                    (*b)[ii] = z[ii] + Blas::Dot(ii - jStart, BandAt(lu, ii, jStart), &z[jStart]);
+                }
+            }
+        }
+
+        // decompositions, sharing factors which the matrix caches
+
+        class BandedCholesky_ : public Sparse::SymmetricDecomposition_ {
+            std::shared_ptr<const BandElements_> l_;
+            const BandElements_& val_;
+
+        public:
+            explicit BandedCholesky_(const std::shared_ptr<const BandElements_>& l) : l_(l), val_(*l) {}
 
             int Size() const override { return val_.view_.Rows(); }
 
@@ -280,6 +452,12 @@ namespace Dal {
                 BandedLTransposeSolve(val_, *x, x);
             }
 
+            void XSolveInPlace(Matrix_<>* bx) const override {
+                BandedLSolveRows(val_, bx);
+                BandedLTransposeSolveRows(val_, bx);
+            }
+
+            using Sparse::SymmetricDecomposition_::MakeCorrelated;
             Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
                                                      Vector_<>* correlated) const override {
                 const int n = Size();
@@ -296,25 +474,58 @@ namespace Dal {
 
             void QForm(const Matrix_<>& j_mat, SquareMatrix_<>* form) const override {
                 REQUIRE(j_mat.Cols() == Size(), "j_mat size should match with this matrix's size");
-                Vector_<Vector_<>> temp(j_mat.Rows());
+                // W = L^{-1} J^T in one sweep, then J A^{-1} J^T = W^T W
+                Matrix_<> w(Size(), j_mat.Rows());
+                for (int ii = 0; ii < j_mat.Rows(); ++ii)
+                    std::copy(j_mat[ii].begin(), j_mat[ii].end(), w.Col(ii).begin());
+                BandedLSolveRows(val_, &w);
+                Matrix_<> wtw;
+                Matrix::MultiplyTransposed(w, w, &wtw);
 
-                // compute L^{-1}
-                for (int ii = 0; ii < j_mat.Rows(); ++ii) {
-                    temp[ii].Resize(Size());
-                    Copy(j_mat[ii], &temp[ii]);
-                    BandedLSolve(val_, temp[ii], &temp[ii]);
-                }
-
-                // compute result
                 form->Resize(j_mat.Rows());
                 for (int io = 0; io < j_mat.Rows(); ++io)
                     for (int k = 0; k <= io; ++k)
-                        (*form)(io, k) = (*form)(k, io) = InnerProduct(temp[io], temp[k]);
+                        (*form)(io, k) = (*form)(k, io) = wtw(io, k);
+            }
+        };
+
+        class BandedLU_ : public SquareMatrixDecomposition_ {
+            std::shared_ptr<const BandElements_> lu_;
+            const BandElements_& val_;
+
+        public:
+            explicit BandedLU_(const std::shared_ptr<const BandElements_>& lu) : lu_(lu), val_(*lu) {}
+
+            int Size() const override { return val_.view_.Rows(); }
+            void XMultiplyLeft_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                BandedLUMultiply<false>(val_, x, b);
+            }
+            void XMultiplyRight_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                BandedLUMultiply<true>(val_, x, b);
+            }
+            void XSolveLeft_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                *x = b;
+                BandedLUSolve(val_, x);
+            }
+            void XSolveRight_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                *x = b;
+                BandedLUTransposeSolve(val_, x);
             }
+            void XSolveLeftInPlace(Matrix_<>* bx) const override { BandedLUSolveRows(val_, bx); }
+            void XSolveRightInPlace(Matrix_<>* bx) const override { BandedLUTransposeSolveRows(val_, bx); }
         };
 
         class Banded_ : public Sparse::Square_ {
             BandElements_ val_;
+            // factors of val_, shared with the decompositions handed out; refactored in place once those are released
+            mutable std::mutex factorMutex_;
+            mutable std::shared_ptr<BandElements_> factor_;
+            mutable bool factorIsCholesky_ = false;
+            mutable bool factorIsStale_ = true;
 
         public:
             Banded_(int size, int n_above, int n_below) : val_(size, n_above, n_below) {}
@@ -328,20 +539,42 @@ namespace Dal {
                 const int n = Size();
                 const int width = Max(val_.nBelow_, val_.view_.Cols() - val_.nBelow_ - 1);
                 for (int ii = 0; ii < n; ++ii) {
-                    for (int jj = Max(0, ii - width); jj <= Max(n - 1, ii + width); ++jj)
+                    for (int jj = Max(0, ii - width); jj <= Min(n - 1, ii + width); ++jj)
                         if (!IsZero(val_(ii, jj) - val_(jj, ii)))
                             return false;
                 }
                 return true;
             }
+
+            // Cholesky if symmetric, otherwise LU; factorised only when the coefficients have changed
             SquareMatrixDecomposition_* Decompose() const override {
-                REQUIRE(IsSymmetric(), "Cholesky decomposition requires a symmetric matrix");
-                return new BandedCholesky_(val_);
+                std::lock_guard<std::mutex> lock(factorMutex_);
+                if (factorIsStale_ || !factor_) {
+                    const bool cholesky = IsSymmetric();
+                    const int cols = cholesky ? val_.nBelow_ + 1 : val_.view_.Cols();
+                    if (!factor_ || factor_.use_count() > 1 || factor_->view_.Cols() != cols)
+                        factor_ = std::make_shared<BandElements_>(Size(), cols - val_.nBelow_ - 1, val_.nBelow_);
+                    if (cholesky)
+                        BandedCholeskyFactor(val_, factor_.get());
+                    else
+                        BandedLUFactor(val_, factor_.get());
+                    factorIsCholesky_ = cholesky;
+                    factorIsStale_ = false;
+                }
+                if (factorIsCholesky_)
+                    return new BandedCholesky_(factor_);
+                return new BandedLU_(factor_);
             }
 
             const double& operator()(int row, int col) const override { return val_(row, col); }
-            void Set(int row, int col, double val) override { val_.At(row, col) = val; }
-            void Add(int row, int col, double val) override { val_.At(row, col) += val; }
+            void Set(int row, int col, double val) override {
+                val_.At(row, col) = val;
+                factorIsStale_ = true;
+            }
+            void Add(int row, int col, double val) override {
+                val_.At(row, col) += val;
+                factorIsStale_ = true;
+            }
         };
     } // namespace
 
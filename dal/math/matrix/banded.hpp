@@ -10,6 +10,11 @@
 namespace Dal {
     namespace Sparse {
         class Square_;
+        /*
+         * Decompose() gives Cholesky factors if the matrix is symmetric, otherwise LU factors without pivoting
+         * the factors are cached against the matrix: repeated calls share them until Set or Add changes a coefficient,
+         * and are then recomputed in place if no earlier decomposition still holds them
+         */
         Square_* NewBandDiagonal(int size, int n_above, int n_below);
     } // namespace Sparse
 
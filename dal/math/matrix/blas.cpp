@@ -0,0 +1,378 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <algorithm>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/platform/aligned.hpp>
+#include <dal/platform/simd.hpp>
+#include <vector>
+#if DAL_SIMD_X86
+#include <immintrin.h>
+#endif
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace Blas {
+        namespace {
+            using buffer_t = std::vector<double, AlignedAllocator_<double>>;
+
+            // blocking: an MC x KC panel of A stays in L2, a KC x NR sliver of B in L1
+            constexpr int MC = 96;
+            constexpr int KC = 256;
+            constexpr int NC = 2048;
+            // below this many multiply-adds packing does not pay
+            constexpr double SMALL_GEMM = 32.0 * 32.0 * 32.0;
+            // diagonal block size of the triangular solves
+            constexpr int TRSM_BLOCK = 64;
+
+            double DotScalar(int n, const double* x, const double* y) {
+                double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                int i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    s0 += x[i] * y[i];
+                    s1 += x[i + 1] * y[i + 1];
+                    s2 += x[i + 2] * y[i + 2];
+                    s3 += x[i + 3] * y[i + 3];
+                }
+                for (; i < n; ++i)
+                    s0 += x[i] * y[i];
+                return (s0 + s1) + (s2 + s3);
+            }
+
+            void AxpyScalar(int n, double alpha, const double* x, double* y) {
+                for (int i = 0; i < n; ++i)
+                    y[i] += alpha * x[i];
+            }
+
+            // adds the valid mv x nv corner of an accumulated block t (row length nr) to C
+            void AddEdge(const double* t, int nr, double* c, ptrdiff_t ldc, int mv, int nv) {
+                for (int i = 0; i < mv; ++i)
+                    for (int j = 0; j < nv; ++j)
+                        c[i * ldc + j] += t[i * nr + j];
+            }
+
+            /*
+             * Micro-kernels: C[mr x nr] += packed A sliver (kc x mr) times packed B sliver (kc x nr)
+             * only the top-left mv x nv corner of the block is written back
+             */
+
+            void KernelScalar(int kc, const double* a, const double* b, double* c, ptrdiff_t ldc, int mv, int nv) {
+                double t[4 * 4] = {};
+                for (int p = 0; p < kc; ++p, a += 4, b += 4)
+                    for (int i = 0; i < 4; ++i)
+                        for (int j = 0; j < 4; ++j)
+                            t[i * 4 + j] += a[i] * b[j];
+                AddEdge(t, 4, c, ldc, mv, nv);
+            }
+
+#if DAL_SIMD_X86
+            DAL_TARGET_AVX2 double DotAvx2(int n, const double* x, const double* y) {
+                __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+                __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+                int i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+                    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+                    s2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), s2);
+                    s3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), s3);
+                }
+                for (; i + 4 <= n; i += 4)
+                    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+                const __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+                const __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+                double ret_val = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+                for (; i < n; ++i)
+                    ret_val += x[i] * y[i];
+                return ret_val;
+            }
+
+            DAL_TARGET_AVX2 void AxpyAvx2(int n, double alpha, const double* x, double* y) {
+                const __m256d a = _mm256_set1_pd(alpha);
+                int i = 0;
+                for (; i + 4 <= n; i += 4)
+                    _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+                for (; i < n; ++i)
+                    y[i] += alpha * x[i];
+            }
+
+            // 4 x 8 block in 8 ymm accumulators
+            DAL_TARGET_AVX2 void KernelAvx2(int kc, const double* a, const double* b, double* c, ptrdiff_t ldc, int mv, int nv) {
+                __m256d acc[4][2];
+#pragma GCC unroll 4
+                for (int i = 0; i < 4; ++i)
+                    acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+                for (int p = 0; p < kc; ++p, a += 4, b += 8) {
+                    const __m256d b0 = _mm256_loadu_pd(b);
+                    const __m256d b1 = _mm256_loadu_pd(b + 4);
+#pragma GCC unroll 4
+                    for (int i = 0; i < 4; ++i) {
+                        const __m256d ai = _mm256_broadcast_sd(a + i);
+                        acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                        acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+                    }
+                }
+                if (mv == 4 && nv == 8) {
+#pragma GCC unroll 4
+                    for (int i = 0; i < 4; ++i) {
+                        double* ci = c + i * ldc;
+                        _mm256_storeu_pd(ci, _mm256_add_pd(_mm256_loadu_pd(ci), acc[i][0]));
+                        _mm256_storeu_pd(ci + 4, _mm256_add_pd(_mm256_loadu_pd(ci + 4), acc[i][1]));
+                    }
+                } else {
+                    alignas(32) double t[4 * 8];
+                    for (int i = 0; i < 4; ++i) {
+                        _mm256_store_pd(t + i * 8, acc[i][0]);
+                        _mm256_store_pd(t + i * 8 + 4, acc[i][1]);
+                    }
+                    AddEdge(t, 8, c, ldc, mv, nv);
+                }
+            }
+
+            DAL_TARGET_AVX512 double DotAvx512(int n, const double* x, const double* y) {
+                __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+                int i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+                    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), s1);
+                }
+                for (; i + 8 <= n; i += 8)
+                    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+                double ret_val = _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+                for (; i < n; ++i)
+                    ret_val += x[i] * y[i];
+                return ret_val;
+            }
+
+            DAL_TARGET_AVX512 void AxpyAvx512(int n, double alpha, const double* x, double* y) {
+                const __m512d a = _mm512_set1_pd(alpha);
+                int i = 0;
+                for (; i + 8 <= n; i += 8)
+                    _mm512_storeu_pd(y + i, _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+                for (; i < n; ++i)
+                    y[i] += alpha * x[i];
+            }
+
+            // 8 x 16 block in 16 zmm accumulators
+            DAL_TARGET_AVX512 void KernelAvx512(int kc, const double* a, const double* b, double* c, ptrdiff_t ldc, int mv, int nv) {
+                __m512d acc[8][2];
+#pragma GCC unroll 8
+                for (int i = 0; i < 8; ++i)
+                    acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+                for (int p = 0; p < kc; ++p, a += 8, b += 16) {
+                    const __m512d b0 = _mm512_loadu_pd(b);
+                    const __m512d b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+                    for (int i = 0; i < 8; ++i) {
+                        const __m512d ai = _mm512_set1_pd(a[i]);
+                        acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+                        acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+                    }
+                }
+                if (mv == 8 && nv == 16) {
+#pragma GCC unroll 8
+                    for (int i = 0; i < 8; ++i) {
+                        double* ci = c + i * ldc;
+                        _mm512_storeu_pd(ci, _mm512_add_pd(_mm512_loadu_pd(ci), acc[i][0]));
+                        _mm512_storeu_pd(ci + 8, _mm512_add_pd(_mm512_loadu_pd(ci + 8), acc[i][1]));
+                    }
+                } else {
+                    alignas(64) double t[8 * 16];
+                    for (int i = 0; i < 8; ++i) {
+                        _mm512_store_pd(t + i * 16, acc[i][0]);
+                        _mm512_store_pd(t + i * 16 + 8, acc[i][1]);
+                    }
+                    AddEdge(t, 16, c, ldc, mv, nv);
+                }
+            }
+#endif
+
+            struct Kernel_ {
+                int mr_;
+                int nr_;
+                void (*run_)(int kc, const double* a, const double* b, double* c, ptrdiff_t ldc, int mv, int nv);
+            };
+
+            const Kernel_& ActiveKernel() {
+                static const Kernel_ SCALAR = {4, 4, KernelScalar};
+#if DAL_SIMD_X86
+                static const Kernel_ AVX2 = {4, 8, KernelAvx2};
+                static const Kernel_ AVX512 = {8, 16, KernelAvx512};
+                switch (SimdLevel()) {
+                case SimdLevel_::AVX512:
+                    return AVX512;
+                case SimdLevel_::AVX2:
+                    return AVX2;
+                default:
+                    break;
+                }
+#endif
+                return SCALAR;
+            }
+
+            int RoundUp(int n, int step) { return (n + step - 1) / step * step; }
+
+            // alpha times the mc x kc block of A at (i0, p0), into slivers of mr rows, each stored column by column, zero-padded
+            void PackA(int mc, int kc, const Operand_& a, double alpha, int i0, int p0, int mr, double* dst) {
+                for (int ir = 0; ir < mc; ir += mr) {
+                    const int mv = std::min(mr, mc - ir);
+                    const double* src = a.p_ + (i0 + ir) * a.rs_ + p0 * a.cs_;
+                    for (int p = 0; p < kc; ++p, dst += mr) {
+                        const double* sp = src + p * a.cs_;
+                        for (int i = 0; i < mv; ++i)
+                            dst[i] = alpha * sp[i * a.rs_];
+                        std::fill(dst + mv, dst + mr, 0.0);
+                    }
+                }
+            }
+
+            // kc x nc block of B at (p0, j0) into slivers of nr columns, each stored row by row, zero-padded
+            void PackB(int kc, int nc, const Operand_& b, int p0, int j0, int nr, double* dst) {
+                for (int jr = 0; jr < nc; jr += nr) {
+                    const int nv = std::min(nr, nc - jr);
+                    const double* src = b.p_ + p0 * b.rs_ + (j0 + jr) * b.cs_;
+                    for (int p = 0; p < kc; ++p, dst += nr) {
+                        const double* sp = src + p * b.rs_;
+                        if (b.cs_ == 1)
+                            std::copy(sp, sp + nv, dst);
+                        else
+                            for (int j = 0; j < nv; ++j)
+                                dst[j] = sp[j * b.cs_];
+                        std::fill(dst + nv, dst + nr, 0.0);
+                    }
+                }
+            }
+
+            void GemmSmall(int m, int n, int k, const Operand_& a, const Operand_& b, double* c, ptrdiff_t ldc, double alpha) {
+                for (int i = 0; i < m; ++i) {
+                    double* ci = c + i * ldc;
+                    for (int p = 0; p < k; ++p) {
+                        const double aip = alpha * a.p_[i * a.rs_ + p * a.cs_];
+                        const double* bp = b.p_ + p * b.rs_;
+                        if (b.cs_ == 1)
+                            Axpy(n, aip, bp, ci);
+                        else
+                            for (int j = 0; j < n; ++j)
+                                ci[j] += aip * bp[j * b.cs_];
+                    }
+                }
+            }
+        } // namespace
+
+        double Dot(int n, const double* x, const double* y) {
+#if DAL_SIMD_X86
+            switch (SimdLevel()) {
+            case SimdLevel_::AVX512:
+                return DotAvx512(n, x, y);
+            case SimdLevel_::AVX2:
+                return DotAvx2(n, x, y);
+            default:
+                break;
+            }
+#endif
+            return DotScalar(n, x, y);
+        }
+
+        void Axpy(int n, double alpha, const double* x, double* y) {
+#if DAL_SIMD_X86
+            switch (SimdLevel()) {
+            case SimdLevel_::AVX512:
+                return AxpyAvx512(n, alpha, x, y);
+            case SimdLevel_::AVX2:
+                return AxpyAvx2(n, alpha, x, y);
+            default:
+                break;
+            }
+#endif
+            AxpyScalar(n, alpha, x, y);
+        }
+
+        void Scale(int n, double alpha, double* x) {
+            for (int i = 0; i < n; ++i)
+                x[i] *= alpha;
+        }
+
+        void Gemm(int m,
+                  int n,
+                  int k,
+                  const Operand_& a,
+                  const Operand_& b,
+                  double* c,
+                  ptrdiff_t ldc,
+                  double alpha,
+                  double beta,
+                  ThreadPool_* pool) {
+            if (beta != 1.0)
+                for (int i = 0; i < m; ++i) {
+                    if (beta == 0.0)
+                        std::fill(c + i * ldc, c + i * ldc + n, 0.0);
+                    else
+                        Scale(n, beta, c + i * ldc);
+                }
+            if (m <= 0 || n <= 0 || k <= 0 || alpha == 0.0)
+                return;
+            if (static_cast<double>(m) * n * k <= SMALL_GEMM) {
+                GemmSmall(m, n, k, a, b, c, ldc, alpha);
+                return;
+            }
+
+            const Kernel_& ker = ActiveKernel();
+            buffer_t bPack;
+            for (int jc = 0; jc < n; jc += NC) {
+                const int nc = std::min(NC, n - jc);
+                for (int pc = 0; pc < k; pc += KC) {
+                    const int kc = std::min(KC, k - pc);
+                    bPack.resize(static_cast<size_t>(RoundUp(nc, ker.nr_)) * kc);
+                    PackB(kc, nc, b, pc, jc, ker.nr_, bPack.data());
+
+                    // one MC-row block of C: pack its part of A, then sweep the B slivers
+                    auto block = [&](int ic) {
+                        static thread_local buffer_t aPack;
+                        const int mc = std::min(MC, m - ic);
+                        aPack.resize(static_cast<size_t>(RoundUp(mc, ker.mr_)) * kc);
+                        PackA(mc, kc, a, alpha, ic, pc, ker.mr_, aPack.data());
+                        for (int jr = 0; jr < nc; jr += ker.nr_)
+                            for (int ir = 0; ir < mc; ir += ker.mr_)
+                                ker.run_(kc, aPack.data() + ir * kc, bPack.data() + jr * kc, c + (ic + ir) * ldc + jc + jr,
+                                         ldc, std::min(ker.mr_, mc - ir), std::min(ker.nr_, nc - jr));
+                    };
+
+                    ParallelBlocks(pool, m, MC, [&block](int ic, int) { block(ic); });
+                }
+            }
+        }
+
+        void SolveLower(int n, int m, const Operand_& t, bool unit_diag, double* x, ptrdiff_t ldx) {
+            for (int i0 = 0; i0 < n; i0 += TRSM_BLOCK) {
+                const int i1 = std::min(n, i0 + TRSM_BLOCK);
+                // subtract the contribution of the rows already solved
+                if (i0 > 0)
+                    Gemm(i1 - i0, m, i0, {t.p_ + i0 * t.rs_, t.rs_, t.cs_}, {x, ldx, 1}, x + i0 * ldx, ldx, -1.0, 1.0);
+                for (int i = i0; i < i1; ++i) {
+                    double* xi = x + i * ldx;
+                    for (int k = i0; k < i; ++k)
+                        Axpy(m, -t.p_[i * t.rs_ + k * t.cs_], x + k * ldx, xi);
+                    if (!unit_diag)
+                        Scale(m, 1.0 / t.p_[i * (t.rs_ + t.cs_)], xi);
+                }
+            }
+        }
+
+        void SolveUpper(int n, int m, const Operand_& t, bool unit_diag, double* x, ptrdiff_t ldx) {
+            for (int i1 = n; i1 > 0; i1 -= TRSM_BLOCK) {
+                const int i0 = std::max(0, i1 - TRSM_BLOCK);
+                if (i1 < n)
+                    Gemm(i1 - i0, m, n - i1, {t.p_ + i0 * t.rs_ + i1 * t.cs_, t.rs_, t.cs_}, {x + i1 * ldx, ldx, 1},
+                         x + i0 * ldx, ldx, -1.0, 1.0);
+                for (int i = i1 - 1; i >= i0; --i) {
+                    double* xi = x + i * ldx;
+                    for (int k = i + 1; k < i1; ++k)
+                        Axpy(m, -t.p_[i * t.rs_ + k * t.cs_], x + k * ldx, xi);
+                    if (!unit_diag)
+                        Scale(m, 1.0 / t.p_[i * (t.rs_ + t.cs_)], xi);
+                }
+            }
+        }
+    } // namespace Blas
+} // namespace Dal
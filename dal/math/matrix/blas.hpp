@@ -0,0 +1,56 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <dal/platform/platform.hpp>
+
+/*
+ * Raw-pointer dense kernels, vectorised with runtime dispatch (see dal/platform/simd.hpp)
+ * the Matrix_ interface is in matrixarithmetic.hpp
+ */
+
+namespace Dal {
+    class ThreadPool_;
+
+    namespace Blas {
+        double Dot(int n, const double* x, const double* y);
+        // y += alpha * x
+        void Axpy(int n, double alpha, const double* x, double* y);
+        // x *= alpha
+        void Scale(int n, double alpha, double* x);
+
+        // read-only strided operand: element (i, j) is at p_[i * rs_ + j * cs_], so a transpose just swaps the strides
+        struct Operand_ {
+            const double* p_;
+            ptrdiff_t rs_;
+            ptrdiff_t cs_;
+        };
+
+        /*
+         * C = alpha * A * B + beta * C, with A m x k and B k x n
+         * C is row-major with leading dimension ldc and must not overlap A or B
+         * cache-blocked with packed panels; blocks of rows of C go to the pool if one is given
+         */
+        void Gemm(int m,
+                  int n,
+                  int k,
+                  const Operand_& a,
+                  const Operand_& b,
+                  double* c,
+                  ptrdiff_t ldc,
+                  double alpha = 1.0,
+                  double beta = 0.0,
+                  ThreadPool_* pool = nullptr);
+
+        /*
+         * In-place triangular solves with m right-hand sides: X (n x m, row-major, leading dimension ldx)
+         * is overwritten by T^{-1} X; only the lower (upper) triangle of T is read, with unit diagonal if unit_diag
+         * blocked, so that all but the diagonal blocks are handled by Gemm
+         */
+        void SolveLower(int n, int m, const Operand_& t, bool unit_diag, double* x, ptrdiff_t ldx);
+        void SolveUpper(int n, int m, const Operand_& t, bool unit_diag, double* x, ptrdiff_t ldx);
+    } // namespace Blas
+} // namespace Dal
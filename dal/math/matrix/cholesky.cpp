@@ -0,0 +1,164 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/cholesky.hpp>
+#include <dal/math/matrix/matrixarithmetic.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace {
+        // columns per panel; the update of the trailing matrix by each panel is one Gemm
+        constexpr int CHOLESKY_BLOCK = 64;
+
+        void SymmetricSwap(Matrix_<>* a, int i, int j) {
+            std::swap_ranges(a->Row(i).begin(), a->Row(i).end(), a->Row(j).begin());
+            for (int k = 0; k < a->Rows(); ++k)
+                std::swap((*a)(k, i), (*a)(k, j));
+        }
+
+        class Cholesky_ : public SymmetricMatrixDecomposition_ {
+            Matrix_<> l_;        // n x rank, lower triangular in pivoted order
+            Matrix_<> pl_;       // P L: the same rows, in the original order
+            Vector_<int> perm_;  // original index of each pivoted position
+            int rank_;
+
+            void XMultiply_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                Vector_<> z;
+                Matrix::Gemv(pl_, x, &z, true);
+                Matrix::Gemv(pl_, z, b);
+            }
+
+            void XSolve_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(rank_ == Size(), "Can't solve with a rank-deficient Cholesky decomposition");
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                const int n = Size();
+                Vector_<> y(n);
+                for (int i = 0; i < n; ++i)
+                    y[i] = b[perm_[i]];
+                // L u = y, row by row
+                for (int i = 0; i < n; ++i)
+                    y[i] = (y[i] - Blas::Dot(i, l_.Row(i).Data(), &y[0])) / l_(i, i);
+                // L^T v = u, column by column
+                for (int i = n - 1; i >= 0; --i) {
+                    y[i] /= l_(i, i);
+                    Blas::Axpy(i, -y[i], l_.Row(i).Data(), &y[0]);
+                }
+                x->Resize(n);
+                for (int i = 0; i < n; ++i)
+                    (*x)[perm_[i]] = y[i];
+            }
+
+            void XSolveInPlace(Matrix_<>* bx) const override {
+                REQUIRE(rank_ == Size(), "Can't solve with a rank-deficient Cholesky decomposition");
+                const int n = Size(), m = bx->Cols();
+                Matrix_<> y(n, m);
+                for (int i = 0; i < n; ++i)
+                    std::copy(bx->Row(perm_[i]).begin(), bx->Row(perm_[i]).end(), y.Row(i).begin());
+                Blas::SolveLower(n, m, {l_.Data(), l_.Stride(), 1}, false, y.Data(), y.Stride());
+                Blas::SolveUpper(n, m, {l_.Data(), 1, l_.Stride()}, false, y.Data(), y.Stride());
+                for (int i = 0; i < n; ++i)
+                    std::copy(y.Row(i).begin(), y.Row(i).end(), bx->Row(perm_[i]).begin());
+            }
+
+        public:
+            Cholesky_(const Matrix_<>& a, double tolerance);
+
+            int Size() const override { return static_cast<int>(perm_.size()); }
+            int Rank() const override { return rank_; }
+
+            Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
+                                                     Vector_<>* correlated) const override {
+                const int n = Size();
+                correlated->Resize(n);
+                if (rank_ == 0) {
+                    correlated->Fill(0.0);
+                    return iid_begin;
+                }
+                for (int i = 0; i < n; ++i)
+                    (*correlated)[i] = Blas::Dot(rank_, pl_.Row(i).Data(), &*iid_begin);
+                return iid_begin + rank_;
+            }
+
+            // correlated = iid * (P L)^T, one blocked multiply for all rows
+            void MakeCorrelated(const Matrix_<>& iid, Matrix_<>* correlated) const override {
+                REQUIRE(correlated && correlated != &iid, "Correlated output must be distinct from iid input");
+                REQUIRE(iid.Cols() >= rank_, "Too few iid draws per row");
+                correlated->Resize(iid.Rows(), Size());
+                Blas::Gemm(iid.Rows(), Size(), rank_, {iid.Data(), iid.Stride(), 1}, {pl_.Data(), 1, pl_.Stride()},
+                           correlated->Data(), correlated->Stride());
+            }
+        };
+
+        /*
+         * Right-looking blocked factorization
+         * within a panel the columns are computed left-looking, choosing as pivot the largest updated diagonal;
+         * then the trailing matrix is updated by one Gemm
+         */
+        Cholesky_::Cholesky_(const Matrix_<>& a, double tolerance) : l_(a), perm_(a.Rows()), rank_(0) {
+            const int n = a.Rows();
+            REQUIRE(a.Cols() == n, "Cholesky decomposition requires a square matrix");
+            double maxDiag = 0.0;
+            for (int i = 0; i < n; ++i) {
+                perm_[i] = i;
+                maxDiag = Max(maxDiag, a(i, i));
+            }
+            const double stop = tolerance * maxDiag;
+            const ptrdiff_t ld = l_.Stride();
+
+            Vector_<> d(n);
+            for (int k0 = 0; k0 < n; k0 += CHOLESKY_BLOCK) {
+                const int kEnd = Min(n, k0 + CHOLESKY_BLOCK);
+                for (int i = k0; i < n; ++i)
+                    d[i] = l_(i, i);
+                int j = k0;
+                for (; j < kEnd; ++j) {
+                    const int p = static_cast<int>(std::max_element(d.begin() + j, d.end()) - d.begin());
+                    if (d[p] <= stop)
+                        break;
+                    if (p != j) {
+                        SymmetricSwap(&l_, j, p);
+                        std::swap(d[j], d[p]);
+                        std::swap(perm_[j], perm_[p]);
+                    }
+                    const double ljj = std::sqrt(d[j]);
+                    l_(j, j) = ljj;
+                    for (int i = j + 1; i < n; ++i) {
+                        l_(i, j) = (l_(i, j) - Blas::Dot(j - k0, &l_(i, k0), &l_(j, k0))) / ljj;
+                        d[i] -= Square(l_(i, j));
+                    }
+                }
+                rank_ = j;
+                if (j > k0 && j < n)
+                    Blas::Gemm(n - j, n - j, j - k0, {&l_(j, k0), ld, 1}, {&l_(j, k0), 1, ld}, &l_(j, j), ld, -1.0, 1.0);
+                if (j < kEnd)
+                    break;
+            }
+
+            // what is left is the Schur complement, which for a semi-definite matrix is negligible
+            double residual = 0.0;
+            for (int i = rank_; i < n; ++i)
+                for (int k = rank_; k <= i; ++k)
+                    residual = Max(residual, std::fabs(l_(i, k)));
+            REQUIRE(residual <= 10.0 * stop + EPSILON * maxDiag, "Matrix is not positive semi-definite");
+
+            l_.Resize(n, rank_);
+            pl_.Resize(n, rank_);
+            for (int i = 0; i < n; ++i)
+                for (int k = 0; k < rank_; ++k) {
+                    if (k > i)
+                        l_(i, k) = 0.0;
+                    pl_(perm_[i], k) = l_(i, k);
+                }
+        }
+    } // namespace
+
+    SymmetricMatrixDecomposition_* NewCholesky(const Matrix_<>& a, double tolerance) {
+        return new Cholesky_(a, tolerance);
+    }
+} // namespace Dal
@@ -0,0 +1,17 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/matrix/decompositions.hpp>
+
+namespace Dal {
+    /*
+     * Dense Cholesky decomposition with symmetric (diagonal) pivoting, P^T A P = L L^T
+     * accepts positive semi-definite matrices: the factorization stops when the largest remaining pivot
+     * is below tolerance times the largest diagonal, and Rank() reports the number of columns of L
+     * Solve requires full rank; MakeCorrelated needs only Rank() draws
+     */
+    SymmetricMatrixDecomposition_* NewCholesky(const Matrix_<>& a, double tolerance = 1.0e-12);
+} // namespace Dal
@@ -0,0 +1,462 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/csr.hpp>
+#include <dal/math/matrix/sparse.hpp>
+#include <dal/platform/simd.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <dal/utilities/numerics.hpp>
+#include <numeric>
+#if DAL_SIMD_X86
+#include <immintrin.h>
+#endif
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace Sparse {
+        Triplets_::Triplets_(int size) : size_(size) { REQUIRE(size > 0, "size should be larger than 0"); }
+
+        void Triplets_::Reserve(int entries) {
+            rows_.reserve(entries);
+            cols_.reserve(entries);
+            vals_.reserve(entries);
+        }
+
+        void Triplets_::Add(int row, int col, double val) {
+            REQUIRE(row >= 0 && row < size_ && col >= 0 && col < size_, "Triplet index out of range");
+            rows_.push_back(row);
+            cols_.push_back(col);
+            vals_.push_back(val);
+        }
+    } // namespace Sparse
+
+    namespace {
+        const double ZERO = 0.0;
+        // rows per task of a parallel product
+        constexpr int SPMV_CHUNK = 2048;
+
+        struct Csr_ {
+            Vector_<int> start_; // entries of row i are [start_[i], start_[i + 1])
+            Vector_<int> cols_;  // increasing within each row
+            Vector_<> vals_;
+
+            int Size() const { return static_cast<int>(start_.size()) - 1; }
+            int Find(int row, int col) const {
+                auto b = cols_.begin() + start_[row], e = cols_.begin() + start_[row + 1];
+                auto p = std::lower_bound(b, e, col);
+                return p != e && *p == col ? static_cast<int>(p - cols_.begin()) : -1;
+            }
+        };
+
+        Csr_ Compress(const Sparse::Triplets_& t) {
+            const int n = t.Size();
+            Csr_ ret_val;
+            // bucket the triplets by row, then sort each row by column and sum duplicates
+            Vector_<int> count(n + 1, 0);
+            for (int r : t.Rows())
+                ++count[r + 1];
+            std::partial_sum(count.begin(), count.end(), count.begin());
+            Vector_<int> order(t.Entries());
+            Vector_<int> next(count.begin(), count.end() - 1);
+            for (int k = 0; k < t.Entries(); ++k)
+                order[next[t.Rows()[k]]++] = k;
+
+            ret_val.start_.Resize(n + 1);
+            ret_val.start_[0] = 0;
+            ret_val.cols_.reserve(t.Entries());
+            ret_val.vals_.reserve(t.Entries());
+            for (int i = 0; i < n; ++i) {
+                std::stable_sort(order.begin() + count[i], order.begin() + count[i + 1],
+                                 [&](int k1, int k2) { return t.Cols()[k1] < t.Cols()[k2]; });
+                for (int p = count[i]; p < count[i + 1]; ++p) {
+                    const int k = order[p];
+                    if (p > count[i] && t.Cols()[k] == ret_val.cols_.back())
+                        ret_val.vals_.back() += t.Vals()[k];
+                    else {
+                        ret_val.cols_.push_back(t.Cols()[k]);
+                        ret_val.vals_.push_back(t.Vals()[k]);
+                    }
+                }
+                ret_val.start_[i + 1] = static_cast<int>(ret_val.cols_.size());
+            }
+            return ret_val;
+        }
+
+        /*
+         * y_i = sum_p vals_p x_{cols_p} for rows [begin, end)
+         * the vector versions gather x through the column indices
+         */
+        void RowsScalar(const Csr_& a, int begin, int end, const double* x, double* y) {
+            for (int i = begin; i < end; ++i) {
+                double s0 = 0.0, s1 = 0.0;
+                int p = a.start_[i];
+                const int e = a.start_[i + 1];
+                for (; p + 2 <= e; p += 2) {
+                    s0 += a.vals_[p] * x[a.cols_[p]];
+                    s1 += a.vals_[p + 1] * x[a.cols_[p + 1]];
+                }
+                if (p < e)
+                    s0 += a.vals_[p] * x[a.cols_[p]];
+                y[i] = s0 + s1;
+            }
+        }
+
+#if DAL_SIMD_X86
+        DAL_TARGET_AVX2 void RowsAvx2(const Csr_& a, int begin, int end, const double* x, double* y) {
+            const double* vals = &a.vals_[0];
+            const int* cols = &a.cols_[0];
+            for (int i = begin; i < end; ++i) {
+                int p = a.start_[i];
+                const int e = a.start_[i + 1];
+                __m256d acc = _mm256_setzero_pd();
+                for (; p + 4 <= e; p += 4) {
+                    const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cols + p));
+                    acc = _mm256_fmadd_pd(_mm256_loadu_pd(vals + p), _mm256_i32gather_pd(x, idx, 8), acc);
+                }
+                const __m128d h = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+                double s = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+                for (; p < e; ++p)
+                    s += vals[p] * x[cols[p]];
+                y[i] = s;
+            }
+        }
+
+        DAL_TARGET_AVX512 void RowsAvx512(const Csr_& a, int begin, int end, const double* x, double* y) {
+            const double* vals = &a.vals_[0];
+            const int* cols = &a.cols_[0];
+            for (int i = begin; i < end; ++i) {
+                int p = a.start_[i];
+                const int e = a.start_[i + 1];
+                __m512d acc = _mm512_setzero_pd();
+                for (; p + 8 <= e; p += 8) {
+                    const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cols + p));
+                    acc = _mm512_fmadd_pd(_mm512_loadu_pd(vals + p), _mm512_i32gather_pd(idx, x, 8), acc);
+                }
+                double s = _mm512_reduce_add_pd(acc);
+                for (; p < e; ++p)
+                    s += vals[p] * x[cols[p]];
+                y[i] = s;
+            }
+        }
+#endif
+
+        void Rows(const Csr_& a, int begin, int end, const double* x, double* y) {
+            if (a.vals_.empty()) {
+                std::fill(y + begin, y + end, 0.0);
+                return;
+            }
+#if DAL_SIMD_X86
+            switch (SimdLevel()) {
+            case SimdLevel_::AVX512:
+                return RowsAvx512(a, begin, end, x, y);
+            case SimdLevel_::AVX2:
+                return RowsAvx2(a, begin, end, x, y);
+            default:
+                break;
+            }
+#endif
+            RowsScalar(a, begin, end, x, y);
+        }
+
+        // y = A x, in chunks of rows on the pool if one is given
+        void Multiply(const Csr_& a, const Vector_<>& x, Vector_<>* y, ThreadPool_* pool) {
+            const int n = a.Size();
+            REQUIRE(x.size() == n, "Size should be compatible with x and the matrix");
+            y->Resize(n);
+            const double* px = &x[0];
+            double* py = &(*y)[0];
+            ParallelBlocks(pool, n, SPMV_CHUNK, [&](int begin, int end) { Rows(a, begin, end, px, py); });
+        }
+
+        // y = A^T x, scattering each row
+        void MultiplyTransposed(const Csr_& a, const Vector_<>& x, Vector_<>* y) {
+            const int n = a.Size();
+            REQUIRE(x.size() == n, "Size should be compatible with x and the matrix");
+            y->Resize(n);
+            y->Fill(0.0);
+            for (int i = 0; i < n; ++i)
+                for (int p = a.start_[i]; p < a.start_[i + 1]; ++p)
+                    (*y)[a.cols_[p]] += a.vals_[p] * x[i];
+        }
+
+        bool HasSymmetricValues(const Csr_& a) {
+            for (int i = 0; i < a.Size(); ++i)
+                for (int p = a.start_[i]; p < a.start_[i + 1]; ++p) {
+                    const int q = a.Find(a.cols_[p], i);
+                    if (!IsZero(a.vals_[p] - (q < 0 ? 0.0 : a.vals_[q])))
+                        return false;
+                }
+            return true;
+        }
+
+        bool HasPositiveDiagonal(const Csr_& a) {
+            for (int i = 0; i < a.Size(); ++i) {
+                const int p = a.Find(i, i);
+                if (p < 0 || a.vals_[p] <= 0.0)
+                    return false;
+            }
+            return true;
+        }
+
+        /*
+         * z = M^{-1} r, or M^{-T} r if transposed
+         * ILU(0) keeps the pattern of A: unit lower L below the diagonal, U on and above it
+         */
+        class Preconditioning_ {
+            Sparse::Preconditioner_ type_;
+            Vector_<> invDiag_;
+            Csr_ lu_;
+            Vector_<int> diag_;
+
+        public:
+            Preconditioning_(const Csr_& a, Sparse::Preconditioner_ type) : type_(type) {
+                const int n = a.Size();
+                if (type_ == Sparse::Preconditioner_::NONE)
+                    return;
+                diag_.Resize(n);
+                for (int i = 0; i < n; ++i) {
+                    diag_[i] = a.Find(i, i);
+                    REQUIRE(diag_[i] >= 0 && !IsZero(a.vals_[diag_[i]]), "Preconditioner needs a non-zero diagonal");
+                }
+                if (type_ == Sparse::Preconditioner_::JACOBI) {
+                    invDiag_.Resize(n);
+                    for (int i = 0; i < n; ++i)
+                        invDiag_[i] = 1.0 / a.vals_[diag_[i]];
+                    return;
+                }
+                lu_ = a;
+                Vector_<int> pos(n, -1); // where each column of the current row is stored
+                for (int i = 1; i < n; ++i) {
+                    for (int p = lu_.start_[i]; p < lu_.start_[i + 1]; ++p)
+                        pos[lu_.cols_[p]] = p;
+                    for (int p = lu_.start_[i]; p < diag_[i]; ++p) {
+                        const int k = lu_.cols_[p];
+                        lu_.vals_[p] /= lu_.vals_[diag_[k]];
+                        for (int q = diag_[k] + 1; q < lu_.start_[k + 1]; ++q)
+                            if (pos[lu_.cols_[q]] >= 0)
+                                lu_.vals_[pos[lu_.cols_[q]]] -= lu_.vals_[p] * lu_.vals_[q];
+                    }
+                    REQUIRE(!IsZero(lu_.vals_[diag_[i]]), "Zero pivot in incomplete LU");
+                    for (int p = lu_.start_[i]; p < lu_.start_[i + 1]; ++p)
+                        pos[lu_.cols_[p]] = -1;
+                }
+            }
+
+            void Apply(const Vector_<>& r, Vector_<>* z, bool transposed) const {
+                const int n = static_cast<int>(r.size());
+                *z = r;
+                if (type_ == Sparse::Preconditioner_::NONE)
+                    return;
+                if (type_ == Sparse::Preconditioner_::JACOBI) {
+                    for (int i = 0; i < n; ++i)
+                        (*z)[i] *= invDiag_[i];
+                    return;
+                }
+                const auto& s = lu_.start_;
+                const auto& c = lu_.cols_;
+                const auto& v = lu_.vals_;
+                if (!transposed) {
+                    for (int i = 0; i < n; ++i)
+                        for (int p = s[i]; p < diag_[i]; ++p)
+                            (*z)[i] -= v[p] * (*z)[c[p]];
+                    for (int i = n - 1; i >= 0; --i) {
+                        for (int p = diag_[i] + 1; p < s[i + 1]; ++p)
+                            (*z)[i] -= v[p] * (*z)[c[p]];
+                        (*z)[i] /= v[diag_[i]];
+                    }
+                } else {
+                    // U^T then L^T, each by scattering the solved component down (up) its row
+                    for (int i = 0; i < n; ++i) {
+                        (*z)[i] /= v[diag_[i]];
+                        for (int p = diag_[i] + 1; p < s[i + 1]; ++p)
+                            (*z)[c[p]] -= v[p] * (*z)[i];
+                    }
+                    for (int i = n - 1; i >= 0; --i)
+                        for (int p = s[i]; p < diag_[i]; ++p)
+                            (*z)[c[p]] -= v[p] * (*z)[i];
+                }
+            }
+        };
+
+        // what the Krylov solvers share: the operator, its preconditioner and the stopping rule
+        struct System_ {
+            Csr_ a_;
+            Preconditioning_ m_;
+            Sparse::SolverControl_ control_;
+            ThreadPool_* pool_;
+
+            System_(const Csr_& a, const Sparse::SolverControl_& control, ThreadPool_* pool)
+                : a_(a), m_(a, control.preconditioner_), control_(control), pool_(pool) {}
+
+            int Size() const { return a_.Size(); }
+            void Apply(const Vector_<>& x, Vector_<>* y, bool transposed) const {
+                if (transposed)
+                    MultiplyTransposed(a_, x, y);
+                else
+                    Multiply(a_, x, y, pool_);
+            }
+        };
+
+        double Dot(const Vector_<>& x, const Vector_<>& y) { return Blas::Dot(static_cast<int>(x.size()), &x[0], &y[0]); }
+        void Axpy(double alpha, const Vector_<>& x, Vector_<>* y) {
+            Blas::Axpy(static_cast<int>(x.size()), alpha, &x[0], &(*y)[0]);
+        }
+
+        // preconditioned conjugate gradients, for symmetric positive definite A; false if it breaks down
+        bool SolveCG(const System_& sys, const Vector_<>& b, Vector_<>* x) {
+            const int n = sys.Size();
+            REQUIRE(b.size() == n, "Size should be compatible with b and the matrix");
+            x->Resize(n);
+            x->Fill(0.0);
+            const double bb = Dot(b, b);
+            if (bb == 0.0)
+                return true;
+            const double stop = Square(sys.control_.tolerance_) * bb;
+            Vector_<> r(b), z, p, ap;
+            sys.m_.Apply(r, &z, false);
+            p = z;
+            double rz = Dot(r, z);
+            for (int iter = 0; iter < sys.control_.maxIterations_; ++iter) {
+                sys.Apply(p, &ap, false);
+                const double pap = Dot(p, ap);
+                if (!(pap > 0.0 && rz > 0.0))
+                    return false;
+                const double alpha = rz / pap;
+                Axpy(alpha, p, x);
+                Axpy(-alpha, ap, &r);
+                if (Dot(r, r) <= stop)
+                    return true;
+                sys.m_.Apply(r, &z, false);
+                const double rzNew = Dot(r, z);
+                const double beta = rzNew / rz;
+                rz = rzNew;
+                for (int i = 0; i < n; ++i)
+                    p[i] = z[i] + beta * p[i];
+            }
+            THROW("Conjugate gradients did not converge");
+        }
+
+        // right-preconditioned BiCGSTAB; with transposed, solves A^T x = b
+        void SolveBiCGSTAB(const System_& sys, const Vector_<>& b, Vector_<>* x, bool transposed) {
+            const int n = sys.Size();
+            REQUIRE(b.size() == n, "Size should be compatible with b and the matrix");
+            x->Resize(n);
+            x->Fill(0.0);
+            const double bb = Dot(b, b);
+            if (bb == 0.0)
+                return;
+            const double stop = Square(sys.control_.tolerance_) * bb;
+            const Vector_<> rHat(b);
+            Vector_<> r(b), p(n, 0.0), v(n, 0.0), y, s(n), z, t;
+            double rho = 1.0, alpha = 1.0, omega = 1.0;
+            for (int iter = 0; iter < sys.control_.maxIterations_; ++iter) {
+                const double rhoNew = Dot(rHat, r);
+                REQUIRE(rhoNew != 0.0, "BiCGSTAB broke down");
+                const double beta = (rhoNew / rho) * (alpha / omega);
+                rho = rhoNew;
+                for (int i = 0; i < n; ++i)
+                    p[i] = r[i] + beta * (p[i] - omega * v[i]);
+                sys.m_.Apply(p, &y, transposed);
+                sys.Apply(y, &v, transposed);
+                alpha = rho / Dot(rHat, v);
+                for (int i = 0; i < n; ++i)
+                    s[i] = r[i] - alpha * v[i];
+                Axpy(alpha, y, x);
+                if (Dot(s, s) <= stop)
+                    return;
+                sys.m_.Apply(s, &z, transposed);
+                sys.Apply(z, &t, transposed);
+                const double tt = Dot(t, t);
+                REQUIRE(tt > 0.0, "BiCGSTAB broke down");
+                omega = Dot(t, s) / tt;
+                Axpy(omega, z, x);
+                for (int i = 0; i < n; ++i)
+                    r[i] = s[i] - omega * t[i];
+                if (Dot(r, r) <= stop)
+                    return;
+                REQUIRE(omega != 0.0, "BiCGSTAB broke down");
+            }
+            THROW("BiCGSTAB did not converge");
+        }
+
+        /*
+         * symmetric A: conjugate gradients if the diagonal is positive, as it is for any positive definite A
+         * BiCGSTAB if it is not, or if conjugate gradients breaks down because A is indefinite after all
+         */
+        struct CGDecomp_ : Sparse::SymmetricDecomposition_ {
+            System_ sys_;
+            bool tryCG_;
+            CGDecomp_(const Csr_& a, const Sparse::SolverControl_& control, ThreadPool_* pool)
+                : sys_(a, control, pool), tryCG_(HasPositiveDiagonal(a)) {}
+
+            int Size() const override { return sys_.Size(); }
+            void XMultiply_af(const Vector_<>& x, Vector_<>* b) const override { sys_.Apply(x, b, false); }
+            void XSolve_af(const Vector_<>& b, Vector_<>* x) const override {
+                if (!tryCG_ || !SolveCG(sys_, b, x))
+                    SolveBiCGSTAB(sys_, b, x, false);
+            }
+            using Sparse::SymmetricDecomposition_::MakeCorrelated;
+            Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
+                                                     Vector_<>* correlated) const override {
+                THROW("Sparse correlation matrices are not supported");
+            }
+        };
+
+        struct BiCGSTABDecomp_ : SquareMatrixDecomposition_ {
+            System_ sys_;
+            BiCGSTABDecomp_(const Csr_& a, const Sparse::SolverControl_& control, ThreadPool_* pool)
+                : sys_(a, control, pool) {}
+
+            int Size() const override { return sys_.Size(); }
+            void XMultiplyLeft_af(const Vector_<>& x, Vector_<>* b) const override { sys_.Apply(x, b, false); }
+            void XMultiplyRight_af(const Vector_<>& x, Vector_<>* b) const override { sys_.Apply(x, b, true); }
+            void XSolveLeft_af(const Vector_<>& b, Vector_<>* x) const override { SolveBiCGSTAB(sys_, b, x, false); }
+            void XSolveRight_af(const Vector_<>& b, Vector_<>* x) const override { SolveBiCGSTAB(sys_, b, x, true); }
+        };
+
+        class CompressedRow_ : public Sparse::Square_ {
+            Csr_ a_;
+            Sparse::SolverControl_ control_;
+            ThreadPool_* pool_;
+
+            int Position(int i_row, int j_col) const {
+                REQUIRE(i_row >= 0 && i_row < Size() && j_col >= 0 && j_col < Size(), "Index out of range");
+                const int ret_val = a_.Find(i_row, j_col);
+                REQUIRE(ret_val >= 0, "Entry is outside the sparsity pattern");
+                return ret_val;
+            }
+
+        public:
+            CompressedRow_(const Sparse::Triplets_& entries, const Sparse::SolverControl_& control, ThreadPool_* pool)
+                : a_(Compress(entries)), control_(control), pool_(pool) {}
+
+            int Size() const override { return a_.Size(); }
+            void MultiplyLeft(const Vector_<>& x, Vector_<>* b) const override { Multiply(a_, x, b, pool_); }
+            void MultiplyRight(const Vector_<>& x, Vector_<>* b) const override { MultiplyTransposed(a_, x, b); }
+            bool IsSymmetric() const override { return HasSymmetricValues(a_); }
+
+            SquareMatrixDecomposition_* Decompose() const override {
+                if (IsSymmetric())
+                    return new CGDecomp_(a_, control_, pool_);
+                return new BiCGSTABDecomp_(a_, control_, pool_);
+            }
+
+            const double& operator()(int i_row, int j_col) const override {
+                const int p = a_.Find(i_row, j_col);
+                return p >= 0 ? a_.vals_[p] : ZERO;
+            }
+            void Set(int i_row, int j_col, double val) override { a_.vals_[Position(i_row, j_col)] = val; }
+            void Add(int i_row, int j_col, double val) override { a_.vals_[Position(i_row, j_col)] += val; }
+        };
+    } // namespace
+
+    namespace Sparse {
+        Square_* NewCompressedRow(const Triplets_& entries, const SolverControl_& control, ThreadPool_* pool) {
+            return new CompressedRow_(entries, control, pool);
+        }
+    } // namespace Sparse
+} // namespace Dal
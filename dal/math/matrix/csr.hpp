@@ -0,0 +1,56 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/vectors.hpp>
+
+namespace Dal {
+    class ThreadPool_;
+
+    namespace Sparse {
+        class Square_;
+
+        // (row, col, value) entries in any order; repeated entries are summed when the matrix is built
+        class Triplets_ {
+            int size_;
+            Vector_<int> rows_, cols_;
+            Vector_<> vals_;
+
+        public:
+            explicit Triplets_(int size);
+            int Size() const { return size_; }
+            int Entries() const { return static_cast<int>(vals_.size()); }
+            void Reserve(int entries);
+            void Add(int row, int col, double val);
+
+            const Vector_<int>& Rows() const { return rows_; }
+            const Vector_<int>& Cols() const { return cols_; }
+            const Vector_<>& Vals() const { return vals_; }
+        };
+
+        enum class Preconditioner_ { NONE, JACOBI, ILU0 };
+
+        struct SolverControl_ {
+            Preconditioner_ preconditioner_;
+            double tolerance_; // on the residual, relative to the right-hand side
+            int maxIterations_;
+            explicit SolverControl_(Preconditioner_ preconditioner = Preconditioner_::ILU0,
+                                    double tolerance = 1.0e-12,
+                                    int max_iterations = 1000)
+                : preconditioner_(preconditioner), tolerance_(tolerance), maxIterations_(max_iterations) {}
+        };
+
+        /*
+         * Compressed sparse row storage; the pattern is fixed by the triplets, so Set and Add only change stored entries
+         * products are vectorised and split over the pool if one is given
+         * Decompose() returns a preconditioned iterative solver: conjugate gradients if symmetric, BiCGSTAB otherwise
+         * a symmetric matrix falls back to BiCGSTAB if its diagonal is not positive or conjugate gradients breaks down
+         */
+        Square_* NewCompressedRow(const Triplets_& entries,
+                                  const SolverControl_& control = SolverControl_(),
+                                  ThreadPool_* pool = nullptr);
+    } // namespace Sparse
+} // namespace Dal
@@ -3,6 +3,7 @@
 //
 
 #include <dal/math/matrix/decompositions.hpp>
+#include <dal/math/matrix/matrixs.hpp>
 #include <dal/platform/strict.hpp>
 
 #define COPY_ALIAS_AND_FORWARD(cname, func, imp)                                                                       \
@@ -13,6 +14,14 @@
             imp(x, b);                                                                                                 \
     }
 
+#define COPY_AND_SOLVE_IN_PLACE(cname, func, imp)                                                                      \
+    void cname::func(const Matrix_<>& b, Matrix_<>* x) const {                                                         \
+        REQUIRE(b.Rows() == Size(), "Size should be compatible with b and the matrix");                                \
+        if (&b != x)                                                                                                   \
+            *x = b;                                                                                                    \
+        imp(x);                                                                                                        \
+    }
+
 namespace Dal {
     COPY_ALIAS_AND_FORWARD(SquareMatrixDecomposition_, SolveLeft, XSolveLeft_af)
     COPY_ALIAS_AND_FORWARD(SquareMatrixDecomposition_, SolveRight, XSolveRight_af)
@@ -20,4 +29,39 @@ namespace Dal {
     COPY_ALIAS_AND_FORWARD(SquareMatrixDecomposition_, MultiplyRight, XMultiplyRight_af)
     COPY_ALIAS_AND_FORWARD(SymmetricMatrixDecomposition_, Solve, XSolve_af)
     COPY_ALIAS_AND_FORWARD(SymmetricMatrixDecomposition_, Multiply, XMultiply_af)
+    COPY_AND_SOLVE_IN_PLACE(SquareMatrixDecomposition_, SolveLeft, XSolveLeftInPlace)
+    COPY_AND_SOLVE_IN_PLACE(SquareMatrixDecomposition_, SolveRight, XSolveRightInPlace)
+    COPY_AND_SOLVE_IN_PLACE(SymmetricMatrixDecomposition_, Solve, XSolveInPlace)
+
+    namespace {
+        template <class F_> void SolveByColumn(Matrix_<>* bx, const F_& solve) {
+            Vector_<> b(bx->Rows()), x;
+            for (int j = 0; j < bx->Cols(); ++j) {
+                std::copy(bx->Col(j).begin(), bx->Col(j).end(), b.begin());
+                solve(b, &x);
+                std::copy(x.begin(), x.end(), bx->Col(j).begin());
+            }
+        }
+    } // namespace
+
+    void SquareMatrixDecomposition_::XSolveLeftInPlace(Matrix_<>* bx) const {
+        SolveByColumn(bx, [this](const Vector_<>& b, Vector_<>* x) { XSolveLeft_af(b, x); });
+    }
+
+    void SquareMatrixDecomposition_::XSolveRightInPlace(Matrix_<>* bx) const {
+        SolveByColumn(bx, [this](const Vector_<>& b, Vector_<>* x) { XSolveRight_af(b, x); });
+    }
+
+    void SymmetricMatrixDecomposition_::MakeCorrelated(const Matrix_<>& iid, Matrix_<>* correlated) const {
+        REQUIRE(correlated && correlated != &iid, "Correlated output must be distinct from iid input");
+        const int rank = Rank();
+        REQUIRE(iid.Cols() >= rank, "Too few iid draws per row");
+        correlated->Resize(iid.Rows(), Size());
+        Vector_<> z(rank), c;
+        for (int i = 0; i < iid.Rows(); ++i) {
+            std::copy(iid[i].begin(), iid[i].begin() + rank, z.begin());
+            MakeCorrelated(z.begin(), &c);
+            std::copy(c.begin(), c.end(), (*correlated)[i].begin());
+        }
+    }
 } // namespace Dal
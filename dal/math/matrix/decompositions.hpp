@@ -15,6 +15,11 @@ namespace Dal {
         virtual void XSolveLeft_af(const Vector_<>& b, Vector_<>* x) const = 0;
         virtual void XSolveRight_af(const Vector_<>& b, Vector_<>* x) const = 0;
 
+    protected:
+        // solve in place for every column of bx; by default, one column at a time
+        virtual void XSolveLeftInPlace(Matrix_<>* bx) const;
+        virtual void XSolveRightInPlace(Matrix_<>* bx) const;
+
     public:
         virtual ~SquareMatrixDecomposition_() = default;
         virtual int Size() const = 0;
@@ -22,6 +27,9 @@ namespace Dal {
         void MultiplyRight(const Vector_<>& x, Vector_<>* b) const;
         void SolveLeft(const Vector_<>& b, Vector_<>* x) const;
         void SolveRight(const Vector_<>& b, Vector_<>* x) const;
+        // many right-hand sides, one per column of b (Size() rows); x may be &b
+        void SolveLeft(const Matrix_<>& b, Matrix_<>* x) const;
+        void SolveRight(const Matrix_<>& b, Matrix_<>* x) const;
     };
 
     // special case of symmetric matrix
@@ -39,13 +47,22 @@ namespace Dal {
 
         void XSolveRight_af(const Vector_<>& b, Vector_<>* x) const override { return XSolve_af(b, x); }
 
+        virtual void XSolveInPlace(Matrix_<>* bx) const { SquareMatrixDecomposition_::XSolveLeftInPlace(bx); }
+
+        void XSolveLeftInPlace(Matrix_<>* bx) const override { XSolveInPlace(bx); }
+
+        void XSolveRightInPlace(Matrix_<>* bx) const override { XSolveInPlace(bx); }
+
     public:
         virtual int Rank() const { return Size(); }
         virtual Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
                                                          Vector_<>* correlated) const = 0;
+        // batch version: each row of iid holds (at least) Rank() draws, the same row of correlated gets Size() outputs
+        virtual void MakeCorrelated(const Matrix_<>& iid, Matrix_<>* correlated) const;
 
         void Multiply(const Vector_<>& x, Vector_<>* b) const;
         void Solve(const Vector_<>& b, Vector_<>* x) const;
+        void Solve(const Matrix_<>& b, Matrix_<>* x) const;
     };
 
     class ExponentiatesMatrix_ {
@@ -0,0 +1,254 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/eigensystem.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <numeric>
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace {
+        // a cyclic sweep rotates every off-diagonal pair once; convergence is quadratic, so a few sweeps suffice
+        constexpr int MAX_JACOBI_SWEEPS = 64;
+
+        // columns p and q of m become (c m_p - s m_q, s m_p + c m_q)
+        void RotateCols(Matrix_<>* m, int p, int q, double c, double s) {
+            for (int k = 0; k < m->Rows(); ++k) {
+                const double mp = (*m)(k, p), mq = (*m)(k, q);
+                (*m)(k, p) = c * mp - s * mq;
+                (*m)(k, q) = s * mp + c * mq;
+            }
+        }
+
+        void RotateRows(Matrix_<>* m, int p, int q, double c, double s) {
+            double* rp = m->Row(p).Data();
+            double* rq = m->Row(q).Data();
+            for (int k = 0; k < m->Cols(); ++k) {
+                const double mp = rp[k], mq = rq[k];
+                rp[k] = c * mp - s * mq;
+                rq[k] = s * mp + c * mq;
+            }
+        }
+
+        double OffDiagonal(const Matrix_<>& a) {
+            double ret_val = 0.0;
+            for (int i = 0; i < a.Rows(); ++i)
+                for (int j = i + 1; j < a.Cols(); ++j)
+                    ret_val += Square(a(i, j));
+            return ret_val;
+        }
+
+        // x = w w^T
+        void OuterSelf(const Matrix_<>& w, Matrix_<>* x) {
+            x->Resize(w.Rows(), w.Rows());
+            Blas::Gemm(w.Rows(), w.Rows(), w.Cols(), {w.Data(), w.Stride(), 1}, {w.Data(), 1, w.Stride()}, x->Data(),
+                       x->Stride());
+        }
+
+        double FrobeniusDistance(const Matrix_<>& a, const Matrix_<>& b) {
+            double ret_val = 0.0;
+            for (int i = 0; i < a.Rows(); ++i)
+                for (int j = 0; j < a.Cols(); ++j)
+                    ret_val += Square(a(i, j) - b(i, j));
+            return std::sqrt(ret_val);
+        }
+
+        // the positive semi-definite part: eigenvalues below zero are dropped
+        void ProjectPSD(const Matrix_<>& r, Matrix_<>* x) {
+            Vector_<> values;
+            Matrix_<> vecs;
+            SymmetricEigen(r, &values, &vecs);
+            for (int i = 0; i < vecs.Rows(); ++i)
+                for (int j = 0; j < vecs.Cols(); ++j)
+                    vecs(i, j) *= std::sqrt(Max(0.0, values[j]));
+            OuterSelf(vecs, x);
+        }
+
+        class PrincipalComponents_ : public SymmetricMatrixDecomposition_ {
+            Matrix_<> loadings_; // F: n x rank
+            Matrix_<> vecs_;     // leading eigenvectors
+            Vector_<> values_;   // and their eigenvalues
+            Vector_<> scale_;    // F = diag(scale) V_k diag(values_k)^{1/2}
+
+            void XMultiply_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                const int n = Size(), k = Rank();
+                Vector_<> z(k, 0.0);
+                for (int i = 0; i < n; ++i)
+                    Blas::Axpy(k, x[i], loadings_.Row(i).Data(), &z[0]);
+                b->Resize(n);
+                for (int i = 0; i < n; ++i)
+                    (*b)[i] = Blas::Dot(k, loadings_.Row(i).Data(), &z[0]);
+            }
+
+            void XSolve_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(Rank() == Size(), "Can't solve with a reduced-rank factor model");
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                const int n = Size();
+                // A = S V L V^T S, so x = S^{-1} V L^{-1} V^T S^{-1} b
+                Vector_<> y(n), z(n, 0.0);
+                for (int i = 0; i < n; ++i)
+                    y[i] = b[i] / scale_[i];
+                for (int i = 0; i < n; ++i)
+                    Blas::Axpy(n, y[i], vecs_.Row(i).Data(), &z[0]);
+                for (int j = 0; j < n; ++j)
+                    z[j] /= values_[j];
+                x->Resize(n);
+                for (int i = 0; i < n; ++i)
+                    (*x)[i] = Blas::Dot(n, vecs_.Row(i).Data(), &z[0]) / scale_[i];
+            }
+
+        public:
+            PrincipalComponents_(const Matrix_<>& a, int max_rank, double min_eigenvalue, bool keep_diagonal);
+
+            int Size() const override { return loadings_.Rows(); }
+            int Rank() const override { return loadings_.Cols(); }
+
+            Vector_<>::const_iterator MakeCorrelated(Vector_<>::const_iterator iid_begin,
+                                                     Vector_<>* correlated) const override {
+                const int n = Size();
+                correlated->Resize(n);
+                if (Rank() == 0) {
+                    correlated->Fill(0.0);
+                    return iid_begin;
+                }
+                for (int i = 0; i < n; ++i)
+                    (*correlated)[i] = Blas::Dot(Rank(), loadings_.Row(i).Data(), &*iid_begin);
+                return iid_begin + Rank();
+            }
+
+            // correlated = iid * F^T
+            void MakeCorrelated(const Matrix_<>& iid, Matrix_<>* correlated) const override {
+                REQUIRE(correlated && correlated != &iid, "Correlated output must be distinct from iid input");
+                REQUIRE(iid.Cols() >= Rank(), "Too few iid draws per row");
+                correlated->Resize(iid.Rows(), Size());
+                Blas::Gemm(iid.Rows(), Size(), Rank(), {iid.Data(), iid.Stride(), 1},
+                           {loadings_.Data(), 1, loadings_.Stride()}, correlated->Data(), correlated->Stride());
+            }
+        };
+
+        PrincipalComponents_::PrincipalComponents_(const Matrix_<>& a,
+                                                   int max_rank,
+                                                   double min_eigenvalue,
+                                                   bool keep_diagonal) {
+            const int n = a.Rows();
+            REQUIRE(max_rank >= 0, "Rank should be non-negative");
+            Vector_<> values;
+            Matrix_<> vecs;
+            SymmetricEigen(a, &values, &vecs);
+            int k = 0;
+            while (k < Min(n, max_rank) && values[k] > 0.0 && values[k] >= min_eigenvalue * values[0])
+                ++k;
+
+            vecs_.Resize(n, k);
+            values_ = Vector_<>(values.begin(), values.begin() + k);
+            loadings_.Resize(n, k);
+            scale_ = Vector_<>(n, 1.0);
+            for (int i = 0; i < n; ++i) {
+                double norm = 0.0;
+                for (int j = 0; j < k; ++j) {
+                    vecs_(i, j) = vecs(i, j);
+                    loadings_(i, j) = vecs(i, j) * std::sqrt(values_[j]);
+                    norm += Square(loadings_(i, j));
+                }
+                if (keep_diagonal && norm > 0.0) {
+                    scale_[i] = std::sqrt(Max(0.0, a(i, i)) / norm);
+                    Blas::Scale(k, scale_[i], loadings_.Row(i).Data());
+                }
+            }
+        }
+    } // namespace
+
+    void SymmetricEigen(const Matrix_<>& a, Vector_<>* values, Matrix_<>* vecs) {
+        const int n = a.Rows();
+        REQUIRE(a.Cols() == n, "Eigen-decomposition requires a square matrix");
+        Matrix_<> m(a);
+        Matrix_<> v(n, n);
+        v.Fill(0.0);
+        double scale = 0.0;
+        for (int i = 0; i < n; ++i) {
+            v(i, i) = 1.0;
+            for (int j = 0; j < n; ++j)
+                scale += Square(a(i, j));
+        }
+        const double stop = Square(EPSILON) * scale;
+
+        int sweep = 0;
+        for (; sweep < MAX_JACOBI_SWEEPS && OffDiagonal(m) > stop; ++sweep) {
+            for (int p = 0; p < n - 1; ++p)
+                for (int q = p + 1; q < n; ++q) {
+                    const double apq = m(p, q);
+                    if (apq == 0.0)
+                        continue;
+                    // the rotation which zeroes m(p, q), taking the smaller angle
+                    const double theta = (m(q, q) - m(p, p)) / (2.0 * apq);
+                    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(1.0 + theta * theta));
+                    const double c = 1.0 / std::sqrt(1.0 + t * t);
+                    const double s = t * c;
+                    RotateCols(&m, p, q, c, s);
+                    RotateRows(&m, p, q, c, s);
+                    m(p, q) = m(q, p) = 0.0;
+                    RotateCols(&v, p, q, c, s);
+                }
+        }
+        REQUIRE(sweep < MAX_JACOBI_SWEEPS, "Jacobi eigen-decomposition did not converge");
+
+        Vector_<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&m](int i, int j) { return m(i, i) > m(j, j); });
+        values->Resize(n);
+        vecs->Resize(n, n);
+        for (int j = 0; j < n; ++j) {
+            (*values)[j] = m(order[j], order[j]);
+            for (int i = 0; i < n; ++i)
+                (*vecs)(i, j) = v(i, order[j]);
+        }
+    }
+
+    Matrix_<> NearestCorrelation(const Matrix_<>& a, double tolerance, int max_iterations) {
+        const int n = a.Rows();
+        REQUIRE(a.Cols() == n, "Correlation matrix should be square");
+        Matrix_<> y(a), ds(n, n), r(n, n), x;
+        ds.Fill(0.0);
+        for (int iter = 0; iter < max_iterations; ++iter) {
+            const Matrix_<> yOld(y);
+            // Dykstra's correction is only needed for the (non-affine) semi-definite cone
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
+                    r(i, j) = y(i, j) - ds(i, j);
+            ProjectPSD(r, &x);
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
+                    ds(i, j) = x(i, j) - r(i, j);
+            y = x;
+            for (int i = 0; i < n; ++i)
+                y(i, i) = 1.0;
+
+            const double size = FrobeniusDistance(y, Matrix_<>(n, n)); // Matrix_(n, n) is zero
+            if (FrobeniusDistance(y, yOld) <= tolerance * size && FrobeniusDistance(y, x) <= tolerance * size)
+                break;
+            REQUIRE(iter + 1 < max_iterations, "Nearest correlation did not converge");
+        }
+
+        // x is semi-definite and (to tolerance) has unit diagonal: rescale so that the diagonal is exact
+        Vector_<> d(n);
+        for (int i = 0; i < n; ++i)
+            d[i] = x(i, i) > 0.0 ? 1.0 / std::sqrt(x(i, i)) : 0.0;
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                x(i, j) = i == j ? 1.0 : x(i, j) * d[i] * d[j];
+        return x;
+    }
+
+    SymmetricMatrixDecomposition_* NewPrincipalComponents(const Matrix_<>& a,
+                                                          int max_rank,
+                                                          double min_eigenvalue,
+                                                          bool keep_diagonal) {
+        return new PrincipalComponents_(a, max_rank, min_eigenvalue, keep_diagonal);
+    }
+} // namespace Dal
@@ -0,0 +1,34 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/matrix/decompositions.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+
+namespace Dal {
+    /*
+     * Symmetric eigen-decomposition A = V diag(values) V^T by cyclic Jacobi rotations
+     * values are in decreasing order, and column j of vecs is the (unit) eigenvector of values[j]
+     */
+    void SymmetricEigen(const Matrix_<>& a, Vector_<>* values, Matrix_<>* vecs);
+
+    /*
+     * Nearest correlation matrix in Frobenius norm (Higham 2002): alternating projections onto
+     * the positive semi-definite matrices and the unit-diagonal matrices, with Dykstra's correction
+     * the result is positive semi-definite with unit diagonal
+     */
+    Matrix_<> NearestCorrelation(const Matrix_<>& a, double tolerance = 1.0e-10, int max_iterations = 1000);
+
+    /*
+     * Reduced-rank factor model from the leading eigenvectors: A ~ F F^T, with F = V_k diag(values_k)^{1/2}
+     * keeps at most max_rank factors, and none whose eigenvalue is below min_eigenvalue times the largest
+     * if keep_diagonal, rows of F are rescaled so that F F^T has the diagonal of A (e.g. stays a correlation)
+     * MakeCorrelated needs only Rank() draws; Solve requires full rank
+     */
+    SymmetricMatrixDecomposition_* NewPrincipalComponents(const Matrix_<>& a,
+                                                          int max_rank,
+                                                          double min_eigenvalue = 1.0e-12,
+                                                          bool keep_diagonal = false);
+} // namespace Dal
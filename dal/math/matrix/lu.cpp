@@ -0,0 +1,160 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/lu.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace {
+        // columns per panel; the update of the trailing matrix by each panel is one Gemm
+        constexpr int LU_BLOCK = 64;
+
+        class LU_ : public SquareMatrixDecomposition_ {
+            Matrix_<> lu_;      // unit lower L below the diagonal, U on and above it
+            Vector_<int> piv_;  // row i was swapped with row piv_[i] >= i, in order
+
+            void Permute(Vector_<>* v) const {
+                for (int i = 0; i < Size(); ++i)
+                    std::swap((*v)[i], (*v)[piv_[i]]);
+            }
+            void PermuteBack(Vector_<>* v) const {
+                for (int i = Size() - 1; i >= 0; --i)
+                    std::swap((*v)[i], (*v)[piv_[i]]);
+            }
+
+            // the triangular sweeps work in place on v
+            void LSolve(Vector_<>* v) const {
+                for (int i = 1; i < Size(); ++i)
+                    (*v)[i] -= Blas::Dot(i, lu_.Row(i).Data(), &(*v)[0]);
+            }
+            void USolve(Vector_<>* v) const {
+                for (int i = Size() - 1; i >= 0; --i) {
+                    const int nAfter = Size() - 1 - i;
+                    (*v)[i] = ((*v)[i] - Blas::Dot(nAfter, lu_.Row(i).Data() + i + 1, &(*v)[0] + i + 1)) / lu_(i, i);
+                }
+            }
+            void UTransposeSolve(Vector_<>* v) const {
+                for (int i = 0; i < Size(); ++i) {
+                    (*v)[i] /= lu_(i, i);
+                    Blas::Axpy(Size() - 1 - i, -(*v)[i], lu_.Row(i).Data() + i + 1, &(*v)[0] + i + 1);
+                }
+            }
+            void LTransposeSolve(Vector_<>* v) const {
+                for (int i = Size() - 1; i > 0; --i)
+                    Blas::Axpy(i, -(*v)[i], lu_.Row(i).Data(), &(*v)[0]);
+            }
+
+            void XMultiplyLeft_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                const int n = Size();
+                b->Resize(n);
+                // U x, then L (U x) from the bottom up, so that the rows still needed are not yet overwritten
+                for (int i = 0; i < n; ++i)
+                    (*b)[i] = Blas::Dot(n - i, lu_.Row(i).Data() + i, &x[0] + i);
+                for (int i = n - 1; i > 0; --i)
+                    (*b)[i] += Blas::Dot(i, lu_.Row(i).Data(), &(*b)[0]);
+                PermuteBack(b);
+            }
+
+            void XMultiplyRight_af(const Vector_<>& x, Vector_<>* b) const override {
+                REQUIRE(x.size() == Size(), "Size should be compatible with x and the matrix");
+                const int n = Size();
+                // A^T x = U^T L^T P x
+                Vector_<> y(x);
+                Permute(&y);
+                for (int i = 0; i < n; ++i)
+                    Blas::Axpy(i, y[i], lu_.Row(i).Data(), &y[0]);
+                b->Resize(n);
+                b->Fill(0.0);
+                for (int i = 0; i < n; ++i)
+                    Blas::Axpy(n - i, y[i], lu_.Row(i).Data() + i, &(*b)[0] + i);
+            }
+
+            void XSolveLeft_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                *x = b;
+                Permute(x);
+                LSolve(x);
+                USolve(x);
+            }
+
+            void XSolveRight_af(const Vector_<>& b, Vector_<>* x) const override {
+                REQUIRE(b.size() == Size(), "Size should be compatible with b and the matrix");
+                *x = b;
+                UTransposeSolve(x);
+                LTransposeSolve(x);
+                PermuteBack(x);
+            }
+
+            void PermuteRows(Matrix_<>* bx, bool back) const {
+                for (int k = 0; k < Size(); ++k) {
+                    const int i = back ? Size() - 1 - k : k;
+                    if (piv_[i] != i)
+                        std::swap_ranges(bx->Row(i).begin(), bx->Row(i).end(), bx->Row(piv_[i]).begin());
+                }
+            }
+
+            void XSolveLeftInPlace(Matrix_<>* bx) const override {
+                PermuteRows(bx, false);
+                Blas::SolveLower(Size(), bx->Cols(), {lu_.Data(), lu_.Stride(), 1}, true, bx->Data(), bx->Stride());
+                Blas::SolveUpper(Size(), bx->Cols(), {lu_.Data(), lu_.Stride(), 1}, false, bx->Data(), bx->Stride());
+            }
+
+            void XSolveRightInPlace(Matrix_<>* bx) const override {
+                // U^T and L^T are read from the same storage with the strides swapped
+                Blas::SolveLower(Size(), bx->Cols(), {lu_.Data(), 1, lu_.Stride()}, false, bx->Data(), bx->Stride());
+                Blas::SolveUpper(Size(), bx->Cols(), {lu_.Data(), 1, lu_.Stride()}, true, bx->Data(), bx->Stride());
+                PermuteRows(bx, true);
+            }
+
+        public:
+            explicit LU_(const Matrix_<>& a);
+            int Size() const override { return static_cast<int>(piv_.size()); }
+        };
+
+        /*
+         * Right-looking blocked factorization: factor a panel of columns with row pivoting,
+         * solve for the corresponding block row of U, then update the trailing matrix by one Gemm
+         */
+        LU_::LU_(const Matrix_<>& a) : lu_(a), piv_(a.Rows()) {
+            const int n = a.Rows();
+            REQUIRE(a.Cols() == n, "LU decomposition requires a square matrix");
+            const ptrdiff_t ld = lu_.Stride();
+            for (int k0 = 0; k0 < n; k0 += LU_BLOCK) {
+                const int kEnd = Min(n, k0 + LU_BLOCK);
+                for (int j = k0; j < kEnd; ++j) {
+                    int p = j;
+                    for (int i = j + 1; i < n; ++i)
+                        if (std::fabs(lu_(i, j)) > std::fabs(lu_(p, j)))
+                            p = i;
+                    REQUIRE(!IsZero(lu_(p, j)), "Singular matrix in LU decomposition");
+                    piv_[j] = p;
+                    if (p != j)
+                        std::swap_ranges(lu_.Row(j).begin(), lu_.Row(j).end(), lu_.Row(p).begin());
+                    const double inv = 1.0 / lu_(j, j);
+                    for (int i = j + 1; i < n; ++i) {
+                        lu_(i, j) *= inv;
+                        // rank-1 update of the rest of the panel
+                        Blas::Axpy(kEnd - j - 1, -lu_(i, j), &lu_(j, j + 1), &lu_(i, j + 1));
+                    }
+                }
+                if (kEnd == n)
+                    break;
+                // U12 = L11^{-1} A12
+                for (int r = k0 + 1; r < kEnd; ++r)
+                    for (int c = k0; c < r; ++c)
+                        Blas::Axpy(n - kEnd, -lu_(r, c), &lu_(c, kEnd), &lu_(r, kEnd));
+                // A22 -= L21 U12
+                Blas::Gemm(n - kEnd, n - kEnd, kEnd - k0, {&lu_(kEnd, k0), ld, 1}, {&lu_(k0, kEnd), ld, 1}, &lu_(kEnd, kEnd),
+                           ld, -1.0, 1.0);
+            }
+        }
+    } // namespace
+
+    SquareMatrixDecomposition_* NewLU(const Matrix_<>& a) { return new LU_(a); }
+} // namespace Dal
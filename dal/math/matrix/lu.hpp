@@ -0,0 +1,12 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/matrix/decompositions.hpp>
+
+namespace Dal {
+    // dense LU decomposition with partial (row) pivoting, P A = L U
+    SquareMatrixDecomposition_* NewLU(const Matrix_<>& a);
+} // namespace Dal
@@ -1,4 +1,6 @@
 #include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/blas.hpp>
 #include <dal/math/matrix/matrixarithmetic.hpp>
 #include <dal/math/matrix/matrixs.hpp>
 #include <dal/platform/strict.hpp>
@@ -24,5 +26,64 @@ namespace Dal {
             }
             return ret_val;
         }
+
+        namespace {
+            // rows (or columns) handled by one task of a parallel matrix-vector product
+            constexpr int GEMV_CHUNK = 512;
+
+            Blas::Operand_ AsOperand(const Matrix_<>& a, bool transposed) {
+                return transposed ? Blas::Operand_{a.Data(), 1, a.Stride()} : Blas::Operand_{a.Data(), a.Stride(), 1};
+            }
+        } // namespace
+
+        void Multiply(const Matrix_<>& a, const Matrix_<>& b, Matrix_<>* c, ThreadPool_* pool) {
+            REQUIRE(c && c != &a && c != &b, "Multiply output must be distinct from its inputs");
+            REQUIRE(a.Cols() == b.Rows(), "Matrix dimensions do not match for product");
+            c->Resize(a.Rows(), b.Cols());
+            Blas::Gemm(a.Rows(), b.Cols(), a.Cols(), AsOperand(a, false), AsOperand(b, false), c->Data(), c->Stride(),
+                       1.0, 0.0, pool);
+        }
+
+        void MultiplyTransposed(const Matrix_<>& a, const Matrix_<>& b, Matrix_<>* c, ThreadPool_* pool) {
+            REQUIRE(c && c != &a && c != &b, "Multiply output must be distinct from its inputs");
+            REQUIRE(a.Rows() == b.Rows(), "Matrix dimensions do not match for transposed product");
+            c->Resize(a.Cols(), b.Cols());
+            Blas::Gemm(a.Cols(), b.Cols(), a.Rows(), AsOperand(a, true), AsOperand(b, false), c->Data(), c->Stride(),
+                       1.0, 0.0, pool);
+        }
+
+        void Gemv(const Matrix_<>& a, const Vector_<>& x, Vector_<>* y, bool transposed, ThreadPool_* pool) {
+            REQUIRE(y && y != &x, "Gemv output must be distinct from its input");
+            const int rows = a.Rows(), cols = a.Cols();
+            REQUIRE(static_cast<int>(x.size()) == (transposed ? rows : cols), "Vector size does not match matrix");
+            y->Resize(transposed ? cols : rows);
+            if (y->empty())
+                return;
+            double* py = &(*y)[0];
+            const double* px = x.empty() ? nullptr : &x[0];
+            if (!transposed) {
+                ParallelBlocks(pool, rows, GEMV_CHUNK, [&](int begin, int end) {
+                    for (int i = begin; i < end; ++i)
+                        py[i] = Blas::Dot(cols, a.Row(i).Data(), px);
+                });
+            } else {
+                // y = sum_i x_i * row_i, split over columns so that tasks write disjoint parts of y
+                ParallelBlocks(pool, cols, GEMV_CHUNK, [&](int begin, int end) {
+                    std::fill(py + begin, py + end, 0.0);
+                    for (int i = 0; i < rows; ++i)
+                        Blas::Axpy(end - begin, x[i], a.Row(i).Data() + begin, py + begin);
+                });
+            }
+        }
+
+        void AddOuterProduct(const Vector_<>& x, const Vector_<>& y, Matrix_<>* a, double alpha) {
+            REQUIRE(a, "Outer product destination must not be null");
+            REQUIRE(a->Rows() == static_cast<int>(x.size()) && a->Cols() == static_cast<int>(y.size()),
+                    "Vector sizes do not match matrix");
+            if (y.empty())
+                return;
+            for (int i = 0; i < a->Rows(); ++i)
+                Blas::Axpy(a->Cols(), alpha * x[i], &y[0], a->Row(i).Data());
+        }
     } // namespace Matrix
 } // namespace Dal
\ No newline at end of file
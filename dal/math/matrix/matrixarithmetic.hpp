@@ -8,7 +8,24 @@
 #include <dal/math/vectors.hpp>
 
 namespace Dal {
+    class ThreadPool_;
+
     namespace Matrix {
         Vector_<> Vols(const Matrix_<>& cov, Matrix_<>* corr = nullptr);
-    }
-} // namespace Dal
\ No newline at end of file
+
+        /*
+         * Dense products on the blocked, vectorised kernels of blas.hpp
+         * the output is resized and must not be one of the inputs
+         * large products are split over the pool when one is given
+         */
+
+        // c = a * b
+        void Multiply(const Matrix_<>& a, const Matrix_<>& b, Matrix_<>* c, ThreadPool_* pool = nullptr);
+        // c = a^T * b, e.g. the normal matrix X^T X of a regression
+        void MultiplyTransposed(const Matrix_<>& a, const Matrix_<>& b, Matrix_<>* c, ThreadPool_* pool = nullptr);
+        // y = a * x, or y = a^T * x if transposed
+        void Gemv(const Matrix_<>& a, const Vector_<>& x, Vector_<>* y, bool transposed = false, ThreadPool_* pool = nullptr);
+        // a += alpha * x * y^T
+        void AddOuterProduct(const Vector_<>& x, const Vector_<>& y, Matrix_<>* a, double alpha = 1.0);
+    } // namespace Matrix
+} // namespace Dal
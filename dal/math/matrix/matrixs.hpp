@@ -5,233 +5,369 @@
 #pragma once
 
 #include <dal/math/vectors.hpp>
+#include <dal/platform/aligned.hpp>
 #include <dal/utilities/algorithms.hpp>
+#include <iterator>
+#include <type_traits>
 
 namespace Dal {
-    template <class E_> class Matrix_ {
-        Vector_<E_> vals_;
+    /*
+     * Slices -- ephemeral views of a row or a column, carrying a raw pointer
+     * a span is contiguous (stride 1) and iterates with plain pointers
+     * a strided slice steps through the storage with a fixed stride
+     */
+
+    template <class E_> class ConstSpan_ {
+    protected:
+        E_* begin_;
+        int size_;
+
+    public:
+        using value_type = std::remove_const_t<E_>;
+        using const_iterator = const E_*;
+
+        ConstSpan_(E_* begin, E_* end) : begin_(begin), size_(static_cast<int>(end - begin)) {}
+        ConstSpan_(E_* begin, int size) : begin_(begin), size_(size) {}
+
+        const_iterator begin() const { return begin_; }
+        const_iterator end() const { return begin_ + size_; }
+        int size() const { return size_; }
+        const E_& operator[](int i) const { return begin_[i]; }
+        const E_& front() const { return *begin_; }
+        const E_& back() const { return begin_[size_ - 1]; }
+        const E_* Data() const { return begin_; }
+        static constexpr ptrdiff_t Stride() { return 1; }
+    };
+
+    template <class E_> struct Span_ : ConstSpan_<E_> {
+        using iterator = E_*;
+        using const_iterator = typename ConstSpan_<E_>::const_iterator;
+        Span_(E_* begin, E_* end) : ConstSpan_<E_>(begin, end) {}
+        Span_(E_* begin, int size) : ConstSpan_<E_>(begin, size) {}
+
+        // have to double-implement begin/end, otherwise non-const implementations hide the inherited const
+        iterator begin() { return this->begin_; }
+        const_iterator begin() const { return this->begin_; }
+        iterator end() { return this->begin_ + this->size_; }
+        const_iterator end() const { return this->begin_ + this->size_; }
+        E_& operator[](int i) { return this->begin_[i]; }
+        const E_& operator[](int i) const { return this->begin_[i]; }
+        E_* Data() { return this->begin_; }
+        const E_* Data() const { return this->begin_; }
+
+        // writes through the view; the view itself is not rebound
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> Span_& operator=(const X_& src) {
+            Expr::Assign(this, src);
+            return *this;
+        }
+        template <class T_> void operator+=(const T_& shift) { Expr::AddTo(this, shift); }
+        template <class T_> void operator-=(const T_& shift) { Expr::SubtractFrom(this, shift); }
+        template <class T_> void operator*=(const T_& scale) { Expr::MultiplyBy(this, scale); }
+    };
+
+    // random-access iterator stepping by a fixed stride; E_ may be const
+    template <class E_> class StridedIterator_ {
+        E_* val_;
+        ptrdiff_t stride_;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<E_>;
+        using difference_type = ptrdiff_t;
+        using pointer = E_*;
+        using reference = E_&;
+
+        StridedIterator_() : val_(nullptr), stride_(1) {}
+        StridedIterator_(E_* val, ptrdiff_t stride) : val_(val), stride_(stride) {}
+        // mutable to const conversion
+        template <class F_, class = std::enable_if_t<std::is_convertible_v<F_*, E_*>>>
+        StridedIterator_(const StridedIterator_<F_>& src) : val_(src.Base()), stride_(src.Stride()) {}
+
+        E_* Base() const { return val_; }
+        ptrdiff_t Stride() const { return stride_; }
+
+        reference operator*() const { return *val_; }
+        pointer operator->() const { return val_; }
+        reference operator[](difference_type n) const { return val_[n * stride_]; }
+
+        StridedIterator_& operator++() {
+            val_ += stride_;
+            return *this;
+        }
+        StridedIterator_ operator++(int) {
+            StridedIterator_ ret(*this);
+            val_ += stride_;
+            return ret;
+        }
+        StridedIterator_& operator--() {
+            val_ -= stride_;
+            return *this;
+        }
+        StridedIterator_ operator--(int) {
+            StridedIterator_ ret(*this);
+            val_ -= stride_;
+            return ret;
+        }
+        StridedIterator_& operator+=(difference_type n) {
+            val_ += n * stride_;
+            return *this;
+        }
+        StridedIterator_& operator-=(difference_type n) {
+            val_ -= n * stride_;
+            return *this;
+        }
+        StridedIterator_ operator+(difference_type n) const { return StridedIterator_(val_ + n * stride_, stride_); }
+        StridedIterator_ operator-(difference_type n) const { return StridedIterator_(val_ - n * stride_, stride_); }
+        friend StridedIterator_ operator+(difference_type n, const StridedIterator_& it) { return it + n; }
+        difference_type operator-(const StridedIterator_& rhs) const { return (val_ - rhs.val_) / stride_; }
+
+        bool operator==(const StridedIterator_& rhs) const { return val_ == rhs.val_; }
+        bool operator!=(const StridedIterator_& rhs) const { return val_ != rhs.val_; }
+        bool operator<(const StridedIterator_& rhs) const { return val_ < rhs.val_; }
+        bool operator>(const StridedIterator_& rhs) const { return val_ > rhs.val_; }
+        bool operator<=(const StridedIterator_& rhs) const { return val_ <= rhs.val_; }
+        bool operator>=(const StridedIterator_& rhs) const { return val_ >= rhs.val_; }
+    };
+
+    template <class E_> class ConstStrided_ {
+    protected:
+        E_* begin_;
+        size_t size_;
+        ptrdiff_t stride_;
+
+    public:
+        using value_type = std::remove_const_t<E_>;
+        using iterator = StridedIterator_<E_>;
+        using const_iterator = StridedIterator_<const E_>;
+
+        ConstStrided_(E_* begin, size_t size, ptrdiff_t stride) : begin_(begin), size_(size), stride_(stride) {}
+
+        const_iterator begin() const { return const_iterator(begin_, stride_); }
+        const_iterator end() const { return const_iterator(begin_ + size_ * stride_, stride_); }
+        size_t size() const { return size_; }
+        const E_& operator[](int i) const { return begin_[i * stride_]; }
+        const E_& front() const { return *begin_; }
+        const E_& back() const { return begin_[(size_ - 1) * stride_]; }
+        const E_* Data() const { return begin_; }
+        ptrdiff_t Stride() const { return stride_; }
+    };
+
+    template <class E_> struct Strided_ : ConstStrided_<E_> {
+        using iterator = typename ConstStrided_<E_>::iterator;
+        using const_iterator = typename ConstStrided_<E_>::const_iterator;
+        Strided_(E_* begin, size_t size, ptrdiff_t stride) : ConstStrided_<E_>(begin, size, stride) {}
+
+        iterator begin() { return iterator(this->begin_, this->stride_); }
+        const_iterator begin() const { return ConstStrided_<E_>::begin(); }
+        iterator end() { return iterator(this->begin_ + this->size_ * this->stride_, this->stride_); }
+        const_iterator end() const { return ConstStrided_<E_>::end(); }
+        E_& operator[](int i) { return this->begin_[i * this->stride_]; }
+        const E_& operator[](int i) const { return this->begin_[i * this->stride_]; }
+        E_* Data() { return this->begin_; }
+        const E_* Data() const { return this->begin_; }
+
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> Strided_& operator=(const X_& src) {
+            Expr::Assign(this, src);
+            return *this;
+        }
+        template <class T_> void operator+=(const T_& shift) { Expr::AddTo(this, shift); }
+        template <class T_> void operator-=(const T_& shift) { Expr::SubtractFrom(this, shift); }
+        template <class T_> void operator*=(const T_& scale) { Expr::MultiplyBy(this, scale); }
+    };
+
+    namespace Expr {
+        template <class E_> struct IsArray_<ConstSpan_<E_>> : std::true_type {};
+        template <class E_> struct IsArray_<Span_<E_>> : std::true_type {};
+        template <class E_> struct IsArray_<ConstStrided_<E_>> : std::true_type {};
+        template <class E_> struct IsArray_<Strided_<E_>> : std::true_type {};
+    } // namespace Expr
+
+    /*
+     * Dense matrix in a single cache-aligned buffer, element (i, j) at i * Cols() + j (row-major)
+     * or at j * Rows() + i (column-major); the slices along the storage order are contiguous spans
+     */
+
+    template <class E_, MatrixLayout_ L_> class Matrix_ {
+        static constexpr bool ROW_MAJOR = L_ == MatrixLayout_::ROW_MAJOR;
+        std::vector<E_, AlignedAllocator_<E_>> vals_;
+        int rows_;
         int cols_;
-        using I_ = typename Vector_<E_>::iterator;
-        using CI_ = typename Vector_<E_>::const_iterator;
-        using R_ = typename Vector_<E_>::reference;
-        using CR_ = typename Vector_<E_>::const_reference;
-        Vector_<I_> hooks_;
 
-        void SetHook(size_t from = 0);
+        // extents in storage order: the outer (major) index selects a contiguous run of Minor() elements
+        size_t Major() const { return static_cast<size_t>(ROW_MAJOR ? rows_ : cols_); }
+        size_t Minor() const { return static_cast<size_t>(ROW_MAJOR ? cols_ : rows_); }
+        size_t Offset(int row, int col) const {
+            return ROW_MAJOR ? static_cast<size_t>(row) * cols_ + col : static_cast<size_t>(col) * rows_ + row;
+        }
+        E_* Begin() const { return const_cast<E_*>(vals_.data()); }
+        void Reshape(size_t n_major, size_t n_minor);
+
+        // op(element, src element) in storage order; src is a scalar or conforms to this
+        template <class X_, class OP_> void ForEach(const X_& src, OP_ op) {
+            Expr::RequireConform(Expr::Conform(*this, src));
+            if constexpr (ROW_MAJOR) {
+                for (int i = 0; i < rows_; ++i)
+                    for (int j = 0; j < cols_; ++j)
+                        op(vals_[Offset(i, j)], Expr::At(src, i, j));
+            } else {
+                for (int j = 0; j < cols_; ++j)
+                    for (int i = 0; i < rows_; ++i)
+                        op(vals_[Offset(i, j)], Expr::At(src, i, j));
+            }
+        }
 
     public:
+        static constexpr MatrixLayout_ LAYOUT = L_;
+        using ConstRow_ = std::conditional_t<ROW_MAJOR, ConstSpan_<E_>, ConstStrided_<E_>>;
+        using Row_ = std::conditional_t<ROW_MAJOR, Span_<E_>, Strided_<E_>>;
+        using ConstCol_ = std::conditional_t<ROW_MAJOR, ConstStrided_<E_>, ConstSpan_<E_>>;
+        using Col_ = std::conditional_t<ROW_MAJOR, Strided_<E_>, Span_<E_>>;
+
         virtual ~Matrix_() = default;
-        Matrix_() : cols_(0) {}
-        Matrix_(int rows, int cols)
-            : vals_(static_cast<size_t>(rows * cols)), cols_(cols), hooks_(static_cast<size_t>(rows)) {
-            SetHook();
-            vals_.Fill(E_());
+        Matrix_() : rows_(0), cols_(0) {}
+        Matrix_(int rows, int cols) : vals_(static_cast<size_t>(rows) * cols, E_()), rows_(rows), cols_(cols) {}
+        Matrix_(const Matrix_& src) = default;
+        // evaluates an expression of expressions.hpp in a single pass
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>>
+        Matrix_(const X_& src) : Matrix_(src.Rows(), src.Cols()) {
+            ForEach(src, [](E_& d, const auto& s) { d = s; });
         }
-        Matrix_(const Matrix_& src) : vals_(src.vals_), cols_(src.cols_), hooks_(src.hooks_.size()) { SetHook(); }
 
-        int Rows() const { return static_cast<int>(hooks_.size()); }
+        int Rows() const { return rows_; }
         int Cols() const { return cols_; }
         bool Empty() const { return vals_.empty(); }
         void Clear() {
             vals_.clear();
-            cols_ = 0;
-            hooks_.clear();
+            rows_ = cols_ = 0;
         }
-        CI_ First() const { return vals_.begin(); }
-        CI_ Last() const { return vals_.end(); }
+        // raw storage, with distance Stride() between consecutive rows (row-major) or columns (column-major)
+        const E_* First() const { return vals_.data(); }
+        const E_* Last() const { return vals_.data() + vals_.size(); }
+        E_* Data() { return vals_.data(); }
+        const E_* Data() const { return vals_.data(); }
+        int Stride() const { return static_cast<int>(Minor()); }
 
-        CR_ operator()(int row, int col) const { return hooks_[row][col]; }
-        R_ operator()(int row, int col) { return hooks_[row][col]; }
+        const E_& operator()(int row, int col) const { return vals_[Offset(row, col)]; }
+        E_& operator()(int row, int col) { return vals_[Offset(row, col)]; }
 
         // move operators
         void swap(Matrix_& rhs) noexcept {
             std::swap(vals_, rhs.vals_);
+            std::swap(rows_, rhs.rows_);
             std::swap(cols_, rhs.cols_);
-            std::swap(hooks_, rhs.hooks_);
         }
 
-        Matrix_(Matrix_&& rhs) noexcept { swap(rhs); }
+        Matrix_(Matrix_&& rhs) noexcept : rows_(0), cols_(0) { swap(rhs); }
 
         Matrix_& operator=(Matrix_&& rhs) noexcept {
             if (this != &rhs) {
-                Matrix_<E_> temp(std::move(rhs));
+                Matrix_ temp(std::move(rhs));
                 swap(temp);
             }
             return *this;
         }
 
-        Matrix_& operator=(const Matrix_& rhs) noexcept {
+        Matrix_& operator=(const Matrix_& rhs) {
             if (this != &rhs) {
                 vals_ = rhs.vals_;
+                rows_ = rhs.rows_;
                 cols_ = rhs.cols_;
-                hooks_ = Vector_<I_>(rhs.hooks_.size());
-                SetHook();
             }
             return *this;
         }
 
-        // slices -- ephemeral containers of rows or columns
-        class ConstRow_ {
-        protected:
-            I_ begin_;
-            I_ end_;
-
-        public:
-            using value_type = E_;
-            using const_iterator = typename Vector_<E_>::const_iterator;
-
-            ConstRow_(I_ begin, I_ end) : begin_(begin), end_(end) {}
-            ConstRow_(I_ begin, int size) : begin_(begin), end_(begin + size) {}
-
-            const_iterator begin() const { return begin_; }
-            const_iterator end() const { return end_; }
-            int size() const { return static_cast<int>(end_ - begin_); }
-            const E_& operator[](int col) const { return *(begin_ + col); }
-            const E_& front() const { return *begin_; }
-            const E_& back() const { return *(end_ - 1); }
-        };
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> Matrix_& operator=(const X_& src) {
+            Resize(src.Rows(), src.Cols());
+            ForEach(src, [](E_& d, const auto& s) { d = s; });
+            return *this;
+        }
 
-        ConstRow_ Row(int i_row) const { return ConstRow_(hooks_[i_row], cols_); }
+        ConstRow_ Row(int i_row) const {
+            if constexpr (ROW_MAJOR)
+                return ConstRow_(Begin() + Offset(i_row, 0), cols_);
+            else
+                return ConstRow_(Begin() + i_row, cols_, rows_);
+        }
         ConstRow_ operator[](int i_row) const { return Row(i_row); }
 
-        struct Row_ : ConstRow_ {
-            using iterator = I_;
-            using const_iterator = typename ConstRow_::const_iterator;
-            Row_(I_ begin, I_ end) : ConstRow_(begin, end) {}
-            Row_(I_ begin, int size) : ConstRow_(begin, size) {}
-
-            // have to double-implement begin/end, otherwise non-const implementations hide the inherited const
-            iterator begin() { return ConstRow_::begin_; }
-            const_iterator begin() const { return ConstRow_::begin_; }
-            iterator end() { return ConstRow_::end_; }
-            const_iterator end() const { return ConstRow_::end_; }
-            E_& operator[](int col) { return *(ConstRow_::begin_ + col); }
-            const E_& operator[](int col) const { return *(ConstRow_::begin_ + col); }
-        };
-
-        Row_ Row(int i_row) { return Row_(hooks_[i_row], cols_); }
+        Row_ Row(int i_row) {
+            if constexpr (ROW_MAJOR)
+                return Row_(Begin() + Offset(i_row, 0), cols_);
+            else
+                return Row_(Begin() + i_row, cols_, rows_);
+        }
         Row_ operator[](int i_row) { return Row(i_row); }
 
-        // Iteration through columns is less efficient
-        class ConstCol_ {
-        public:
-            template <typename RI_>
-            struct Iterator_ // column iterator in terms of row iterator
-            {
-                RI_ val_;
-                size_t stride_;
-                Iterator_(RI_ val, size_t stride) : val_(val), stride_(stride) {}
-                Iterator_& operator++() {
-                    val_ += stride_;
-                    return *this;
-                }
-                Iterator_ operator++(int) {
-                    Iterator_ ret(*this);
-                    val_ += stride_;
-                    return ret;
-                }
-                Iterator_& operator--() {
-                    val_ -= stride_;
-                    return *this;
-                }
-                Iterator_ operator--(int) {
-                    Iterator_ ret(*this);
-                    val_ -= stride_;
-                    return ret;
-                }
-                Iterator_ operator+(size_t inc) {
-                    Iterator_ ret(*this);
-                    ret.val_ += inc * stride_;
-                    return ret;
-                }
-                typename RI_::reference operator*() { return *val_; }
-                bool operator==(const Iterator_& rhs) const {
-                    REQUIRE(stride_ == rhs.stride_, "lhs stride size should be same with rhs");
-                    return val_ == rhs.val_;
-                }
-                bool operator!=(const Iterator_& rhs) const { return !this->operator==(rhs); }
-                bool operator<(const Iterator_& rhs) const { return val_ < rhs.val_; }
-                typename RI_::difference_type operator-(const Iterator_& rhs) const {
-                    REQUIRE(stride_ == rhs.stride_, "lhs stride size should be same with rhs");
-                    REQUIRE((val_ - rhs.val_) % stride_ == 0, "lhs and rhs should be in same column");
-                    return (val_ - rhs.val_) / stride_;
-                }
-                using iterator_category = typename std::vector<E_>::iterator::iterator_category;
-                using difference_type = typename std::vector<E_>::iterator::difference_type;
-                using value_type = E_;
-                using reference = const E_&;
-                using pointer = const E_*;
-            };
-            using iterator = Iterator_<typename Vector_<E_>::iterator>;
-
-        protected:
-            iterator begin_; // non-const to support Column_, below
-            size_t size_;
-
-        public:
-            using value_type = E_;
-            using const_iterator = Iterator_<typename Vector_<E_>::const_iterator>;
-            ConstCol_(I_ begin, size_t size, size_t stride) : begin_(begin, stride), size_(size) {}
-
-            const_iterator begin() const { return const_iterator(begin_.val_, begin_.stride_); }
-            const_iterator end() const { return const_iterator(begin_.val_ + size_ * begin_.stride_, begin_.stride_); }
-            size_t size() const { return size_; }
-            const E_& operator[](int row) const { return *(begin_.val_ + row * begin_.stride_); }
-        };
-        ConstCol_ Col(int i_col) const { return ConstCol_(hooks_[0] + i_col, hooks_.size(), cols_); }
-
-        class Col_ : ConstCol_ {
-            using iterator = typename ConstCol_::iterator;
-            using ConstCol_::begin_;
-            using ConstCol_::size_;
-
-        public:
-            using value_type = E_;
-            Col_(I_ begin, size_t size, size_t stride) : ConstCol_(begin, size, stride) {}
-
-            iterator begin() const { return begin_; }
-            iterator end() const { return iterator(begin_.val_ + size_ * begin_.stride_, begin_.stride_); }
-            E_& operator[](int row) { return *(begin_.val_ + row * begin_.stride_); }
-
-            using ConstCol_::size;
-        };
-        Col_ Col(int i_col) { return Col_(hooks_[0] + i_col, hooks_.size(), cols_); }
+        ConstCol_ Col(int i_col) const {
+            if constexpr (ROW_MAJOR)
+                return ConstCol_(Begin() + i_col, rows_, cols_);
+            else
+                return ConstCol_(Begin() + Offset(0, i_col), rows_);
+        }
+
+        Col_ Col(int i_col) {
+            if constexpr (ROW_MAJOR)
+                return Col_(Begin() + i_col, rows_, cols_);
+            else
+                return Col_(Begin() + Offset(0, i_col), rows_);
+        }
 
         // POSTPONED -- sub-matrix
-        void Swap(Matrix_<E_>* other) {
+        void Swap(Matrix_* other) {
             REQUIRE(other != nullptr, "can't swap with null");
-            vals_.Swap(&other->vals_);
-            hooks_.Swap(&other->hooks_);
-            std::swap(cols_, other->cols_);
-            REQUIRE(hooks_.front() == vals_.begin(), "hooks front should be same with vals begin");
+            swap(*other);
         }
 
-        void Fill(const E_& val) { vals_.Fill(val); }
+        void Fill(const E_& val) { std::fill(vals_.begin(), vals_.end(), val); }
 
-        template <class T_> void operator*=(const T_& scale) { vals_ *= scale; }
+        // scalars, matrices or expressions
+        template <class T_> void operator*=(const T_& scale) {
+            ForEach(scale, [](E_& d, const auto& s) { d *= s; });
+        }
+        template <class T_> void operator+=(const T_& shift) {
+            ForEach(shift, [](E_& d, const auto& s) { d += s; });
+        }
+        template <class T_> void operator-=(const T_& shift) {
+            ForEach(shift, [](E_& d, const auto& s) { d -= s; });
+        }
 
+        // keeps the overlapping block, new elements are default; reuses the buffer when it is large enough
         void Resize(int rows, int cols) {
-            const auto old_rows = hooks_.size();
-            if (cols == cols_ && rows * old_rows > 0) {
-                vals_.Resize(rows * cols);
-                hooks_.Resize(rows);
-                SetHook(hooks_[0] == vals_.begin() ? old_rows : 0);
-            } else {
-                const auto n_copy = Min(cols, cols_);
-                cols_ = cols;
-                Vector_<E_> new_vals(rows * cols);
-                for (int ir = 0; ir < rows && ir < old_rows; ++ir) {
-                    copy(hooks_[ir], hooks_[ir] + n_copy, new_vals.begin() + ir * cols);
-                }
-                vals_.Swap(&new_vals);
-                hooks_.Resize(rows);
-                SetHook();
-            }
+            if constexpr (ROW_MAJOR)
+                Reshape(rows, cols);
+            else
+                Reshape(cols, rows);
+            rows_ = rows;
+            cols_ = cols;
         }
     };
 
-    template <class E_> void Matrix_<E_>::SetHook(size_t from) {
-        for (auto ii = from; ii < hooks_.size(); ++ii)
-            hooks_[ii] = vals_.begin() + ii * cols_;
+    namespace Expr {
+        template <class E_, MatrixLayout_ L_> struct IsArray_<Matrix_<E_, L_>> : std::true_type {};
+    } // namespace Expr
+
+    template <class E_, MatrixLayout_ L_> void Matrix_<E_, L_>::Reshape(size_t n_major, size_t n_minor) {
+        const size_t oldMinor = Minor();
+        const size_t nKeep = Min(Major(), n_major);
+        const size_t newSize = n_major * n_minor;
+        if (n_minor == oldMinor) {
+            vals_.resize(newSize);
+        } else if (n_minor < oldMinor) {
+            // compact runs towards the front
+            auto b = vals_.begin();
+            for (size_t m = 1; m < nKeep; ++m)
+                std::move(b + m * oldMinor, b + m * oldMinor + n_minor, b + m * n_minor);
+            std::fill(b + nKeep * n_minor, b + Min(vals_.size(), newSize), E_());
+            vals_.resize(newSize);
+        } else {
+            // spread runs out, starting from the back
+            vals_.resize(newSize);
+            auto b = vals_.begin();
+            for (size_t m = nKeep; m-- > 0;) {
+                if (m > 0)
+                    std::move_backward(b + m * oldMinor, b + (m + 1) * oldMinor, b + m * n_minor + oldMinor);
+                std::fill(b + m * n_minor + oldMinor, b + (m + 1) * n_minor, E_());
+            }
+        }
     }
 } // namespace Dal
@@ -2,6 +2,7 @@
 // Created by wegam on 2021/2/22.
 //
 
+#include <dal/math/matrix/matrixarithmetic.hpp>
 #include <dal/math/matrix/sparse.hpp>
 #include <dal/math/matrix/squarematrix.hpp>
 #include <dal/platform/platform.hpp>
@@ -9,19 +10,20 @@
 #include <dal/utilities/numerics.hpp>
 
 namespace Dal::Sparse {
-    // brute-force implementation
+    // generic implementation: one batched solve for all rows of J, then one product
     void SymmetricDecomposition_::QForm(const Matrix_<>& j_mat, SquareMatrix_<>* dst) const {
-        dst->Resize(j_mat.Rows());
-
-        Vector_<> wij;
-        Vector_<> row(j_mat.Cols());
+        REQUIRE(j_mat.Cols() == Size(), "j_mat size should match with this matrix's size");
+        Matrix_<> x(j_mat.Cols(), j_mat.Rows());
+        for (int ii = 0; ii < j_mat.Rows(); ++ii)
+            std::copy(j_mat[ii].begin(), j_mat[ii].end(), x.Col(ii).begin());
+        Solve(x, &x);
+        Matrix_<> form;
+        Matrix::Multiply(j_mat, x, &form);
 
-        for (int ii = 0; ii < j_mat.Rows(); ++ii) {
-            Copy(j_mat.Row(ii), &row);
-            Solve(row, &wij);
+        dst->Resize(j_mat.Rows());
+        for (int ii = 0; ii < j_mat.Rows(); ++ii)
             for (int jj = 0; jj <= ii; ++jj)
-                (*dst)(ii, jj) = (*dst)(jj, ii) = InnerProduct(wij, j_mat.Row(jj));
-        }
+                (*dst)(ii, jj) = (*dst)(jj, ii) = form(ii, jj);
     }
 
     SymmetricDecomposition_* Square_::DecomposeSymmetric() const {
@@ -13,11 +13,23 @@ namespace Dal {
     public:
         SquareMatrix_() = default;
         SquareMatrix_(int size) : val_(size, size) {}
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> SquareMatrix_(const X_& src) {
+            *this = src;
+        }
         void Resize(int size) { val_.Resize(size, size); }
 
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> SquareMatrix_& operator=(const X_& src) {
+            REQUIRE(src.Rows() == src.Cols(), "Square matrix can't be assigned from a non-square expression");
+            val_ = src;
+            return *this;
+        }
+        template <class T_> void operator*=(const T_& scale) { val_ *= scale; }
+        template <class T_> void operator+=(const T_& shift) { val_ += shift; }
+        template <class T_> void operator-=(const T_& shift) { val_ -= shift; }
+
         operator const Matrix_<E_>&() const { return val_; };
-        double& operator()(int i_row, int j_col) { return val_(i_row, j_col); }
-        const double& operator()(int i_row, int j_col) const { return val_(i_row, j_col); }
+        E_& operator()(int i_row, int j_col) { return val_(i_row, j_col); }
+        const E_& operator()(int i_row, int j_col) const { return val_(i_row, j_col); }
 
         int Rows() const { return val_.Rows(); }
         typename Matrix_<E_>::Row_ Row(int ii) { return val_.Row(ii); }
@@ -27,6 +39,10 @@ namespace Dal {
         typename Matrix_<E_>::ConstCol_ Col(int ii) const { return val_.Col(ii); }
     };
 
+    namespace Expr {
+        template <class E_> struct IsArray_<SquareMatrix_<E_>> : std::true_type {};
+    } // namespace Expr
+
     namespace SquareMatrix {
         template <class E_> SquareMatrix_<E_> M1x1(const E_& val) {
             SquareMatrix_<E_> ret_val(1);
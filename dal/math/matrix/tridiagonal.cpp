@@ -0,0 +1,419 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/tridiagonal.hpp>
+#include <dal/platform/simd.hpp>
+#include <dal/utilities/algorithms.hpp>
+#if DAL_SIMD_X86
+#include <immintrin.h>
+#endif
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace {
+        // systems swept together: small enough that their rows stay in cache between the forward and backward sweeps
+        constexpr int TRI_BLOCK = 64;
+
+        /*
+         * Kernels for lanes [0, w); coefficients, factors and x each have their own leading dimension
+         * Eliminate: inv_i = 1 / (d_i - a_i up_{i-1}), up_i = c_i inv_i; returns false if any pivot IsZero
+         * Substitute: x_i = (x_i - a_i x_{i-1}) inv_i going down, then x_i -= up_i x_{i+1} going up
+         * the vector versions require w to be a multiple of their width
+         */
+
+        bool EliminateScalar(int n,
+                             int w,
+                             const double* a,
+                             const double* d,
+                             const double* c,
+                             ptrdiff_t ld,
+                             double* inv,
+                             double* up,
+                             ptrdiff_t ldf) {
+            bool singular = false;
+            for (int s = 0; s < w; ++s) {
+                singular |= IsZero(d[s]);
+                inv[s] = 1.0 / d[s];
+                up[s] = c[s] * inv[s];
+            }
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *di = d + i * ld, *ci = c + i * ld;
+                double *invi = inv + i * ldf, *upi = up + i * ldf;
+                const double* upPrev = upi - ldf;
+                for (int s = 0; s < w; ++s) {
+                    const double piv = di[s] - ai[s] * upPrev[s];
+                    singular |= IsZero(piv);
+                    invi[s] = 1.0 / piv;
+                    upi[s] = ci[s] * invi[s];
+                }
+            }
+            return !singular;
+        }
+
+        void SubstituteScalar(int n,
+                              int w,
+                              const double* a,
+                              ptrdiff_t ld,
+                              const double* inv,
+                              const double* up,
+                              ptrdiff_t ldf,
+                              double* x,
+                              ptrdiff_t ldx) {
+            for (int s = 0; s < w; ++s)
+                x[s] *= inv[s];
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *invi = inv + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; ++s)
+                    xi[s] = (xi[s] - ai[s] * xPrev[s]) * invi[s];
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                const double* upi = up + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; ++s)
+                    xi[s] -= upi[s] * xNext[s];
+            }
+        }
+
+        // as Substitute, with one set of coefficients for every lane
+        void SubstituteSharedScalar(
+            int n, int w, const double* a, const double* inv, const double* up, double* x, ptrdiff_t ldx) {
+            for (int s = 0; s < w; ++s)
+                x[s] *= inv[0];
+            for (int i = 1; i < n; ++i) {
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; ++s)
+                    xi[s] = (xi[s] - a[i] * xPrev[s]) * inv[i];
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; ++s)
+                    xi[s] -= up[i] * xNext[s];
+            }
+        }
+
+#if DAL_SIMD_X86
+        DAL_TARGET_AVX2 bool EliminateAvx2(int n,
+                                           int w,
+                                           const double* a,
+                                           const double* d,
+                                           const double* c,
+                                           ptrdiff_t ld,
+                                           double* inv,
+                                           double* up,
+                                           ptrdiff_t ldf) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d eps = _mm256_set1_pd(EPSILON), sign = _mm256_set1_pd(-0.0);
+            __m256d singular = _mm256_setzero_pd(); // lanes where some pivot IsZero
+            for (int s = 0; s < w; s += 4) {
+                const __m256d piv = _mm256_loadu_pd(d + s);
+                singular = _mm256_or_pd(singular, _mm256_cmp_pd(_mm256_andnot_pd(sign, piv), eps, _CMP_LT_OQ));
+                const __m256d v = _mm256_div_pd(one, piv);
+                _mm256_storeu_pd(inv + s, v);
+                _mm256_storeu_pd(up + s, _mm256_mul_pd(_mm256_loadu_pd(c + s), v));
+            }
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *di = d + i * ld, *ci = c + i * ld;
+                double *invi = inv + i * ldf, *upi = up + i * ldf;
+                const double* upPrev = upi - ldf;
+                for (int s = 0; s < w; s += 4) {
+                    const __m256d piv = _mm256_fnmadd_pd(_mm256_loadu_pd(ai + s), _mm256_loadu_pd(upPrev + s),
+                                                         _mm256_loadu_pd(di + s));
+                    singular = _mm256_or_pd(singular, _mm256_cmp_pd(_mm256_andnot_pd(sign, piv), eps, _CMP_LT_OQ));
+                    const __m256d v = _mm256_div_pd(one, piv);
+                    _mm256_storeu_pd(invi + s, v);
+                    _mm256_storeu_pd(upi + s, _mm256_mul_pd(_mm256_loadu_pd(ci + s), v));
+                }
+            }
+            return !_mm256_movemask_pd(singular);
+        }
+
+        DAL_TARGET_AVX2 void SubstituteAvx2(int n,
+                                            int w,
+                                            const double* a,
+                                            ptrdiff_t ld,
+                                            const double* inv,
+                                            const double* up,
+                                            ptrdiff_t ldf,
+                                            double* x,
+                                            ptrdiff_t ldx) {
+            for (int s = 0; s < w; s += 4)
+                _mm256_storeu_pd(x + s, _mm256_mul_pd(_mm256_loadu_pd(x + s), _mm256_loadu_pd(inv + s)));
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *invi = inv + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; s += 4) {
+                    const __m256d y = _mm256_fnmadd_pd(_mm256_loadu_pd(ai + s), _mm256_loadu_pd(xPrev + s),
+                                                       _mm256_loadu_pd(xi + s));
+                    _mm256_storeu_pd(xi + s, _mm256_mul_pd(y, _mm256_loadu_pd(invi + s)));
+                }
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                const double* upi = up + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; s += 4) {
+                    const __m256d y = _mm256_fnmadd_pd(_mm256_loadu_pd(upi + s), _mm256_loadu_pd(xNext + s),
+                                                       _mm256_loadu_pd(xi + s));
+                    _mm256_storeu_pd(xi + s, y);
+                }
+            }
+        }
+
+        DAL_TARGET_AVX2 void SubstituteSharedAvx2(
+            int n, int w, const double* a, const double* inv, const double* up, double* x, ptrdiff_t ldx) {
+            const __m256d inv0 = _mm256_set1_pd(inv[0]);
+            for (int s = 0; s < w; s += 4)
+                _mm256_storeu_pd(x + s, _mm256_mul_pd(_mm256_loadu_pd(x + s), inv0));
+            for (int i = 1; i < n; ++i) {
+                const __m256d ai = _mm256_set1_pd(a[i]), invi = _mm256_set1_pd(inv[i]);
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; s += 4) {
+                    const __m256d y = _mm256_fnmadd_pd(ai, _mm256_loadu_pd(xPrev + s), _mm256_loadu_pd(xi + s));
+                    _mm256_storeu_pd(xi + s, _mm256_mul_pd(y, invi));
+                }
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                const __m256d upi = _mm256_set1_pd(up[i]);
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; s += 4) {
+                    const __m256d y = _mm256_fnmadd_pd(upi, _mm256_loadu_pd(xNext + s), _mm256_loadu_pd(xi + s));
+                    _mm256_storeu_pd(xi + s, y);
+                }
+            }
+        }
+
+        DAL_TARGET_AVX512 bool EliminateAvx512(int n,
+                                               int w,
+                                               const double* a,
+                                               const double* d,
+                                               const double* c,
+                                               ptrdiff_t ld,
+                                               double* inv,
+                                               double* up,
+                                               ptrdiff_t ldf) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d eps = _mm512_set1_pd(EPSILON);
+            __mmask8 singular = 0; // lanes where some pivot IsZero
+            for (int s = 0; s < w; s += 8) {
+                const __m512d piv = _mm512_loadu_pd(d + s);
+                singular |= _mm512_cmp_pd_mask(_mm512_abs_pd(piv), eps, _CMP_LT_OQ);
+                const __m512d v = _mm512_div_pd(one, piv);
+                _mm512_storeu_pd(inv + s, v);
+                _mm512_storeu_pd(up + s, _mm512_mul_pd(_mm512_loadu_pd(c + s), v));
+            }
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *di = d + i * ld, *ci = c + i * ld;
+                double *invi = inv + i * ldf, *upi = up + i * ldf;
+                const double* upPrev = upi - ldf;
+                for (int s = 0; s < w; s += 8) {
+                    const __m512d piv = _mm512_fnmadd_pd(_mm512_loadu_pd(ai + s), _mm512_loadu_pd(upPrev + s),
+                                                         _mm512_loadu_pd(di + s));
+                    singular |= _mm512_cmp_pd_mask(_mm512_abs_pd(piv), eps, _CMP_LT_OQ);
+                    const __m512d v = _mm512_div_pd(one, piv);
+                    _mm512_storeu_pd(invi + s, v);
+                    _mm512_storeu_pd(upi + s, _mm512_mul_pd(_mm512_loadu_pd(ci + s), v));
+                }
+            }
+            return !singular;
+        }
+
+        DAL_TARGET_AVX512 void SubstituteAvx512(int n,
+                                                int w,
+                                                const double* a,
+                                                ptrdiff_t ld,
+                                                const double* inv,
+                                                const double* up,
+                                                ptrdiff_t ldf,
+                                                double* x,
+                                                ptrdiff_t ldx) {
+            for (int s = 0; s < w; s += 8)
+                _mm512_storeu_pd(x + s, _mm512_mul_pd(_mm512_loadu_pd(x + s), _mm512_loadu_pd(inv + s)));
+            for (int i = 1; i < n; ++i) {
+                const double *ai = a + i * ld, *invi = inv + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; s += 8) {
+                    const __m512d y = _mm512_fnmadd_pd(_mm512_loadu_pd(ai + s), _mm512_loadu_pd(xPrev + s),
+                                                       _mm512_loadu_pd(xi + s));
+                    _mm512_storeu_pd(xi + s, _mm512_mul_pd(y, _mm512_loadu_pd(invi + s)));
+                }
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                const double* upi = up + i * ldf;
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; s += 8) {
+                    const __m512d y = _mm512_fnmadd_pd(_mm512_loadu_pd(upi + s), _mm512_loadu_pd(xNext + s),
+                                                       _mm512_loadu_pd(xi + s));
+                    _mm512_storeu_pd(xi + s, y);
+                }
+            }
+        }
+
+        DAL_TARGET_AVX512 void SubstituteSharedAvx512(
+            int n, int w, const double* a, const double* inv, const double* up, double* x, ptrdiff_t ldx) {
+            const __m512d inv0 = _mm512_set1_pd(inv[0]);
+            for (int s = 0; s < w; s += 8)
+                _mm512_storeu_pd(x + s, _mm512_mul_pd(_mm512_loadu_pd(x + s), inv0));
+            for (int i = 1; i < n; ++i) {
+                const __m512d ai = _mm512_set1_pd(a[i]), invi = _mm512_set1_pd(inv[i]);
+                double* xi = x + i * ldx;
+                const double* xPrev = xi - ldx;
+                for (int s = 0; s < w; s += 8) {
+                    const __m512d y = _mm512_fnmadd_pd(ai, _mm512_loadu_pd(xPrev + s), _mm512_loadu_pd(xi + s));
+                    _mm512_storeu_pd(xi + s, _mm512_mul_pd(y, invi));
+                }
+            }
+            for (int i = n - 2; i >= 0; --i) {
+                const __m512d upi = _mm512_set1_pd(up[i]);
+                double* xi = x + i * ldx;
+                const double* xNext = xi + ldx;
+                for (int s = 0; s < w; s += 8) {
+                    const __m512d y = _mm512_fnmadd_pd(upi, _mm512_loadu_pd(xNext + s), _mm512_loadu_pd(xi + s));
+                    _mm512_storeu_pd(xi + s, y);
+                }
+            }
+        }
+#endif
+
+        // full vectors go through the widest kernel, the remaining lanes through the scalar one
+        bool Eliminate(int n,
+                       int w,
+                       const double* a,
+                       const double* d,
+                       const double* c,
+                       ptrdiff_t ld,
+                       double* inv,
+                       double* up,
+                       ptrdiff_t ldf) {
+            int v = 0;
+            bool ret_val = true;
+#if DAL_SIMD_X86
+            v = DispatchHead(
+                w, [&](int h) { ret_val = EliminateAvx512(n, h, a, d, c, ld, inv, up, ldf); },
+                [&](int h) { ret_val = EliminateAvx2(n, h, a, d, c, ld, inv, up, ldf); });
+#endif
+            if (v < w)
+                ret_val &= EliminateScalar(n, w - v, a + v, d + v, c + v, ld, inv + v, up + v, ldf);
+            return ret_val;
+        }
+
+        void Substitute(int n,
+                        int w,
+                        const double* a,
+                        ptrdiff_t ld,
+                        const double* inv,
+                        const double* up,
+                        ptrdiff_t ldf,
+                        double* x,
+                        ptrdiff_t ldx) {
+            int v = 0;
+#if DAL_SIMD_X86
+            v = DispatchHead(
+                w, [&](int h) { SubstituteAvx512(n, h, a, ld, inv, up, ldf, x, ldx); },
+                [&](int h) { SubstituteAvx2(n, h, a, ld, inv, up, ldf, x, ldx); });
+#endif
+            if (v < w)
+                SubstituteScalar(n, w - v, a + v, ld, inv + v, up + v, ldf, x + v, ldx);
+        }
+
+        void SubstituteShared(
+            int n, int w, const double* a, const double* inv, const double* up, double* x, ptrdiff_t ldx) {
+            int v = 0;
+#if DAL_SIMD_X86
+            v = DispatchHead(
+                w, [&](int h) { SubstituteSharedAvx512(n, h, a, inv, up, x, ldx); },
+                [&](int h) { SubstituteSharedAvx2(n, h, a, inv, up, x, ldx); });
+#endif
+            if (v < w)
+                SubstituteSharedScalar(n, w - v, a, inv, up, x + v, ldx);
+        }
+    } // namespace
+
+    TriDiagonalBatch_::TriDiagonalBatch_(int size, int count)
+        : below_(size, count), diag_(size, count), above_(size, count) {
+        REQUIRE(size > 0 && count >= 0, "Tri-diagonal batch needs a positive size");
+        below_.Fill(0.0);
+        diag_.Fill(0.0);
+        above_.Fill(0.0);
+    }
+
+    void TriDiagonalBatch_::Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool) const {
+        REQUIRE(x, "Tri-diagonal batch solution must not be null");
+        REQUIRE(b.Rows() == Size() && b.Cols() == Count(), "Right-hand sides should be Size() x Count()");
+        if (x != &b)
+            *x = b;
+        const int n = Size();
+        const ptrdiff_t ld = diag_.Stride();
+        // each block eliminates into its own scratch, which stays in cache for the substitution
+        // blocks may run on the pool, so a failure is only flagged there, and reported here
+        std::atomic<bool> singular(false);
+        ParallelBlocks(pool, Count(), TRI_BLOCK, [&](int begin, int end) {
+            const int w = end - begin;
+            Vector_<> scratch(2 * n * w);
+            if (Eliminate(n, w, below_.Data() + begin, diag_.Data() + begin, above_.Data() + begin, ld, &scratch[0],
+                          &scratch[n * w], w))
+                Substitute(n, w, below_.Data() + begin, ld, &scratch[0], &scratch[n * w], w, x->Data() + begin,
+                           x->Stride());
+            else
+                singular = true;
+        });
+        REQUIRE(!singular, "Tri-diagonal decomposition failed");
+    }
+
+    TriDiagonalBatchFactor_::TriDiagonalBatchFactor_(const TriDiagonalBatch_& systems, ThreadPool_* pool)
+        : below_(systems.Below()), pivotInv_(systems.Size(), systems.Count()), upper_(systems.Size(), systems.Count()) {
+        const int n = Size();
+        const double* a = below_.Data();
+        const double* d = systems.Diag().Data();
+        const double* c = systems.Above().Data();
+        std::atomic<bool> singular(false);
+        ParallelBlocks(pool, Count(), TRI_BLOCK, [&](int begin, int end) {
+            if (!Eliminate(n, end - begin, a + begin, d + begin, c + begin, systems.Diag().Stride(),
+                           pivotInv_.Data() + begin, upper_.Data() + begin, pivotInv_.Stride()))
+                singular = true;
+        });
+        REQUIRE(!singular, "Tri-diagonal decomposition failed");
+    }
+
+    void TriDiagonalBatchFactor_::Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool) const {
+        REQUIRE(x, "Tri-diagonal batch solution must not be null");
+        REQUIRE(b.Rows() == Size() && b.Cols() == Count(), "Right-hand sides should be Size() x Count()");
+        if (x != &b)
+            *x = b;
+        const int n = Size();
+        ParallelBlocks(pool, Count(), TRI_BLOCK, [&](int begin, int end) {
+            Substitute(n, end - begin, below_.Data() + begin, below_.Stride(), pivotInv_.Data() + begin,
+                       upper_.Data() + begin, pivotInv_.Stride(), x->Data() + begin, x->Stride());
+        });
+    }
+
+    TriDiagonalFactor_::TriDiagonalFactor_(const Vector_<>& below, const Vector_<>& diag, const Vector_<>& above)
+        : below_(below), pivotInv_(diag.size()), upper_(diag.size()) {
+        const int n = Size();
+        REQUIRE(n > 0 && below.size() == n && above.size() == n, "Tri-diagonal coefficients should have equal sizes");
+        REQUIRE(Eliminate(n, 1, &below_[0], &diag[0], &above[0], 1, &pivotInv_[0], &upper_[0], 1),
+                "Tri-diagonal decomposition failed");
+    }
+
+    void TriDiagonalFactor_::Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool) const {
+        REQUIRE(x, "Tri-diagonal solution must not be null");
+        REQUIRE(b.Rows() == Size(), "Right-hand sides should have Size() rows");
+        if (x != &b)
+            *x = b;
+        const int n = Size();
+        ParallelBlocks(pool, x->Cols(), TRI_BLOCK, [&](int begin, int end) {
+            SubstituteShared(n, end - begin, &below_[0], &pivotInv_[0], &upper_[0], x->Data() + begin, x->Stride());
+        });
+    }
+} // namespace Dal
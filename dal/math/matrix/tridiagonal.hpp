@@ -0,0 +1,71 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+
+namespace Dal {
+    class ThreadPool_;
+
+    /*
+     * Many independent tri-diagonal systems of the same size, stored interleaved:
+     * row i of each coefficient matrix holds that coefficient of equation i for every system (one per column)
+     * the Thomas algorithm then runs with vector lanes across systems, and blocks of systems can go to a pool
+     * there is no pivoting, so the systems should be diagonally dominant (as from implicit PDE steps or splines)
+     */
+    class TriDiagonalBatch_ {
+        Matrix_<> below_; // A(i, i - 1); row 0 is not used
+        Matrix_<> diag_;  // A(i, i)
+        Matrix_<> above_; // A(i, i + 1); the last row is not used
+
+    public:
+        TriDiagonalBatch_(int size, int count);
+
+        int Size() const { return diag_.Rows(); }
+        int Count() const { return diag_.Cols(); }
+
+        Matrix_<>& Below() { return below_; }
+        Matrix_<>& Diag() { return diag_; }
+        Matrix_<>& Above() { return above_; }
+        const Matrix_<>& Below() const { return below_; }
+        const Matrix_<>& Diag() const { return diag_; }
+        const Matrix_<>& Above() const { return above_; }
+
+        // b and x are Size() x Count(), column s being the right-hand side (solution) of system s; x may be &b
+        void Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool = nullptr) const;
+    };
+
+    // the elimination done once, for repeated solves with the same systems: solving then needs no division
+    class TriDiagonalBatchFactor_ {
+        Matrix_<> below_;    // A(i, i - 1)
+        Matrix_<> pivotInv_; // reciprocal pivots of the elimination
+        Matrix_<> upper_;    // super-diagonal of the eliminated (unit upper) system
+
+    public:
+        explicit TriDiagonalBatchFactor_(const TriDiagonalBatch_& systems, ThreadPool_* pool = nullptr);
+
+        int Size() const { return pivotInv_.Rows(); }
+        int Count() const { return pivotInv_.Cols(); }
+
+        void Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool = nullptr) const;
+    };
+
+    // a single system factored once, then solved for many right-hand sides together, with vector lanes across them
+    class TriDiagonalFactor_ {
+        Vector_<> below_;    // A(i, i - 1); below_[0] is not used
+        Vector_<> pivotInv_; // reciprocal pivots of the elimination
+        Vector_<> upper_;    // super-diagonal of the eliminated (unit upper) system
+
+    public:
+        // below[0] and above.back() are not used
+        TriDiagonalFactor_(const Vector_<>& below, const Vector_<>& diag, const Vector_<>& above);
+
+        int Size() const { return pivotInv_.size(); }
+
+        // b and x have Size() rows and one column per right-hand side (solution); x may be &b
+        void Solve(const Matrix_<>& b, Matrix_<>* x, ThreadPool_* pool = nullptr) const;
+    };
+} // namespace Dal
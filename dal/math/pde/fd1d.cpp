@@ -0,0 +1,161 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/blas.hpp>
+#include <dal/math/matrix/decompositions.hpp>
+#include <dal/math/matrix/sparse.hpp>
+#include <dal/math/matrix/banded.hpp>
+#include <dal/math/pde/fd1d.hpp>
+#include <dal/math/pde/stencil.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <memory>
+#include <dal/platform/strict.hpp>
+
+namespace Dal::PDE {
+    namespace {
+        // the generator L at one time: (L V)_i = lower_i V_{i-1} + diag_i V_i + upper_i V_{i+1}
+        struct Operator_ {
+            Vector_<> lower_, diag_, upper_;
+        };
+
+        void BuildOperator(const Diffusion1D_& model, double t, const Vector_<>& x, Operator_* op) {
+            const int n = x.size();
+            op->lower_.Resize(n);
+            op->diag_.Resize(n);
+            op->upper_.Resize(n);
+            for (int i = 0; i < n; ++i) {
+                const Stencil_ s = ConvectionDiffusion(x, i, model.Drift(t, x[i]), model.Variance(t, x[i]));
+                op->lower_[i] = s.lower_;
+                op->diag_[i] = s.diag_ - model.Discount(t, x[i]);
+                op->upper_[i] = s.upper_;
+            }
+        }
+
+        // rhs = (I + c L) v, for all columns at once
+        void ApplyExplicit(const Operator_& op, double c, const Matrix_<>& v, Matrix_<>* rhs) {
+            const int n = v.Rows(), m = v.Cols();
+            rhs->Resize(n, m);
+            for (int i = 0; i < n; ++i) {
+                double* dst = rhs->Row(i).Data();
+                std::copy(v.Row(i).begin(), v.Row(i).end(), dst);
+                Blas::Scale(m, 1.0 + c * op.diag_[i], dst);
+                if (i > 0)
+                    Blas::Axpy(m, c * op.lower_[i], v.Row(i - 1).Data(), dst);
+                if (i < n - 1)
+                    Blas::Axpy(m, c * op.upper_[i], v.Row(i + 1).Data(), dst);
+            }
+        }
+
+        // I - c L
+        SquareMatrixDecomposition_* ImplicitFactor(const Operator_& op, double c) {
+            const int n = op.diag_.size();
+            std::unique_ptr<Sparse::Square_> a(Sparse::NewBandDiagonal(n, 1, 1));
+            for (int i = 0; i < n; ++i) {
+                a->Set(i, i, 1.0 - c * op.diag_[i]);
+                if (i > 0)
+                    a->Set(i, i - 1, -c * op.lower_[i]);
+                if (i < n - 1)
+                    a->Set(i, i + 1, -c * op.upper_[i]);
+            }
+            return a->Decompose();
+        }
+
+        // steps with the same operator and coefficient share their factors
+        class Stepper_ {
+            const Diffusion1D_& model_;
+            const Vector_<>& grid_;
+            Operator_ op_;
+            double opTime_ = -INF;
+            std::unique_ptr<SquareMatrixDecomposition_> factor_;
+            double factorC_ = 0.0;
+            Matrix_<> rhs_;
+
+            void SetTime(double t) {
+                if (opTime_ != -INF && (model_.IsTimeHomogeneous() || t == opTime_))
+                    return;
+                BuildOperator(model_, t, grid_, &op_);
+                opTime_ = t;
+                factor_.reset();
+            }
+
+        public:
+            Stepper_(const Diffusion1D_& model, const Vector_<>& grid) : model_(model), grid_(grid) {}
+
+            // from t + dt back to t; coefficients are taken at the mid-point
+            void Step(double t, double dt, double theta, Matrix_<>* values) {
+                SetTime(t + 0.5 * dt);
+                const double cImplicit = theta * dt;
+                if (!factor_ || cImplicit != factorC_) {
+                    factor_.reset(ImplicitFactor(op_, cImplicit));
+                    factorC_ = cImplicit;
+                }
+                if (theta < 1.0) {
+                    ApplyExplicit(op_, (1.0 - theta) * dt, *values, &rhs_);
+                    factor_->SolveLeft(rhs_, values);
+                } else
+                    factor_->SolveLeft(*values, values);
+            }
+        };
+    } // namespace
+
+    Vector_<> ConcentratedGrid(double lo, double hi, int n, double center, double concentration) {
+        REQUIRE(n >= 3, "Grid needs at least three points");
+        REQUIRE(lo < center && center < hi, "Grid center should be inside the grid");
+        REQUIRE(concentration > 0.0, "Grid concentration should be positive");
+        const double alpha = concentration * (hi - lo);
+        const double c1 = std::asinh((lo - center) / alpha), c2 = std::asinh((hi - center) / alpha);
+        Vector_<> ret_val(n);
+        for (int i = 0; i < n; ++i)
+            ret_val[i] = center + alpha * std::sinh(c1 + (c2 - c1) * i / (n - 1.0));
+        ret_val.front() = lo;
+        ret_val.back() = hi;
+        // put the center on the grid, so that a kink there is resolved
+        auto closest = std::min_element(ret_val.begin() + 1, ret_val.end() - 1, [&](double a, double b) {
+            return std::fabs(a - center) < std::fabs(b - center);
+        });
+        *closest = center;
+        return ret_val;
+    }
+
+    void RollBack(const Diffusion1D_& model,
+                  const Vector_<>& grid,
+                  const Vector_<>& times,
+                  Matrix_<>* values,
+                  const ThetaScheme_& scheme) {
+        REQUIRE(grid.size() >= 3, "Grid needs at least three points");
+        REQUIRE(values->Rows() == grid.size(), "Values should have one row per grid point");
+        REQUIRE(scheme.theta_ >= 0.0 && scheme.theta_ <= 1.0, "Theta should be in [0, 1]");
+        for (int i = 1; i < grid.size(); ++i)
+            REQUIRE(grid[i] > grid[i - 1], "Grid should be increasing");
+        Stepper_ stepper(model, grid);
+        int done = 0;
+        for (int k = static_cast<int>(times.size()) - 1; k > 0; --k, ++done) {
+            const double dt = times[k] - times[k - 1];
+            REQUIRE(dt > 0.0, "Times should be increasing");
+            if (done < scheme.rannacherSteps_) {
+                stepper.Step(times[k - 1] + 0.5 * dt, 0.5 * dt, 1.0, values);
+                stepper.Step(times[k - 1], 0.5 * dt, 1.0, values);
+            } else
+                stepper.Step(times[k - 1], dt, scheme.theta_, values);
+        }
+    }
+
+    Vector_<> ValuesAt(const Vector_<>& grid, const Matrix_<>& values, double x) {
+        const int n = grid.size();
+        REQUIRE(n >= 3 && values.Rows() == n, "Values should have one row per grid point");
+        REQUIRE(x >= grid.front() && x <= grid.back(), "Point is outside the grid");
+        // the three nodes around x
+        const int j = static_cast<int>(std::upper_bound(grid.begin(), grid.end(), x) - grid.begin());
+        const int i0 = Max(0, Min(n - 3, j - 2));
+        const double x0 = grid[i0], x1 = grid[i0 + 1], x2 = grid[i0 + 2];
+        const double w0 = (x - x1) * (x - x2) / ((x0 - x1) * (x0 - x2));
+        const double w1 = (x - x0) * (x - x2) / ((x1 - x0) * (x1 - x2));
+        const double w2 = (x - x0) * (x - x1) / ((x2 - x0) * (x2 - x1));
+        Vector_<> ret_val(values.Cols());
+        for (int c = 0; c < values.Cols(); ++c)
+            ret_val[c] = w0 * values(i0, c) + w1 * values(i0 + 1, c) + w2 * values(i0 + 2, c);
+        return ret_val;
+    }
+} // namespace Dal::PDE
@@ -0,0 +1,67 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+
+/*
+ * One-factor finite differences: dV/dt + mu(t, x) dV/dx + 1/2 sigma^2(t, x) d2V/dx2 - r(t, x) V = 0
+ * rolled back from terminal values with the theta scheme on a non-uniform grid
+ */
+
+namespace Dal {
+    namespace PDE {
+        // the diffusion of the state variable x, in the role that Model_ plays for simulation
+        class Diffusion1D_ {
+        public:
+            virtual ~Diffusion1D_() = default;
+            virtual double Drift(double t, double x) const = 0;
+            virtual double Variance(double t, double x) const = 0; // sigma^2
+            virtual double Discount(double t, double x) const = 0; // short rate
+            // if so, the step operator only depends on the step size and its factors are reused
+            virtual bool IsTimeHomogeneous() const { return false; }
+        };
+
+        // Black-Scholes in x = log(spot)
+        class LogNormal_ : public Diffusion1D_ {
+            double rate_, div_, vol_;
+
+        public:
+            LogNormal_(double rate, double div, double vol) : rate_(rate), div_(div), vol_(vol) {}
+            double Drift(double, double) const override { return rate_ - div_ - 0.5 * vol_ * vol_; }
+            double Variance(double, double) const override { return vol_ * vol_; }
+            double Discount(double, double) const override { return rate_; }
+            bool IsTimeHomogeneous() const override { return true; }
+        };
+
+        /*
+         * n points from lo to hi, concentrated around center (which is a grid point) by a sinh map
+         * concentration is the width of the dense region relative to hi - lo; large values give a uniform grid
+         */
+        Vector_<> ConcentratedGrid(double lo, double hi, int n, double center, double concentration = 0.1);
+
+        struct ThetaScheme_ {
+            double theta_;       // 0.5 is Crank-Nicolson, 1 fully implicit
+            int rannacherSteps_; // the first steps after maturity are replaced by two fully implicit half-steps
+            explicit ThetaScheme_(double theta = 0.5, int rannacher_steps = 2)
+                : theta_(theta), rannacherSteps_(rannacher_steps) {}
+        };
+
+        /*
+         * values holds one trade per column, one grid point per row; rolled back in place from times.back() to
+         * times.front(), all trades at once with one factorisation per distinct step
+         * the boundaries assume zero convexity, so the grid should extend well beyond the region of interest
+         */
+        void RollBack(const Diffusion1D_& model,
+                      const Vector_<>& grid,
+                      const Vector_<>& times,
+                      Matrix_<>* values,
+                      const ThetaScheme_& scheme = ThetaScheme_());
+
+        // every trade's value at x, by quadratic interpolation on the grid
+        Vector_<> ValuesAt(const Vector_<>& grid, const Matrix_<>& values, double x);
+    } // namespace PDE
+} // namespace Dal
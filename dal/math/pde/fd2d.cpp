@@ -0,0 +1,265 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/tridiagonal.hpp>
+#include <dal/math/pde/fd1d.hpp>
+#include <dal/math/pde/fd2d.hpp>
+#include <dal/math/pde/stencil.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <memory>
+#include <dal/platform/strict.hpp>
+
+namespace Dal::PDE {
+    namespace {
+        // grid rows handed to one task by the explicit parts of a step
+        constexpr int ROW_BLOCK = 32;
+
+        void Transpose(const Matrix_<>& a, Matrix_<>* b, ThreadPool_* pool) {
+            b->Resize(a.Cols(), a.Rows());
+            ParallelBlocks(pool, a.Cols(), ROW_BLOCK, [&](int begin, int end) {
+                for (int i = 0; i < a.Rows(); ++i) {
+                    const double* src = a.Row(i).Data();
+                    for (int j = begin; j < end; ++j)
+                        (*b)(j, i) = src[j];
+                }
+            });
+        }
+
+        /*
+         * the generator split as L = L0 + L1 + L2: cross derivative, x-direction and y-direction
+         * discounting is shared equally by L1 and L2; all coefficients are indexed like the values
+         */
+        struct Operators_ {
+            Matrix_<> xLower_, xDiag_, xUpper_;
+            Matrix_<> yLower_, yDiag_, yUpper_;
+            Matrix_<> cross_; // cov / ((x_{i+1} - x_{i-1}) (y_{j+1} - y_{j-1})), zero on the boundary
+        };
+
+        void BuildOperators(const Diffusion2D_& model,
+                            double t,
+                            const Vector_<>& x,
+                            const Vector_<>& y,
+                            Operators_* op,
+                            ThreadPool_* pool) {
+            const int nx = x.size(), ny = y.size();
+            for (auto m : {&op->xLower_, &op->xDiag_, &op->xUpper_, &op->yLower_, &op->yDiag_, &op->yUpper_,
+                           &op->cross_})
+                m->Resize(nx, ny);
+            ParallelBlocks(pool, nx, ROW_BLOCK, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i)
+                    for (int j = 0; j < ny; ++j) {
+                        const double halfR = 0.5 * model.Discount(t, x[i], y[j]);
+                        const Stencil_ sx =
+                            ConvectionDiffusion(x, i, model.DriftX(t, x[i], y[j]), model.VarianceX(t, x[i], y[j]));
+                        op->xLower_(i, j) = sx.lower_;
+                        op->xDiag_(i, j) = sx.diag_ - halfR;
+                        op->xUpper_(i, j) = sx.upper_;
+                        const Stencil_ sy =
+                            ConvectionDiffusion(y, j, model.DriftY(t, x[i], y[j]), model.VarianceY(t, x[i], y[j]));
+                        op->yLower_(i, j) = sy.lower_;
+                        op->yDiag_(i, j) = sy.diag_ - halfR;
+                        op->yUpper_(i, j) = sy.upper_;
+                        const bool edge = i == 0 || i == nx - 1 || j == 0 || j == ny - 1;
+                        op->cross_(i, j) =
+                            edge ? 0.0 : model.Covariance(t, x[i], y[j]) / ((x[i + 1] - x[i - 1]) * (y[j + 1] - y[j - 1]));
+                    }
+            });
+        }
+
+        // out = L1 v
+        void ApplyX(const Operators_& op, const Matrix_<>& v, Matrix_<>* out, ThreadPool_* pool) {
+            const int nx = v.Rows(), ny = v.Cols();
+            out->Resize(nx, ny);
+            ParallelBlocks(pool, nx, ROW_BLOCK, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    const double *lo = op.xLower_.Row(i).Data(), *di = op.xDiag_.Row(i).Data();
+                    const double* up = op.xUpper_.Row(i).Data();
+                    const double *vm = v.Row(Max(i - 1, 0)).Data(), *vi = v.Row(i).Data();
+                    const double* vp = v.Row(Min(i + 1, nx - 1)).Data();
+                    double* dst = out->Row(i).Data();
+                    // the missing neighbour of an edge row has a zero coefficient
+                    for (int j = 0; j < ny; ++j)
+                        dst[j] = lo[j] * vm[j] + di[j] * vi[j] + up[j] * vp[j];
+                }
+            });
+        }
+
+        // out = L2 v
+        void ApplyY(const Operators_& op, const Matrix_<>& v, Matrix_<>* out, ThreadPool_* pool) {
+            const int nx = v.Rows(), ny = v.Cols();
+            out->Resize(nx, ny);
+            ParallelBlocks(pool, nx, ROW_BLOCK, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    const double *lo = op.yLower_.Row(i).Data(), *di = op.yDiag_.Row(i).Data();
+                    const double* up = op.yUpper_.Row(i).Data();
+                    const double* vi = v.Row(i).Data();
+                    double* dst = out->Row(i).Data();
+                    dst[0] = di[0] * vi[0] + up[0] * vi[1];
+                    for (int j = 1; j < ny - 1; ++j)
+                        dst[j] = lo[j] * vi[j - 1] + di[j] * vi[j] + up[j] * vi[j + 1];
+                    dst[ny - 1] = lo[ny - 1] * vi[ny - 2] + di[ny - 1] * vi[ny - 1];
+                }
+            });
+        }
+
+        // out = L0 v
+        void ApplyCross(const Operators_& op, const Matrix_<>& v, Matrix_<>* out, ThreadPool_* pool) {
+            const int nx = v.Rows(), ny = v.Cols();
+            out->Resize(nx, ny);
+            std::fill(out->Row(0).begin(), out->Row(0).end(), 0.0);
+            std::fill(out->Row(nx - 1).begin(), out->Row(nx - 1).end(), 0.0);
+            ParallelBlocks(pool, nx - 2, ROW_BLOCK, [&](int begin, int end) {
+                for (int i = begin + 1; i < end + 1; ++i) {
+                    const double *vm = v.Row(i - 1).Data(), *vp = v.Row(i + 1).Data();
+                    const double* c = op.cross_.Row(i).Data();
+                    double* dst = out->Row(i).Data();
+                    dst[0] = dst[ny - 1] = 0.0;
+                    for (int j = 1; j < ny - 1; ++j)
+                        dst[j] = c[j] * (vp[j + 1] - vp[j - 1] - vm[j + 1] + vm[j - 1]);
+                }
+            });
+        }
+
+        // factors of I - c L1 and I - c L2: the x-lines are the columns of the values, the y-lines their rows
+        std::unique_ptr<TriDiagonalBatchFactor_> LineFactor(const Matrix_<>& lower,
+                                                            const Matrix_<>& diag,
+                                                            const Matrix_<>& upper,
+                                                            double c,
+                                                            bool transposed,
+                                                            ThreadPool_* pool) {
+            const int size = transposed ? diag.Cols() : diag.Rows();
+            TriDiagonalBatch_ lines(size, transposed ? diag.Rows() : diag.Cols());
+            if (transposed) {
+                Transpose(lower, &lines.Below(), pool);
+                Transpose(diag, &lines.Diag(), pool);
+                Transpose(upper, &lines.Above(), pool);
+            } else {
+                lines.Below() = lower;
+                lines.Diag() = diag;
+                lines.Above() = upper;
+            }
+            lines.Below() *= -c;
+            lines.Above() *= -c;
+            lines.Diag() *= -c;
+            lines.Diag() += 1.0;
+            return std::make_unique<TriDiagonalBatchFactor_>(lines, pool);
+        }
+
+        class Stepper_ {
+            const Diffusion2D_& model_;
+            const Vector_<>& x_;
+            const Vector_<>& y_;
+            ThreadPool_* pool_;
+            Operators_ op_;
+            double opTime_ = -INF;
+            std::unique_ptr<TriDiagonalBatchFactor_> xFactor_, yFactor_;
+            double factorC_ = 0.0;
+            Matrix_<> f0_, f1_, f2_, g0_, g1_, g2_, y0_, work_, lines_;
+
+            void SetTime(double t) {
+                if (opTime_ != -INF && (model_.IsTimeHomogeneous() || t == opTime_))
+                    return;
+                BuildOperators(model_, t, x_, y_, &op_, pool_);
+                opTime_ = t;
+                xFactor_.reset();
+            }
+
+            void SetFactors(double c) {
+                if (xFactor_ && c == factorC_)
+                    return;
+                xFactor_ = LineFactor(op_.xLower_, op_.xDiag_, op_.xUpper_, c, false, pool_);
+                yFactor_ = LineFactor(op_.yLower_, op_.yDiag_, op_.yUpper_, c, true, pool_);
+                factorC_ = c;
+            }
+
+            // the implicit corrections: (I - c L1) y1 = y0 - c l1, then (I - c L2) out = y1 - c l2
+            void Correct(const Matrix_<>& l1, const Matrix_<>& l2, Matrix_<>* out) {
+                work_ = y0_ - l1 * factorC_;
+                xFactor_->Solve(work_, &work_, pool_);
+                work_ -= l2 * factorC_;
+                Transpose(work_, &lines_, pool_);
+                yFactor_->Solve(lines_, &lines_, pool_);
+                Transpose(lines_, out, pool_);
+            }
+
+        public:
+            Stepper_(const Diffusion2D_& model, const Vector_<>& x, const Vector_<>& y, ThreadPool_* pool)
+                : model_(model), x_(x), y_(y), pool_(pool) {}
+
+            // from t + dt back to t, with coefficients at the mid-point
+            void Step(double t, double dt, ADIType_ type, double theta, Matrix_<>* v) {
+                SetTime(t + 0.5 * dt);
+                SetFactors(theta * dt);
+                ApplyCross(op_, *v, &f0_, pool_);
+                ApplyX(op_, *v, &f1_, pool_);
+                ApplyY(op_, *v, &f2_, pool_);
+                y0_ = *v + (f0_ + f1_ + f2_) * dt;
+                Correct(f1_, f2_, v);
+                switch (type) {
+                case ADIType_::DOUGLAS:
+                    return;
+                case ADIType_::CRAIG_SNEYD:
+                    // v holds the Douglas predictor
+                    ApplyCross(op_, *v, &g0_, pool_);
+                    y0_ += (g0_ - f0_) * (0.5 * dt);
+                    Correct(f1_, f2_, v);
+                    return;
+                case ADIType_::HUNDSDORFER_VERWER:
+                    ApplyCross(op_, *v, &g0_, pool_);
+                    ApplyX(op_, *v, &g1_, pool_);
+                    ApplyY(op_, *v, &g2_, pool_);
+                    y0_ += (g0_ + g1_ + g2_ - f0_ - f1_ - f2_) * (0.5 * dt);
+                    Correct(g1_, g2_, v);
+                    return;
+                }
+            }
+        };
+    } // namespace
+
+    ADIScheme_::ADIScheme_(ADIType_ type, int damping_steps)
+        : type_(type), theta_(type == ADIType_::HUNDSDORFER_VERWER ? 0.5 + std::sqrt(3.0) / 6.0 : 0.5),
+          dampingSteps_(damping_steps) {}
+
+    void RollBack(const Diffusion2D_& model,
+                  const Vector_<>& x,
+                  const Vector_<>& y,
+                  const Vector_<>& times,
+                  Matrix_<>* values,
+                  const ADIScheme_& scheme,
+                  ThreadPool_* pool) {
+        const int nx = static_cast<int>(x.size()), ny = static_cast<int>(y.size());
+        REQUIRE(nx >= 3 && ny >= 3, "Grids need at least three points");
+        REQUIRE(values->Rows() == nx && values->Cols() == ny, "Values should be x.size() x y.size()");
+        REQUIRE(scheme.theta_ > 0.0 && scheme.theta_ <= 1.0, "Theta should be in (0, 1]");
+        for (auto grid : {&x, &y}) {
+            const int n = static_cast<int>(grid->size());
+            for (int i = 1; i < n; ++i)
+                REQUIRE((*grid)[i] > (*grid)[i - 1], "Grid should be increasing");
+        }
+        Stepper_ stepper(model, x, y, pool);
+        int done = 0;
+        for (int k = static_cast<int>(times.size()) - 1; k > 0; --k, ++done) {
+            const double dt = times[k] - times[k - 1];
+            REQUIRE(dt > 0.0, "Times should be increasing");
+            if (done < scheme.dampingSteps_) {
+                stepper.Step(times[k - 1] + 0.5 * dt, 0.5 * dt, ADIType_::DOUGLAS, 1.0, values);
+                stepper.Step(times[k - 1], 0.5 * dt, ADIType_::DOUGLAS, 1.0, values);
+            } else
+                stepper.Step(times[k - 1], dt, scheme.type_, scheme.theta_, values);
+        }
+    }
+
+    double ValueAt(const Vector_<>& x, const Vector_<>& y, const Matrix_<>& values, double x0, double y0) {
+        const int n = static_cast<int>(y.size());
+        REQUIRE(values.Cols() == n, "Values should have one column per y point");
+        const Vector_<> alongY = ValuesAt(x, values, x0);
+        Matrix_<> column(n, 1);
+        for (int j = 0; j < n; ++j)
+            column(j, 0) = alongY[j];
+        return ValuesAt(y, column, y0)[0];
+    }
+} // namespace Dal::PDE
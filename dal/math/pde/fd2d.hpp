@@ -0,0 +1,76 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/platform/platform.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+
+/*
+ * Two-factor finite differences:
+ * dV/dt + mu_x V_x + mu_y V_y + 1/2 var_x V_xx + 1/2 var_y V_yy + cov V_xy - r V = 0
+ * rolled back by alternating-direction-implicit splitting: each step solves one tri-diagonal line per grid column,
+ * then one per grid row, batched and optionally spread over a thread pool
+ */
+
+namespace Dal {
+    class ThreadPool_;
+
+    namespace PDE {
+        class Diffusion2D_ {
+        public:
+            virtual ~Diffusion2D_() = default;
+            virtual double DriftX(double t, double x, double y) const = 0;
+            virtual double DriftY(double t, double x, double y) const = 0;
+            virtual double VarianceX(double t, double x, double y) const = 0;
+            virtual double VarianceY(double t, double x, double y) const = 0;
+            virtual double Covariance(double t, double x, double y) const = 0; // rho sigma_x sigma_y
+            virtual double Discount(double t, double x, double y) const = 0;
+            virtual bool IsTimeHomogeneous() const { return false; }
+        };
+
+        // Heston in x = log(spot) and y = instantaneous variance
+        class Heston_ : public Diffusion2D_ {
+            double rate_, div_, kappa_, theta_, xi_, rho_;
+
+        public:
+            Heston_(double rate, double div, double kappa, double theta, double xi, double rho)
+                : rate_(rate), div_(div), kappa_(kappa), theta_(theta), xi_(xi), rho_(rho) {}
+            double DriftX(double, double, double v) const override { return rate_ - div_ - 0.5 * v; }
+            double DriftY(double, double, double v) const override { return kappa_ * (theta_ - v); }
+            double VarianceX(double, double, double v) const override { return v; }
+            double VarianceY(double, double, double v) const override { return xi_ * xi_ * v; }
+            double Covariance(double, double, double v) const override { return rho_ * xi_ * v; }
+            double Discount(double, double, double) const override { return rate_; }
+            bool IsTimeHomogeneous() const override { return true; }
+        };
+
+        enum class ADIType_ { DOUGLAS, CRAIG_SNEYD, HUNDSDORFER_VERWER };
+
+        struct ADIScheme_ {
+            ADIType_ type_;
+            double theta_;
+            int dampingSteps_; // the first steps after maturity are two implicit Douglas half-steps
+            // with the usual theta for the type: 1/2, or 1/2 + sqrt(3)/6 for Hundsdorfer-Verwer
+            explicit ADIScheme_(ADIType_ type = ADIType_::HUNDSDORFER_VERWER, int damping_steps = 2);
+            ADIScheme_(ADIType_ type, double theta, int damping_steps)
+                : type_(type), theta_(theta), dampingSteps_(damping_steps) {}
+        };
+
+        /*
+         * values(i, j) is the value at (x[i], y[j]); rolled back in place from times.back() to times.front()
+         * the boundaries assume zero convexity, and the cross derivative is dropped on them
+         */
+        void RollBack(const Diffusion2D_& model,
+                      const Vector_<>& x,
+                      const Vector_<>& y,
+                      const Vector_<>& times,
+                      Matrix_<>* values,
+                      const ADIScheme_& scheme = ADIScheme_(),
+                      ThreadPool_* pool = nullptr);
+
+        // by quadratic interpolation in each direction
+        double ValueAt(const Vector_<>& x, const Vector_<>& y, const Matrix_<>& values, double x0, double y0);
+    } // namespace PDE
+} // namespace Dal
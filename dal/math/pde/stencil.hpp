@@ -0,0 +1,33 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <dal/math/vectors.hpp>
+
+namespace Dal::PDE {
+    // (mu d/dx + 1/2 var d2/dx2) V at x_i = lower_ V_{i-1} + diag_ V_i + upper_ V_{i+1}
+    struct Stencil_ {
+        double lower_, diag_, upper_;
+    };
+
+    /*
+     * three-point first and second derivatives on a non-uniform grid
+     * the end points assume zero convexity and take the one-sided first derivative
+     */
+    inline Stencil_ ConvectionDiffusion(const Vector_<>& x, int i, double mu, double var) {
+        const int n = x.size();
+        if (i == 0) {
+            const double h = x[1] - x[0];
+            return {0.0, -mu / h, mu / h};
+        }
+        if (i == n - 1) {
+            const double h = x[n - 1] - x[n - 2];
+            return {-mu / h, mu / h, 0.0};
+        }
+        const double hm = x[i] - x[i - 1], hp = x[i + 1] - x[i], hs = hm + hp;
+        return {-mu * hp / (hm * hs) + var / (hm * hs), mu * (hp - hm) / (hm * hp) - var / (hm * hp),
+                mu * hm / (hp * hs) + var / (hp * hs)};
+    }
+} // namespace Dal::PDE
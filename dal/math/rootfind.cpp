@@ -64,6 +64,12 @@ namespace Dal {
           stepSize_(step_size > 0.0 ? step_size : 0.1 * Max(0.01, std::fabs(guess))), trialX_(guess),
           knownPoint_(Dal::INF, Dal::INF), engine_(tol) {}
 
+    Brent_::Brent_(const std::pair<double, double>& low, const std::pair<double, double>& high, double tol)
+        : phase_(Phase_::BRACKETED), increasing_(true), stepSize_(0.0), trialX_(0.5 * (low.first + high.first)),
+          knownPoint_(low), engine_(tol) {
+        engine_.Initialize(low, high);
+    }
+
     double Brent_::NextX() { return phase_ == Phase_::BRACKETED ? engine_.NextX() : trialX_; }
 
     void Brent_::PutY(double y) {
@@ -94,4 +100,60 @@ namespace Dal {
     }
 
     double Brent_::BracketWidth() const { return phase_ == Phase_::BRACKETED ? engine_.BracketWidth() : Dal::INF; }
+
+    BatchBrent_::BatchBrent_(const Vector_<>& guesses, double tol, double step_size) {
+        engines_.reserve(guesses.size());
+        for (const auto& g : guesses)
+            engines_.emplace_back(g, tol, step_size);
+        Reset();
+    }
+
+    BatchBrent_::BatchBrent_(const Vector_<std::pair<double, double>>& low,
+                             const Vector_<std::pair<double, double>>& high,
+                             double tol) {
+        REQUIRE(low.size() == high.size(), "Low and high ends of the brackets should have equal sizes");
+        const int n = static_cast<int>(low.size());
+        engines_.reserve(n);
+        for (int i = 0; i < n; ++i)
+            engines_.emplace_back(low[i], high[i], tol);
+        Reset();
+    }
+
+    void BatchBrent_::Reset() {
+        const int n = Size();
+        live_.Resize(n);
+        for (int i = 0; i < n; ++i)
+            live_[i] = i;
+        x_ = Vector_<>(n, Dal::INF);
+        y_ = Vector_<>(n, Dal::INF);
+        converged_ = Vector_<bool>(n, false);
+    }
+
+    int BatchBrent_::Solve(const Objective_& f, const Converged_& check, int max_rounds) {
+        Vector_<> x, y;
+        for (int round = 0; round < max_rounds && !live_.empty(); ++round) {
+            const int nLive = static_cast<int>(live_.size());
+            x.Resize(nLive);
+            for (int j = 0; j < nLive; ++j)
+                x[j] = engines_[live_[j]].NextX();
+            y.Resize(nLive);
+            f(x, live_, &y);
+            REQUIRE(y.size() == live_.size(), "Objective should give one value per live problem");
+            // compact the live problems in place, keeping their order
+            int kept = 0;
+            for (int j = 0; j < nLive; ++j) {
+                const int i = live_[j];
+                x_[i] = x[j];
+                y_[i] = y[j];
+                if (!std::isfinite(y[j]))
+                    continue;
+                if (check(engines_[i], y[j]))
+                    converged_[i] = true;
+                else
+                    live_[kept++] = i;
+            }
+            live_.Resize(kept);
+        }
+        return static_cast<int>(live_.size());
+    }
 } // namespace Dal
\ No newline at end of file
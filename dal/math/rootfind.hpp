@@ -5,7 +5,9 @@
 #pragma once
 
 #include <cmath>
+#include <functional>
 #include <dal/platform/platform.hpp>
+#include <dal/math/vectors.hpp>
 
 namespace Dal {
     class RootFinder_ {
@@ -54,8 +56,40 @@ namespace Dal {
 
     public:
         Brent_(double guess, double tol = Dal::EPSILON, double step_size = 0.0);
+        // starts from a known bracket, skipping the hunt
+        Brent_(const std::pair<double, double>& low, const std::pair<double, double>& high, double tol = Dal::EPSILON);
         double NextX() override;
         void PutY(double y) override;
         double BracketWidth() const override;
     };
+
+    // many independent problems, advanced in lockstep by Brent_: each round evaluates the objective once, at the
+    // trial points of all live problems; converged problems retire, so later rounds only see the ones still open
+    class BatchBrent_ {
+        Vector_<Brent_> engines_;
+        Vector_<int> live_;
+        Vector_<> x_, y_;
+        Vector_<bool> converged_;
+
+        void Reset();
+
+    public:
+        // fills y with the objective at x, where x[j] is the trial point of problem which[j]
+        using Objective_ = std::function<void(const Vector_<>& x, const Vector_<int>& which, Vector_<>* y)>;
+
+        explicit BatchBrent_(const Vector_<>& guesses, double tol = Dal::EPSILON, double step_size = 0.0);
+        BatchBrent_(const Vector_<std::pair<double, double>>& low,
+                    const Vector_<std::pair<double, double>>& high,
+                    double tol = Dal::EPSILON);
+
+        // runs until every problem has converged, or for at most max_rounds; returns the number left open
+        // a problem whose objective is not finite retires without converging
+        int Solve(const Objective_& f, const Converged_& check, int max_rounds = 100);
+
+        int Size() const { return static_cast<int>(engines_.size()); }
+        bool Converged(int i) const { return converged_[i]; }
+        // the last trial point of each problem, and the objective there: the root, once converged
+        const Vector_<>& X() const { return x_; }
+        const Vector_<>& Y() const { return y_; }
+    };
 } // namespace Dal
@@ -0,0 +1,272 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <cmath>
+#include <dal/platform/simd.hpp>
+
+/*
+ * Elementary functions on vector registers, to be inlined into kernels of the same target
+ * Exp is within two ulps over the whole range (including overflow and the subnormal range);
+ * Log is within two ulps for positive normal arguments (the AVX512 version also handles subnormals);
+ * Erfc follows Cody's rational approximations (Math. Comp. 1969), with relative error near 1e-15;
+ * Ncdf is built on it, so it keeps full relative precision in the left tail
+ * zero, infinite and NaN arguments give what std::exp, std::log and std::erfc would
+ */
+
+#if DAL_SIMD_X86
+#include <immintrin.h>
+
+namespace Dal {
+    namespace Simd {
+        constexpr double LOG2E = 1.4426950408889634074;
+        constexpr double LN2_HI = 6.93147180369123816490e-01; // ln(2) split so that k LN2_HI is exact
+        constexpr double LN2_LO = 1.90821492927058770002e-10;
+        constexpr double SQRT2 = 1.4142135623730950488;
+
+        // exp(r) = sum r^k / k! for |r| <= ln(2) / 2, to k = 13
+        constexpr double EXP_TAYLOR[14] = {1.0,
+                                           1.0,
+                                           1.0 / 2.0,
+                                           1.0 / 6.0,
+                                           1.0 / 24.0,
+                                           1.0 / 120.0,
+                                           1.0 / 720.0,
+                                           1.0 / 5040.0,
+                                           1.0 / 40320.0,
+                                           1.0 / 362880.0,
+                                           1.0 / 3628800.0,
+                                           1.0 / 39916800.0,
+                                           1.0 / 479001600.0,
+                                           1.0 / 6227020800.0};
+
+        // log(m) = 2 s sum z^k / (2k + 1) with s = (m - 1) / (m + 1), z = s^2, for m in [sqrt(1/2), sqrt(2)]
+        constexpr double LOG_SERIES[11] = {1.0,
+                                           1.0 / 3.0,
+                                           1.0 / 5.0,
+                                           1.0 / 7.0,
+                                           1.0 / 9.0,
+                                           1.0 / 11.0,
+                                           1.0 / 13.0,
+                                           1.0 / 15.0,
+                                           1.0 / 17.0,
+                                           1.0 / 19.0,
+                                           1.0 / 21.0};
+
+        // Cody's coefficients: erf on |x| <= 0.46875, erfc on (0.46875, 4] and beyond 4
+        constexpr double ERF_A[5] = {3.16112374387056560e00, 1.13864154151050156e02, 3.77485237685302021e02,
+                                     3.20937758913846947e03, 1.85777706184603153e-1};
+        constexpr double ERF_B[4] = {2.36012909523441209e01, 2.44024637934444173e02, 1.28261652607737228e03,
+                                     2.84423683343917062e03};
+        constexpr double ERFC_C[9] = {5.64188496988670089e-1, 8.88314979438837594e00, 6.61191906371416295e01,
+                                      2.98635138197400131e02, 8.81952221241769090e02, 1.71204761263407058e03,
+                                      2.05107837782607147e03, 1.23033935479799725e03, 2.15311535474403846e-8};
+        constexpr double ERFC_D[8] = {1.57449261107098347e01, 1.17693950891312499e02, 5.37181101862009858e02,
+                                      1.62138957456669019e03, 3.29079923573345963e03, 4.36261909014324716e03,
+                                      3.43936767414372164e03, 1.23033935480374942e03};
+        constexpr double ERFC_P[6] = {3.05326634961232344e-1, 3.60344899949804439e-1, 1.25781726111229246e-1,
+                                      1.60837851487422766e-2, 6.58749161529837803e-4, 1.63153871373020978e-2};
+        constexpr double ERFC_Q[5] = {2.56852019228982242e00, 1.87295284992346725e00, 5.27905102951428412e-1,
+                                      6.05183413124413191e-2, 2.33520497626869185e-3};
+        constexpr double ERF_SMALL = 0.46875;
+        constexpr double ERFC_MAX = 27.5; // erfc underflows beyond this
+        constexpr double INV_SQRT_PI = 5.6418958354775628695e-1;
+        constexpr double INV_SQRT2 = 0.70710678118654752440;
+
+        // 2^k for k within the normal exponent range
+        DAL_TARGET_AVX2 inline __m256d Pow2Avx2(__m128i k) {
+            const __m256i biased = _mm256_cvtepi32_epi64(_mm_add_epi32(k, _mm_set1_epi32(1023)));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+        }
+
+        DAL_TARGET_AVX2 inline __m256d ExpAvx2(__m256d x) {
+            const __m256d y = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-746.0)), _mm256_set1_pd(710.0));
+            const __m256d k =
+                _mm256_round_pd(_mm256_mul_pd(y, _mm256_set1_pd(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_HI), y);
+            r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_LO), r);
+            __m256d p = _mm256_set1_pd(EXP_TAYLOR[13]);
+            for (int i = 12; i >= 0; --i)
+                p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(EXP_TAYLOR[i]));
+            // 2^k in two factors, so that overflow and the subnormal range come out of the multiplications
+            const __m128i ki = _mm256_cvtpd_epi32(k);
+            const __m128i k1 = _mm_srai_epi32(ki, 1);
+            p = _mm256_mul_pd(_mm256_mul_pd(p, Pow2Avx2(k1)), Pow2Avx2(_mm_sub_epi32(ki, k1)));
+            return _mm256_blendv_pd(p, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+        }
+
+        DAL_TARGET_AVX2 inline __m256d LogAvx2(__m256d x) {
+            const __m256i bits = _mm256_castpd_si256(x);
+            // the biased exponent, read as a double through the bits of 2^52 + exponent
+            const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+            const __m256i exponent = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(two52));
+            __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(exponent), _mm256_set1_pd(4503599627370496.0 + 1023.0));
+            const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+            __m256d m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FF0000000000000LL)));
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+            m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+            e = _mm256_add_pd(e, _mm256_and_pd(big, one));
+
+            const __m256d s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+            const __m256d z = _mm256_mul_pd(s, s);
+            __m256d p = _mm256_set1_pd(LOG_SERIES[10]);
+            for (int i = 9; i >= 0; --i)
+                p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(LOG_SERIES[i]));
+            const __m256d logM = _mm256_mul_pd(_mm256_add_pd(s, s), p);
+            const __m256d low = _mm256_fmadd_pd(e, _mm256_set1_pd(LN2_LO), logM);
+            __m256d ret_val = _mm256_fmadd_pd(e, _mm256_set1_pd(LN2_HI), low);
+
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+            ret_val = _mm256_blendv_pd(ret_val, x, _mm256_cmp_pd(x, inf, _CMP_EQ_OQ));
+            ret_val = _mm256_blendv_pd(ret_val, _mm256_sub_pd(zero, inf), _mm256_cmp_pd(x, zero, _CMP_EQ_OQ));
+            return _mm256_blendv_pd(ret_val, _mm256_set1_pd(NAN), _mm256_cmp_pd(x, zero, _CMP_NGE_UQ));
+        }
+
+        DAL_TARGET_AVX2 inline __m256d ErfcAvx2(__m256d x) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d y = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+            const __m256d ysq = _mm256_mul_pd(y, y);
+
+            __m256d num = _mm256_mul_pd(_mm256_set1_pd(ERF_A[4]), ysq), den = ysq;
+            for (int i = 0; i < 3; ++i) {
+                num = _mm256_mul_pd(_mm256_add_pd(num, _mm256_set1_pd(ERF_A[i])), ysq);
+                den = _mm256_mul_pd(_mm256_add_pd(den, _mm256_set1_pd(ERF_B[i])), ysq);
+            }
+            num = _mm256_add_pd(num, _mm256_set1_pd(ERF_A[3]));
+            den = _mm256_add_pd(den, _mm256_set1_pd(ERF_B[3]));
+            const __m256d erf = _mm256_div_pd(num, den);
+            const __m256d small = _mm256_fnmadd_pd(x, erf, one);
+
+            num = _mm256_mul_pd(_mm256_set1_pd(ERFC_C[8]), y);
+            den = y;
+            for (int i = 0; i < 7; ++i) {
+                num = _mm256_mul_pd(_mm256_add_pd(num, _mm256_set1_pd(ERFC_C[i])), y);
+                den = _mm256_mul_pd(_mm256_add_pd(den, _mm256_set1_pd(ERFC_D[i])), y);
+            }
+            num = _mm256_add_pd(num, _mm256_set1_pd(ERFC_C[7]));
+            den = _mm256_add_pd(den, _mm256_set1_pd(ERFC_D[7]));
+            const __m256d mid = _mm256_div_pd(num, den);
+
+            const __m256d inv = _mm256_div_pd(one, ysq);
+            num = _mm256_mul_pd(_mm256_set1_pd(ERFC_P[5]), inv);
+            den = inv;
+            for (int i = 0; i < 4; ++i) {
+                num = _mm256_mul_pd(_mm256_add_pd(num, _mm256_set1_pd(ERFC_P[i])), inv);
+                den = _mm256_mul_pd(_mm256_add_pd(den, _mm256_set1_pd(ERFC_Q[i])), inv);
+            }
+            num = _mm256_add_pd(num, _mm256_set1_pd(ERFC_P[4]));
+            den = _mm256_add_pd(den, _mm256_set1_pd(ERFC_Q[4]));
+            const __m256d ratio = _mm256_div_pd(num, den);
+            const __m256d large = _mm256_div_pd(_mm256_fnmadd_pd(inv, ratio, _mm256_set1_pd(INV_SQRT_PI)), y);
+
+            // exp(-y^2) = exp(-u^2) exp(-(y - u)(y + u)), with u = y to four bits after the point so that u^2 is exact
+            const __m256d yc = _mm256_min_pd(y, _mm256_set1_pd(ERFC_MAX));
+            const __m256d u = _mm256_mul_pd(
+                _mm256_round_pd(_mm256_mul_pd(yc, _mm256_set1_pd(16.0)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC),
+                _mm256_set1_pd(0.0625));
+            const __m256d del = _mm256_mul_pd(_mm256_sub_pd(yc, u), _mm256_add_pd(yc, u));
+            const __m256d gauss = _mm256_mul_pd(ExpAvx2(_mm256_sub_pd(_mm256_setzero_pd(), _mm256_mul_pd(u, u))),
+                                                ExpAvx2(_mm256_sub_pd(_mm256_setzero_pd(), del)));
+            __m256d tail =
+                _mm256_mul_pd(_mm256_blendv_pd(mid, large, _mm256_cmp_pd(y, _mm256_set1_pd(4.0), _CMP_GT_OQ)), gauss);
+            tail = _mm256_blendv_pd(tail, _mm256_sub_pd(_mm256_set1_pd(2.0), tail),
+                                    _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+            return _mm256_blendv_pd(tail, small, _mm256_cmp_pd(y, _mm256_set1_pd(ERF_SMALL), _CMP_LE_OQ));
+        }
+
+        // N(x) = erfc(-x / sqrt(2)) / 2
+        DAL_TARGET_AVX2 inline __m256d NcdfAvx2(__m256d x) {
+            return _mm256_mul_pd(_mm256_set1_pd(0.5), ErfcAvx2(_mm256_mul_pd(x, _mm256_set1_pd(-INV_SQRT2))));
+        }
+
+        DAL_TARGET_AVX512 inline __m512d ExpAvx512(__m512d x) {
+            const __m512d y = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(-746.0)), _mm512_set1_pd(710.0));
+            const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(y, _mm512_set1_pd(LOG2E)),
+                                                   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_HI), y);
+            r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_LO), r);
+            __m512d p = _mm512_set1_pd(EXP_TAYLOR[13]);
+            for (int i = 12; i >= 0; --i)
+                p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_TAYLOR[i]));
+            return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q), _mm512_scalef_pd(p, k), x);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d LogAvx512(__m512d x) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            __m512d e = _mm512_getexp_pd(x);
+            __m512d m = _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_nan);
+            const __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(SQRT2), _CMP_GT_OQ);
+            m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+            e = _mm512_mask_add_pd(e, big, e, one);
+
+            const __m512d s = _mm512_div_pd(_mm512_sub_pd(m, one), _mm512_add_pd(m, one));
+            const __m512d z = _mm512_mul_pd(s, s);
+            __m512d p = _mm512_set1_pd(LOG_SERIES[10]);
+            for (int i = 9; i >= 0; --i)
+                p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(LOG_SERIES[i]));
+            const __m512d logM = _mm512_mul_pd(_mm512_add_pd(s, s), p);
+            // getexp and getmant already give -inf at zero, NaN below it and inf at inf
+            return _mm512_fmadd_pd(e, _mm512_set1_pd(LN2_HI), _mm512_fmadd_pd(e, _mm512_set1_pd(LN2_LO), logM));
+        }
+
+        DAL_TARGET_AVX512 inline __m512d ErfcAvx512(__m512d x) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d y = _mm512_abs_pd(x);
+            const __m512d ysq = _mm512_mul_pd(y, y);
+
+            __m512d num = _mm512_mul_pd(_mm512_set1_pd(ERF_A[4]), ysq), den = ysq;
+            for (int i = 0; i < 3; ++i) {
+                num = _mm512_mul_pd(_mm512_add_pd(num, _mm512_set1_pd(ERF_A[i])), ysq);
+                den = _mm512_mul_pd(_mm512_add_pd(den, _mm512_set1_pd(ERF_B[i])), ysq);
+            }
+            num = _mm512_add_pd(num, _mm512_set1_pd(ERF_A[3]));
+            den = _mm512_add_pd(den, _mm512_set1_pd(ERF_B[3]));
+            const __m512d erf = _mm512_div_pd(num, den);
+            const __m512d small = _mm512_fnmadd_pd(x, erf, one);
+
+            num = _mm512_mul_pd(_mm512_set1_pd(ERFC_C[8]), y);
+            den = y;
+            for (int i = 0; i < 7; ++i) {
+                num = _mm512_mul_pd(_mm512_add_pd(num, _mm512_set1_pd(ERFC_C[i])), y);
+                den = _mm512_mul_pd(_mm512_add_pd(den, _mm512_set1_pd(ERFC_D[i])), y);
+            }
+            num = _mm512_add_pd(num, _mm512_set1_pd(ERFC_C[7]));
+            den = _mm512_add_pd(den, _mm512_set1_pd(ERFC_D[7]));
+            const __m512d mid = _mm512_div_pd(num, den);
+
+            const __m512d inv = _mm512_div_pd(one, ysq);
+            num = _mm512_mul_pd(_mm512_set1_pd(ERFC_P[5]), inv);
+            den = inv;
+            for (int i = 0; i < 4; ++i) {
+                num = _mm512_mul_pd(_mm512_add_pd(num, _mm512_set1_pd(ERFC_P[i])), inv);
+                den = _mm512_mul_pd(_mm512_add_pd(den, _mm512_set1_pd(ERFC_Q[i])), inv);
+            }
+            num = _mm512_add_pd(num, _mm512_set1_pd(ERFC_P[4]));
+            den = _mm512_add_pd(den, _mm512_set1_pd(ERFC_Q[4]));
+            const __m512d ratio = _mm512_div_pd(num, den);
+            const __m512d large = _mm512_div_pd(_mm512_fnmadd_pd(inv, ratio, _mm512_set1_pd(INV_SQRT_PI)), y);
+
+            const __m512d yc = _mm512_min_pd(y, _mm512_set1_pd(ERFC_MAX));
+            const __m512d u = _mm512_mul_pd(
+                _mm512_roundscale_pd(_mm512_mul_pd(yc, _mm512_set1_pd(16.0)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC),
+                _mm512_set1_pd(0.0625));
+            const __m512d del = _mm512_mul_pd(_mm512_sub_pd(yc, u), _mm512_add_pd(yc, u));
+            const __m512d gauss = _mm512_mul_pd(ExpAvx512(_mm512_sub_pd(_mm512_setzero_pd(), _mm512_mul_pd(u, u))),
+                                                ExpAvx512(_mm512_sub_pd(_mm512_setzero_pd(), del)));
+            __m512d tail = _mm512_mul_pd(
+                _mm512_mask_blend_pd(_mm512_cmp_pd_mask(y, _mm512_set1_pd(4.0), _CMP_GT_OQ), mid, large), gauss);
+            tail = _mm512_mask_sub_pd(tail, _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_LT_OQ),
+                                      _mm512_set1_pd(2.0), tail);
+            return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(y, _mm512_set1_pd(ERF_SMALL), _CMP_LE_OQ), tail, small);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d NcdfAvx512(__m512d x) {
+            return _mm512_mul_pd(_mm512_set1_pd(0.5), ErfcAvx512(_mm512_mul_pd(x, _mm512_set1_pd(-INV_SQRT2))));
+        }
+    } // namespace Simd
+} // namespace Dal
+#endif
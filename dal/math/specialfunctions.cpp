@@ -6,36 +6,218 @@
 #include <dal/platform/platform.hpp>
 #include <dal/math/specialfunctions.hpp>
 #include <dal/platform/strict.hpp>
-#include <dal/math/interp/interpcubic.hpp>
-#include <dal/math/vectors.hpp>
-#include <dal/string/strings.hpp>
+#include <dal/math/simdmath.hpp>
+#include <dal/utilities/algorithms.hpp>
+#include <dal/utilities/exceptions.hpp>
 
 namespace Dal {
     namespace {
-        constexpr double MIN_SPLINE_X = -3.734582185;
-        constexpr double MIN_SPLINE_F = 9.47235E-05;
-        Interp1_* MakeNcdfSpline() {
-            const Vector_<> x = {MIN_SPLINE_X, -3.347382781, -3.030883722, -2.75090681,  -2.492289824, -2.243141537,
-                                 -1.992179668, -1.494029881, -1.290815576, -1.120050999, -0.954303629, -0.792072249,
-                                 -0.629093487, -0.460389924, -0.276889742, 0.0};
-            const Vector_<> f = {MIN_SPLINE_F, 0.000408582, 0.001219907, 0.002972237, 0.00634685, 0.012444548,
-                                 0.023176395,  0.067583453, 0.098383227, 0.131345731, 0.16996458, 0.214158839,
-                                 0.264643073,  0.322617682, 0.39093184,  0.5};
-            const Interp::Boundary_ lhs(1, 0.000373538);
-            const Interp::Boundary_ rhs(1, 0.39898679); // at x=0
-            return Interp::NewCubic(String_(), x, f, lhs, rhs);
-        }
-
-        double NcdfBySpline(double z) {
-            static const scoped_ptr<Interp1_> SPLINE(MakeNcdfSpline());
-            if (z > 0.0)
-                return 1.0 - NcdfBySpline(-z);
-            return z < MIN_SPLINE_X ? MIN_SPLINE_F * exp(-1.1180061 * (Square(z) - Square(MIN_SPLINE_X)))
-                                    : (*SPLINE)(z);
+        constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+        constexpr double SQRT_2 = 1.41421356237309504880;
+
+        // Abramowitz and Stegun 26.2.17: N(-|z|) = phi(z) t P(t), with t = 1 / (1 + p |z|)
+        constexpr double AS_P = 0.2316419;
+        constexpr double AS_B[5] = {0.319381530, -0.356563782, 1.781477937, -1.821255978, 1.330274429};
+        // Hart (1968), as given by West (2005): N(-|z|) = exp(-z^2/2) P(|z|) / Q(|z|)
+        constexpr double HART_P[7] = {220.206867912376, 221.213596169931, 112.079291497871, 33.912866078383,
+                                      6.37396220353165, 0.700383064443688, 3.52624965998911e-02};
+        constexpr double HART_Q[8] = {440.413735824752, 793.826512519948, 637.333633378831, 296.564248779674,
+                                      86.7807322029461, 16.064177579207,  1.75566716318264, 8.83883476483184e-02};
+        // N underflows well before this, and the clamp keeps P / Q finite
+        constexpr double HART_MAX = 40.0;
+
+        double NcdfLow(double z) {
+            const double t = 1.0 / (1.0 + AS_P * std::fabs(z));
+            double p = AS_B[4];
+            for (int i = 3; i >= 0; --i)
+                p = p * t + AS_B[i];
+            const double tail = INV_SQRT_2PI * std::exp(-0.5 * z * z) * t * p;
+            return z > 0.0 ? 1.0 - tail : tail;
+        }
+
+        double NcdfHigh(double z) {
+            const double a = Min(std::fabs(z), HART_MAX);
+            double num = HART_P[6], den = HART_Q[7];
+            for (int i = 5; i >= 0; --i)
+                num = num * a + HART_P[i];
+            for (int i = 6; i >= 0; --i)
+                den = den * a + HART_Q[i];
+            const double tail = std::exp(-0.5 * a * a) * num / den;
+            return z > 0.0 ? 1.0 - tail : tail;
+        }
+
+        double NcdfScalar(double z, NormalAccuracy_ accuracy) {
+            switch (accuracy) {
+            case NormalAccuracy_::LOW:
+                return NcdfLow(z);
+            case NormalAccuracy_::HIGH:
+                return NcdfHigh(z);
+            default:
+                return 0.5 * std::erfc(-z / SQRT_2);
+            }
+        }
+
+        double ErfcScalar(double x, NormalAccuracy_ accuracy) {
+            return accuracy == NormalAccuracy_::FULL ? std::erfc(x) : 2.0 * NcdfScalar(-SQRT_2 * x, accuracy);
+        }
+
+#if DAL_SIMD_X86
+        DAL_TARGET_AVX2 inline __m256d NcdfLowAvx2(__m256d z) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d a = _mm256_andnot_pd(_mm256_set1_pd(-0.0), z);
+            const __m256d t = _mm256_div_pd(one, _mm256_fmadd_pd(_mm256_set1_pd(AS_P), a, one));
+            __m256d p = _mm256_set1_pd(AS_B[4]);
+            for (int i = 3; i >= 0; --i)
+                p = _mm256_fmadd_pd(p, t, _mm256_set1_pd(AS_B[i]));
+            const __m256d phi = Simd::ExpAvx2(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(z, z)));
+            const __m256d tail = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(INV_SQRT_2PI), phi), _mm256_mul_pd(t, p));
+            return _mm256_blendv_pd(tail, _mm256_sub_pd(one, tail), _mm256_cmp_pd(z, _mm256_setzero_pd(), _CMP_GT_OQ));
+        }
+
+        DAL_TARGET_AVX2 inline __m256d NcdfHighAvx2(__m256d z) {
+            const __m256d a = _mm256_min_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), z), _mm256_set1_pd(HART_MAX));
+            __m256d num = _mm256_set1_pd(HART_P[6]), den = _mm256_set1_pd(HART_Q[7]);
+            for (int i = 5; i >= 0; --i)
+                num = _mm256_fmadd_pd(num, a, _mm256_set1_pd(HART_P[i]));
+            for (int i = 6; i >= 0; --i)
+                den = _mm256_fmadd_pd(den, a, _mm256_set1_pd(HART_Q[i]));
+            const __m256d e = Simd::ExpAvx2(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(a, a)));
+            const __m256d tail = _mm256_div_pd(_mm256_mul_pd(e, num), den);
+            // NaN arguments fall through the clamp as NaN, and compare false
+            const __m256d upper = _mm256_sub_pd(_mm256_set1_pd(1.0), tail);
+            return _mm256_blendv_pd(tail, upper, _mm256_cmp_pd(z, _mm256_setzero_pd(), _CMP_GT_OQ));
+        }
+
+        DAL_TARGET_AVX2 inline __m256d NcdfAvx2(__m256d z, NormalAccuracy_ accuracy) {
+            switch (accuracy) {
+            case NormalAccuracy_::LOW:
+                return NcdfLowAvx2(z);
+            case NormalAccuracy_::HIGH:
+                return NcdfHighAvx2(z);
+            default:
+                return Simd::NcdfAvx2(z);
+            }
+        }
+
+        DAL_TARGET_AVX2 void NcdfArrayAvx2(const double* z, double* dst, int n, NormalAccuracy_ accuracy) {
+            for (int k = 0; k < n; k += 4)
+                _mm256_storeu_pd(dst + k, NcdfAvx2(_mm256_loadu_pd(z + k), accuracy));
+        }
+
+        DAL_TARGET_AVX2 void ErfcArrayAvx2(const double* x, double* dst, int n, NormalAccuracy_ accuracy) {
+            const __m256d minusSqrt2 = _mm256_set1_pd(-SQRT_2);
+            const __m256d two = _mm256_set1_pd(2.0);
+            for (int k = 0; k < n; k += 4) {
+                const __m256d v = _mm256_loadu_pd(x + k);
+                _mm256_storeu_pd(dst + k, accuracy == NormalAccuracy_::FULL
+                                              ? Simd::ErfcAvx2(v)
+                                              : _mm256_mul_pd(two, NcdfAvx2(_mm256_mul_pd(minusSqrt2, v), accuracy)));
+            }
+        }
+
+        DAL_TARGET_AVX2 void NpdfArrayAvx2(const double* z, double* dst, int n) {
+            for (int k = 0; k < n; k += 4) {
+                const __m256d v = _mm256_loadu_pd(z + k);
+                const __m256d e = Simd::ExpAvx2(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(v, v)));
+                _mm256_storeu_pd(dst + k, _mm256_mul_pd(_mm256_set1_pd(INV_SQRT_2PI), e));
+            }
         }
+
+        DAL_TARGET_AVX512 inline __m512d NcdfLowAvx512(__m512d z) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d t = _mm512_div_pd(one, _mm512_fmadd_pd(_mm512_set1_pd(AS_P), _mm512_abs_pd(z), one));
+            __m512d p = _mm512_set1_pd(AS_B[4]);
+            for (int i = 3; i >= 0; --i)
+                p = _mm512_fmadd_pd(p, t, _mm512_set1_pd(AS_B[i]));
+            const __m512d phi = Simd::ExpAvx512(_mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_mul_pd(z, z)));
+            const __m512d tail = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(INV_SQRT_2PI), phi), _mm512_mul_pd(t, p));
+            return _mm512_mask_sub_pd(tail, _mm512_cmp_pd_mask(z, _mm512_setzero_pd(), _CMP_GT_OQ), one, tail);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d NcdfHighAvx512(__m512d z) {
+            const __m512d a = _mm512_min_pd(_mm512_abs_pd(z), _mm512_set1_pd(HART_MAX));
+            __m512d num = _mm512_set1_pd(HART_P[6]), den = _mm512_set1_pd(HART_Q[7]);
+            for (int i = 5; i >= 0; --i)
+                num = _mm512_fmadd_pd(num, a, _mm512_set1_pd(HART_P[i]));
+            for (int i = 6; i >= 0; --i)
+                den = _mm512_fmadd_pd(den, a, _mm512_set1_pd(HART_Q[i]));
+            const __m512d e = Simd::ExpAvx512(_mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_mul_pd(a, a)));
+            const __m512d tail = _mm512_div_pd(_mm512_mul_pd(e, num), den);
+            return _mm512_mask_sub_pd(tail, _mm512_cmp_pd_mask(z, _mm512_setzero_pd(), _CMP_GT_OQ),
+                                      _mm512_set1_pd(1.0), tail);
+        }
+
+        DAL_TARGET_AVX512 inline __m512d NcdfAvx512(__m512d z, NormalAccuracy_ accuracy) {
+            switch (accuracy) {
+            case NormalAccuracy_::LOW:
+                return NcdfLowAvx512(z);
+            case NormalAccuracy_::HIGH:
+                return NcdfHighAvx512(z);
+            default:
+                return Simd::NcdfAvx512(z);
+            }
+        }
+
+        DAL_TARGET_AVX512 void NcdfArrayAvx512(const double* z, double* dst, int n, NormalAccuracy_ accuracy) {
+            for (int k = 0; k < n; k += 8)
+                _mm512_storeu_pd(dst + k, NcdfAvx512(_mm512_loadu_pd(z + k), accuracy));
+        }
+
+        DAL_TARGET_AVX512 void ErfcArrayAvx512(const double* x, double* dst, int n, NormalAccuracy_ accuracy) {
+            const __m512d minusSqrt2 = _mm512_set1_pd(-SQRT_2);
+            const __m512d two = _mm512_set1_pd(2.0);
+            for (int k = 0; k < n; k += 8) {
+                const __m512d v = _mm512_loadu_pd(x + k);
+                _mm512_storeu_pd(dst + k, accuracy == NormalAccuracy_::FULL
+                                              ? Simd::ErfcAvx512(v)
+                                              : _mm512_mul_pd(two, NcdfAvx512(_mm512_mul_pd(minusSqrt2, v), accuracy)));
+            }
+        }
+
+        DAL_TARGET_AVX512 void NpdfArrayAvx512(const double* z, double* dst, int n) {
+            for (int k = 0; k < n; k += 8) {
+                const __m512d v = _mm512_loadu_pd(z + k);
+                const __m512d e = Simd::ExpAvx512(_mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_mul_pd(v, v)));
+                _mm512_storeu_pd(dst + k, _mm512_mul_pd(_mm512_set1_pd(INV_SQRT_2PI), e));
+            }
+        }
+#endif
     } // namespace
 
-    double NCDF(double z, bool precise) { return precise ? 0.5 * erfc(-z / M_SQRT_2) : NcdfBySpline(z); }
+    double NCDF(double z, bool precise) {
+        return NcdfScalar(z, precise ? NormalAccuracy_::FULL : NormalAccuracy_::LOW);
+    }
+
+    void NCDF(const double* z, double* dst, int n, NormalAccuracy_ accuracy) {
+        int v = 0;
+#if DAL_SIMD_X86
+        v = DispatchHead(
+            n, [&](int w) { NcdfArrayAvx512(z, dst, w, accuracy); },
+            [&](int w) { NcdfArrayAvx2(z, dst, w, accuracy); });
+#endif
+        for (int k = v; k < n; ++k)
+            dst[k] = NcdfScalar(z[k], accuracy);
+    }
+
+    void NPDF(const double* z, double* dst, int n) {
+        int v = 0;
+#if DAL_SIMD_X86
+        v = DispatchHead(n, [&](int w) { NpdfArrayAvx512(z, dst, w); }, [&](int w) { NpdfArrayAvx2(z, dst, w); });
+#endif
+        for (int k = v; k < n; ++k)
+            dst[k] = NPDF(z[k]);
+    }
+
+    void Erfc(const double* x, double* dst, int n, NormalAccuracy_ accuracy) {
+        int v = 0;
+#if DAL_SIMD_X86
+        v = DispatchHead(
+            n, [&](int w) { ErfcArrayAvx512(x, dst, w, accuracy); },
+            [&](int w) { ErfcArrayAvx2(x, dst, w, accuracy); });
+#endif
+        for (int k = v; k < n; ++k)
+            dst[k] = ErfcScalar(x[k], accuracy);
+    }
 
     double InverseNCDF(double x, bool precise, bool polish) {
 
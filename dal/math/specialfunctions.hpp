@@ -7,7 +7,21 @@
 #include <cmath>
 
 namespace Dal {
-    inline double NPDF(double z) { return z < -10.0 || 10.0 < z ? 0.0 : std::exp(-0.5 * z * z) / 2.506628274631; }
+    inline double NPDF(double z) { return 0.39894228040143267794 * std::exp(-0.5 * z * z); }
+    // the imprecise version is the LOW tier below
     double NCDF(double z, bool precise = true);
     double InverseNCDF(double x, bool precise = true, bool polish = true);
+
+    /*
+     * array kernels, vectorised with runtime dispatch; the tiers bound the absolute error of NCDF:
+     * LOW to 1e-7 (Abramowitz and Stegun 26.2.17),
+     * HIGH to 1e-12 (Hart's rational approximation, as given by West 2005; in practice within 1e-15),
+     * FULL as std::erfc, keeping relative precision deep into the left tail (Cody's rational approximations)
+     * the cheaper tiers lose relative precision beyond seven standard deviations; Erfc errors are twice NCDF's
+     */
+    enum class NormalAccuracy_ { LOW, HIGH, FULL };
+
+    void NCDF(const double* z, double* dst, int n, NormalAccuracy_ accuracy = NormalAccuracy_::FULL);
+    void NPDF(const double* z, double* dst, int n);
+    void Erfc(const double* x, double* dst, int n, NormalAccuracy_ accuracy = NormalAccuracy_::FULL);
 } // namespace Dal
\ No newline at end of file
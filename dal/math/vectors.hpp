@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <dal/math/expressions.hpp>
 #include <functional>
 #include <vector>
 
@@ -34,25 +35,24 @@ namespace Dal {
 
         void Resize(size_t new_size) { base_t::resize(new_size); }
 
-        template <class T_> void operator*=(const T_& scale) {
-            std::transform(begin(), end(), begin(), std::bind(std::multiplies<E_>(), std::placeholders::_1, scale));
+        // evaluates an expression of expressions.hpp in a single loop
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>>
+        Vector_(const X_& src) : base_t(src.size()) {
+            Expr::Assign(this, src);
         }
 
-        template <class T_> void operator+=(const T_& shift) {
-            std::transform(begin(), end(), begin(), std::bind(std::plus<E_>(), std::placeholders::_1, shift));
+        template <class X_, class = std::enable_if_t<Expr::IS_EXPRESSION<X_>>> Vector_& operator=(const X_& src) {
+            Resize(src.size());
+            Expr::Assign(this, src);
+            return *this;
         }
 
-        template <class T_> void operator-=(const T_& shift) {
-            std::transform(begin(), end(), begin(), std::bind(std::minus<E_>(), std::placeholders::_1, shift));
-        }
+        // scalars, vectors or expressions
+        template <class T_> void operator*=(const T_& scale) { Expr::MultiplyBy(this, scale); }
 
-        template <class T_> void operator+=(const Vector_<T_>& other) {
-            std::transform(begin(), end(), other.begin(), begin(), std::plus<E_>());
-        }
+        template <class T_> void operator+=(const T_& shift) { Expr::AddTo(this, shift); }
 
-        template <class T_> void operator-=(const Vector_<T_>& other) {
-            std::transform(begin(), end(), other.begin(), begin(), std::minus<E_>());
-        }
+        template <class T_> void operator-=(const T_& shift) { Expr::SubtractFrom(this, shift); }
 
         template <class I_> void Assign(I_ begin, I_ end) { base_t::assign(begin, end); }
 
@@ -128,11 +128,7 @@ namespace Dal {
 
     template <class E_> inline bool Vector_<E_>::operator!=(const Vector_<E_>& rhs) const { return !Equal(*this, rhs); }
 
-    template <class E_> inline auto operator*(const Vector_<E_>& left, const E_& right) {
-        Vector_<E_> ret(left.size());
-        std::transform(left.begin(), left.end(), ret.begin(), [&right](const E_& val) { return right * val; });
-        return ret;
-    }
-
-    template <class E_> inline auto operator*(const E_& left, const Vector_<E_>& right) { return right * left; }
+    namespace Expr {
+        template <class E_> struct IsArray_<Vector_<E_>> : std::true_type {};
+    } // namespace Expr
 } // namespace Dal
\ No newline at end of file
@@ -0,0 +1,30 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <dal/platform/platform.hpp>
+
+namespace Dal {
+    /*
+     * Allocator returning storage aligned to A_ bytes (a cache line by default)
+     * so that contiguous numerical buffers start on a line and vector loads never straddle it
+     */
+    template <class T_, size_t A_ = CACHE_LINE_SIZE> struct AlignedAllocator_ {
+        static_assert(A_ >= alignof(T_) && (A_ & (A_ - 1)) == 0, "alignment must be a power of 2 no smaller than alignof(T_)");
+        using value_type = T_;
+        template <class U_> struct rebind { using other = AlignedAllocator_<U_, A_>; };
+
+        AlignedAllocator_() noexcept = default;
+        template <class U_> AlignedAllocator_(const AlignedAllocator_<U_, A_>&) noexcept {}
+
+        T_* allocate(size_t n) { return static_cast<T_*>(::operator new(n * sizeof(T_), std::align_val_t(A_))); }
+        void deallocate(T_* p, size_t) noexcept { ::operator delete(p, std::align_val_t(A_)); }
+
+        template <class U_> bool operator==(const AlignedAllocator_<U_, A_>&) const noexcept { return true; }
+        template <class U_> bool operator!=(const AlignedAllocator_<U_, A_>&) const noexcept { return false; }
+    };
+} // namespace Dal
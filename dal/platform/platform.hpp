@@ -30,7 +30,10 @@ namespace Dal {
 
     template <class = double> class Vector_;
 
-    template <class = double> class Matrix_;
+    // storage order of Matrix_: ROW_MAJOR keeps each row contiguous, COL_MAJOR each column
+    enum class MatrixLayout_ { ROW_MAJOR, COL_MAJOR };
+
+    template <class = double, MatrixLayout_ = MatrixLayout_::ROW_MAJOR> class Matrix_;
 
     template <class = double> class SquareMatrix_;
 
@@ -40,6 +43,7 @@ namespace Dal {
     constexpr const double INF = 1e29;
     constexpr const double PI = 3.1415926535897932;
     constexpr const double M_SQRT_2 = 1.4142135623730951;
+    constexpr const size_t CACHE_LINE_SIZE = 64;
 
     template <class T_> inline bool IsZero(const T_& x) { return x < Dal::EPSILON && -x < Dal::EPSILON; }
 
@@ -0,0 +1,39 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <atomic>
+#include <dal/platform/simd.hpp>
+#include <dal/platform/strict.hpp>
+
+namespace Dal {
+    namespace {
+        SimdLevel_ Detect() {
+#if DAL_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                return SimdLevel_::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return SimdLevel_::AVX2;
+#endif
+            return SimdLevel_::SCALAR;
+        }
+
+        std::atomic<SimdLevel_>& TheCap() {
+            static std::atomic<SimdLevel_> RET_VAL(SimdLevel_::AVX512);
+            return RET_VAL;
+        }
+    } // namespace
+
+    SimdLevel_ SimdSupported() {
+        static const SimdLevel_ RET_VAL = Detect();
+        return RET_VAL;
+    }
+
+    SimdLevel_ SimdLevel() {
+        const SimdLevel_ cap = TheCap().load(std::memory_order_relaxed);
+        return static_cast<int>(cap) < static_cast<int>(SimdSupported()) ? cap : SimdSupported();
+    }
+
+    SimdLevel_ SetSimdLevel(SimdLevel_ cap) { return TheCap().exchange(cap); }
+} // namespace Dal
@@ -0,0 +1,72 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#pragma once
+
+/*
+ * Runtime selection of vector instruction sets
+ * kernels are compiled for several targets in one binary (function target attributes)
+ * and the widest one supported by the running cpu is picked on first use
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DAL_SIMD_X86 1
+#define DAL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define DAL_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define DAL_SIMD_X86 0
+#endif
+
+namespace Dal {
+    enum class SimdLevel_ { SCALAR, AVX2, AVX512 };
+
+    // widest level both compiled in and supported by this cpu
+    SimdLevel_ SimdSupported();
+    // level used by dispatched kernels: SimdSupported(), unless capped by SetSimdLevel
+    SimdLevel_ SimdLevel();
+    // caps the dispatched level (e.g. to compare kernels); returns the previous cap
+    SimdLevel_ SetSimdLevel(SimdLevel_ cap);
+
+    // the leading lanes of n which fill whole vectors at the given level, leaving the rest to scalar code
+    inline int VectorHead(int n, SimdLevel_ level = SimdLevel()) {
+        switch (level) {
+        case SimdLevel_::AVX512:
+            return n - n % 8;
+        case SimdLevel_::AVX2:
+            return n - n % 4;
+        default:
+            return 0;
+        }
+    }
+
+    /*
+     * runs avx512(v) or avx2(v), as the dispatched level allows, on the leading v = VectorHead(n) lanes and returns v;
+     * the caller takes the lanes [v, n) through its scalar kernel
+     */
+    template <class AVX512_, class AVX2_> int DispatchHead(int n, const AVX512_& avx512, const AVX2_& avx2) {
+        const SimdLevel_ level = SimdLevel();
+        const int ret_val = VectorHead(n, level);
+        if (ret_val > 0) {
+            if (level == SimdLevel_::AVX512)
+                avx512(ret_val);
+            else
+                avx2(ret_val);
+        }
+        return ret_val;
+    }
+
+    // moves the lanes of a batch kernel k elements on; null pointers (outputs not wanted) stay null
+    template <class... T_> void AdvanceLanes(int k, T_*&... lanes) { ((lanes = lanes ? lanes + k : lanes), ...); }
+
+    // caps the dispatched level for its lifetime, restoring the previous cap however the scope is left
+    class SimdLevelGuard_ {
+        const SimdLevel_ saved_;
+
+    public:
+        explicit SimdLevelGuard_(SimdLevel_ cap) : saved_(SetSimdLevel(cap)) {}
+        ~SimdLevelGuard_() { SetSimdLevel(saved_); }
+        SimdLevelGuard_(const SimdLevelGuard_&) = delete;
+        SimdLevelGuard_& operator=(const SimdLevelGuard_&) = delete;
+    };
+} // namespace Dal
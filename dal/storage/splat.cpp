@@ -60,7 +60,7 @@ namespace Dal {
             void Write(Matrix_<Cell_>& dst, int row_offset, int col_offset) const {
                 if (!val_.Empty()) {
                     for (int ir = 0; ir < val_.Rows(); ++ir)
-                        copy(val_.Row(ir).begin(), val_.Row(ir).end(), dst.Row(ir + row_offset).begin() + col_offset);
+                        std::copy(val_.Row(ir).begin(), val_.Row(ir).end(), dst.Row(ir + row_offset).begin() + col_offset);
                 } else {
                     dst(row_offset, col_offset) = tag_ + OBJECT_PREFACE + type_;
                     for (const auto& c : children_) {
@@ -320,7 +320,7 @@ namespace Dal {
                 Matrix_<VALUE_TYPE_OF(translate(data_(0, 0)))> ret_val;
                 ret_val.Resize(rowStop_ - rowStart_, col_stop - colStart_);
                 for (int ir = rowStart_; ir < rowStop_; ++ir)
-                    transform(data_.Row(ir).begin() + colStart_, data_.Row(ir).begin() + col_stop,
+                    std::transform(data_.Row(ir).begin() + colStart_, data_.Row(ir).begin() + col_stop,
                               ret_val.Row(ir - rowStart_).begin(), translate);
                 return ret_val;
             }
@@ -0,0 +1,67 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/matrixarithmetic.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <dal/platform/simd.hpp>
+#include <dal/utilities/timer.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace Dal;
+using namespace std;
+
+namespace {
+    Matrix_<> Filled(int rows, int cols, double seed) {
+        Matrix_<> ret_val(rows, cols);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                ret_val(i, j) = sin(seed + 0.37 * i + 1.13 * j);
+        return ret_val;
+    }
+
+    void Naive(const Matrix_<>& a, const Matrix_<>& b, Matrix_<>* c) {
+        c->Resize(a.Rows(), b.Cols());
+        for (int i = 0; i < a.Rows(); ++i)
+            for (int j = 0; j < b.Cols(); ++j) {
+                double s = 0.0;
+                for (int k = 0; k < a.Cols(); ++k)
+                    s += a(i, k) * b(k, j);
+                (*c)(i, j) = s;
+            }
+    }
+
+    template <class F_> double GFlops(int n, const F_& f) {
+        Timer_ timer;
+        f();
+        const double seconds = Max(1.0e-9, timer.Elapsed<nanoseconds>() * 1.0e-9);
+        return 2.0 * n * n * n / seconds * 1.0e-9;
+    }
+} // namespace
+
+int main() {
+    const char* LEVELS[] = {"scalar", "avx2", "avx512"};
+    cout << "cpu supports: " << LEVELS[static_cast<int>(SimdSupported())] << endl;
+    cout << setw(6) << "n" << setw(10) << "naive" << setw(10) << "scalar" << setw(10) << "simd" << setw(10) << "pool"
+         << "   (GFlop/s)" << endl;
+
+    ThreadPool_* pool = ThreadPool_::GetInstance();
+    for (int n : {64, 128, 256, 512, 1024}) {
+        const Matrix_<> a = Filled(n, n, 0.1);
+        const Matrix_<> b = Filled(n, n, 0.2);
+        Matrix_<> c;
+
+        const double naive = GFlops(n, [&]() { Naive(a, b, &c); });
+        const auto saved = SetSimdLevel(SimdLevel_::SCALAR);
+        const double scalar = GFlops(n, [&]() { Matrix::Multiply(a, b, &c); });
+        SetSimdLevel(saved);
+        const double simd = GFlops(n, [&]() { Matrix::Multiply(a, b, &c); });
+        const double parallel = GFlops(n, [&]() { Matrix::Multiply(a, b, &c, pool); });
+        cout << setw(6) << n << fixed << setprecision(2) << setw(10) << naive << setw(10) << scalar << setw(10) << simd
+             << setw(10) << parallel << endl;
+    }
+    return 0;
+}
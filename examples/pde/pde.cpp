@@ -0,0 +1,85 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <dal/math/aad/models/blackscholes.hpp>
+#include <dal/math/aad/products/european.hpp>
+#include <dal/math/aad/simulation.hpp>
+#include <dal/math/pde/fd1d.hpp>
+#include <dal/math/random/pseudorandom.hpp>
+#include <dal/math/specialfunctions.hpp>
+#include <dal/utilities/timer.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace Dal;
+using namespace std;
+
+/*
+ * The same European call as examples/european, priced by Monte-Carlo and by the 1D PDE engine
+ * for each method: the error against the closed form and the time taken
+ * MC error is its standard error; the last column extrapolates the paths (and time) MC needs to match the PDE
+ */
+
+namespace {
+    const double SPOT = 1.0, STRIKE = 1.0, VOL = 0.2, RATE = 0.03, DIV = 0.06, T = 1.0;
+
+    double ClosedForm() {
+        const double sd = VOL * sqrt(T);
+        const double d1 = (log(SPOT / STRIKE) + (RATE - DIV) * T) / sd + 0.5 * sd;
+        return SPOT * exp(-DIV * T) * NCDF(d1) - STRIKE * exp(-RATE * T) * NCDF(d1 - sd);
+    }
+
+    double PDEPrice(int n_points, int n_steps) {
+        const double sd = VOL * sqrt(T);
+        const Vector_<> grid = PDE::ConcentratedGrid(log(SPOT) - 6.0 * sd, log(SPOT) + 6.0 * sd, n_points, log(STRIKE));
+        Matrix_<> values(n_points, 1);
+        for (int i = 0; i < n_points; ++i)
+            values(i, 0) = Max(exp(grid[i]) - STRIKE, 0.0);
+        PDE::RollBack(PDE::LogNormal_(RATE, DIV, VOL), grid, Vector::XRange(0.0, T, n_steps + 1), &values);
+        return PDE::ValuesAt(grid, values, log(SPOT))[0];
+    }
+} // namespace
+
+int main() {
+    const double exact = ClosedForm();
+    cout << "closed form: " << setprecision(8) << exact << endl << endl;
+
+    cout << "PDE" << endl << setw(8) << "points" << setw(8) << "steps" << setw(14) << "error" << setw(12) << "time (us)"
+         << endl;
+    double pdeError = 0.0;
+    int64_t pdeTime = 0;
+    for (int n : {51, 101, 201, 401}) {
+        Timer_ timer;
+        const double price = PDEPrice(n, n / 2);
+        pdeTime = Max<int64_t>(1, timer.Elapsed<microseconds>());
+        pdeError = fabs(price - exact);
+        cout << setw(8) << n << setw(8) << n / 2 << setw(14) << setprecision(3) << scientific << pdeError << fixed
+             << setw(12) << pdeTime << endl;
+    }
+
+    cout << endl << "MC" << endl << setw(10) << "paths" << setw(14) << "std error" << setw(12) << "time (us)"
+         << setw(20) << "paths to match PDE" << setw(14) << "time (s)" << endl;
+    European_<double> prd(STRIKE, T);
+    BlackScholes_<double> mdl(SPOT, VOL, false, RATE, DIV);
+    for (int nPaths : {10000, 100000, 1000000}) {
+        std::unique_ptr<Random_> rand(New(RNGType_("MRG32"), 1234));
+        Timer_ timer;
+        const auto res = MCSimulation(prd, mdl, rand, nPaths);
+        const int64_t mcTime = Max<int64_t>(1, timer.Elapsed<microseconds>());
+        double sum = 0.0, sum2 = 0.0;
+        for (int row = 0; row < res.Rows(); ++row) {
+            sum += res(row, 0);
+            sum2 += Square(res(row, 0));
+        }
+        const double mean = sum / nPaths;
+        const double stdError = sqrt((sum2 / nPaths - mean * mean) / nPaths);
+        const double needed = nPaths * Square(stdError / pdeError);
+        cout << setw(10) << nPaths << setw(14) << setprecision(3) << scientific << stdError << fixed << setw(12)
+             << mcTime << setw(20) << setprecision(0) << needed << setw(14) << setprecision(1)
+             << mcTime * 1.0e-6 * needed / nPaths << endl;
+    }
+    cout << endl << "finest PDE: " << pdeTime << " us" << endl;
+    return 0;
+}
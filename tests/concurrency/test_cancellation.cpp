@@ -0,0 +1,41 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <gtest/gtest.h>
+#include <dal/concurrency/cancellation.hpp>
+#include <dal/concurrency/threadpool.hpp>
+#include <thread>
+
+using namespace Dal;
+
+TEST(CancellationTest, TestCancelSharedByCopies) {
+    CancellationToken_ token;
+    const CancellationToken_ copy(token);
+    ASSERT_FALSE(copy.IsCancelled());
+    ASSERT_FALSE(copy.HasDeadline());
+    token.Cancel();
+    ASSERT_TRUE(copy.IsCancelled());
+}
+
+TEST(CancellationTest, TestDeadline) {
+    auto token = CancellationToken_::WithTimeout(std::chrono::milliseconds(20));
+    ASSERT_TRUE(token.HasDeadline());
+    ASSERT_FALSE(token.IsCancelled());
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    ASSERT_TRUE(token.IsCancelled());
+}
+
+TEST(CancellationTest, TestQueuedTasksAreDropped) {
+    ThreadPool_ pool("cancel");
+    CancellationToken_ token;
+    int runs = 0;
+    auto f1 = pool.SpawnTask([&]() { ++runs; return true; }, token);
+    token.Cancel();
+    auto f2 = pool.SpawnTask([&]() { ++runs; return true; }, token);
+    pool.ActiveWaite(f1);
+    pool.ActiveWaite(f2);
+    ASSERT_FALSE(f1.get());
+    ASSERT_FALSE(f2.get());
+    ASSERT_EQ(runs, 0);
+}
@@ -0,0 +1,82 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <gtest/gtest.h>
+#include <dal/concurrency/taskgraph.hpp>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/utilities/exceptions.hpp>
+#include <atomic>
+
+using namespace Dal;
+
+TEST(TaskGraphTest, TestDependenciesAreRespected) {
+    ThreadPool_ pool("graph", 2);
+    TaskGraph_ graph;
+    std::atomic<int> clock(0);
+    Vector_<int> finished(5, -1);
+    auto stamp = [&](int i) { return [&, i]() { finished[i] = clock++; }; };
+
+    // curves of two currencies, a calibration using both, two simulations on the calibrated model
+    const int usd = graph.Add("USD curve", stamp(0));
+    const int eur = graph.Add("EUR curve", stamp(1));
+    const int calib = graph.Add("calibrate", stamp(2), {usd, eur});
+    const int sim1 = graph.Add("simulate 1", stamp(3), {calib});
+    const int sim2 = graph.Add("simulate 2", stamp(4), {calib, usd});
+    ASSERT_EQ(graph.Size(), 5);
+    ASSERT_EQ(graph.Name(calib), String_("calibrate"));
+
+    graph.Run(&pool);
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(graph.Status(i), TaskGraph_::Status_::DONE);
+    ASSERT_GT(finished[calib], finished[usd]);
+    ASSERT_GT(finished[calib], finished[eur]);
+    ASSERT_GT(finished[sim1], finished[calib]);
+    ASSERT_GT(finished[sim2], finished[calib]);
+}
+
+TEST(TaskGraphTest, TestFailurePropagatesToDependants) {
+    ThreadPool_ pool("graph", 2);
+    TaskGraph_ graph;
+    std::atomic<int> runs(0);
+    const int bad = graph.Add("bad curve", []() { THROW("no quotes"); });
+    const int good = graph.Add("good curve", [&]() { ++runs; });
+    const int child = graph.Add("child", [&]() { ++runs; }, {bad});
+    const int grandChild = graph.Add("grand child", [&]() { ++runs; }, {child, good});
+    const int independent = graph.Add("independent", [&]() { ++runs; }, {good});
+
+    ASSERT_THROW(graph.Run(&pool), Exception_);
+    ASSERT_EQ(graph.Status(bad), TaskGraph_::Status_::FAILED);
+    ASSERT_TRUE(graph.Error(bad) != nullptr);
+    ASSERT_EQ(graph.Status(child), TaskGraph_::Status_::SKIPPED);
+    ASSERT_EQ(graph.Status(grandChild), TaskGraph_::Status_::SKIPPED);
+    ASSERT_EQ(graph.Status(good), TaskGraph_::Status_::DONE);
+    ASSERT_EQ(graph.Status(independent), TaskGraph_::Status_::DONE);
+    ASSERT_EQ(runs, 2);
+}
+
+TEST(TaskGraphTest, TestRunWithoutWorkers) {
+    ThreadPool_ pool("empty");
+    TaskGraph_ graph;
+    int sum = 0;
+    const int a = graph.Add("a", [&]() { sum += 1; });
+    graph.Add("b", [&]() { sum *= 10; }, {a});
+    graph.Run(&pool);
+    ASSERT_EQ(sum, 10);
+}
+
+TEST(TaskGraphTest, TestCancelledGraphIsSkipped) {
+    TaskGraph_ graph;
+    int runs = 0;
+    graph.Add("a", [&]() { ++runs; });
+    CancellationToken_ token;
+    token.Cancel();
+    graph.Run(nullptr, token);
+    ASSERT_EQ(runs, 0);
+    ASSERT_EQ(graph.Status(0), TaskGraph_::Status_::SKIPPED);
+}
+
+TEST(TaskGraphTest, TestInvalidDependency) {
+    TaskGraph_ graph;
+    ASSERT_THROW(graph.Add("a", []() {}, {0}), Exception_);
+}
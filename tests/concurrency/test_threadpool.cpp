@@ -0,0 +1,140 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <gtest/gtest.h>
+#include <dal/concurrency/threadpool.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace Dal;
+
+TEST(ThreadPoolTest, TestDefaultInstance) {
+    ThreadPool_* pool = ThreadPool_::GetInstance();
+    ASSERT_EQ(pool, ThreadPool_::GetInstance());
+    ASSERT_EQ(pool->Name(), String_("default"));
+    ASSERT_EQ(pool->ThreadNum(), 0);
+}
+
+TEST(ThreadPoolTest, TestIndependentPools) {
+    ThreadPool_ intraday("intraday", 2);
+    ThreadPool_ batch("batch", 3);
+    ASSERT_EQ(intraday.NumThreads(), 2);
+    ASSERT_EQ(batch.NumThreads(), 3);
+    ASSERT_EQ(intraday.Name(), String_("intraday"));
+
+    const int nTasks = 64;
+    std::atomic<int> done(0);
+    Vector_<TaskHandle_> futures;
+    for (int i = 0; i < nTasks; ++i) {
+        futures.push_back(intraday.SpawnTask([&]() {
+            // a worker of one pool is not a worker of the other
+            const bool ok = intraday.ThreadNum() <= intraday.NumThreads() && batch.ThreadNum() == 0;
+            ++done;
+            return ok;
+        }));
+        futures.push_back(batch.SpawnTask([&]() {
+            const bool ok = batch.ThreadNum() <= batch.NumThreads() && intraday.ThreadNum() == 0;
+            ++done;
+            return ok;
+        }));
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        (i % 2 == 0 ? intraday : batch).ActiveWaite(futures[i]);
+        ASSERT_TRUE(futures[i].get());
+    }
+    ASSERT_EQ(done, 2 * nTasks);
+}
+
+TEST(ThreadPoolTest, TestStartStop) {
+    ThreadPool_ pool("scratch");
+    ASSERT_EQ(pool.NumThreads(), 0);
+    pool.Start(2);
+    ASSERT_EQ(pool.NumThreads(), 2);
+    pool.Stop();
+    ASSERT_EQ(pool.NumThreads(), 0);
+
+    // with no worker, the task is run by the waiting thread
+    auto f = pool.SpawnTask([]() { return true; });
+    ASSERT_TRUE(pool.ActiveWaite(f));
+    ASSERT_TRUE(f.get());
+}
+
+TEST(ThreadPoolTest, TestStats) {
+    ThreadPool_ pool("stats", 2);
+    pool.Instrument(true);
+    ASSERT_TRUE(pool.IsInstrumented());
+
+    const int nTasks = 16;
+    Vector_<TaskHandle_> futures;
+    for (int i = 0; i < nTasks; ++i)
+        futures.push_back(pool.SpawnTask([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return true;
+        }));
+    for (auto& f : futures)
+        pool.ActiveWaite(f);
+
+    const auto stats = pool.Stats();
+    ASSERT_EQ(stats.submitted_, nTasks);
+    ASSERT_EQ(stats.completed_, nTasks);
+    ASSERT_EQ(stats.queueDepth_, 0);
+    ASSERT_GE(stats.queueHighWater_, 1);
+    ASSERT_LE(stats.executedInline_, nTasks);
+    ASSERT_EQ(stats.latencyHistogram_.size(), ThreadPoolStats_::N_LATENCY_BUCKETS);
+    size_t nTimed = 0;
+    for (auto n : stats.latencyHistogram_)
+        nTimed += n;
+    ASSERT_EQ(nTimed, nTasks);
+    ASSERT_EQ(stats.busySeconds_.size(), 2);
+    double busy = 0.0;
+    for (size_t i = 0; i < 2; ++i) {
+        busy += stats.busySeconds_[i];
+        ASSERT_GE(stats.Utilisation(i), 0.0);
+        ASSERT_LE(stats.Utilisation(i), 1.0);
+    }
+    // tasks which were not run inline kept the workers busy for at least 1ms each
+    ASSERT_GE(busy, 1.0e-3 * (nTasks - stats.executedInline_) * 0.9);
+
+    pool.ResetStats();
+    const auto reset = pool.Stats();
+    ASSERT_EQ(reset.submitted_, 0);
+    ASSERT_EQ(reset.completed_, 0);
+    ASSERT_EQ(reset.busySeconds_[0], 0.0);
+}
+
+TEST(ThreadPoolTest, TestStatsInlineExecution) {
+    ThreadPool_ pool("inline");
+    pool.Instrument(true);
+    auto f = pool.SpawnTask([]() { return true; });
+    ASSERT_EQ(pool.Stats().queueDepth_, 1);
+    pool.ActiveWaite(f);
+    const auto stats = pool.Stats();
+    ASSERT_EQ(stats.executedInline_, 1);
+    ASSERT_EQ(stats.completed_, 1);
+    ASSERT_EQ(stats.queueDepth_, 0);
+
+    // not instrumented: nothing is counted
+    pool.Instrument(false);
+    pool.ResetStats();
+    auto g = pool.SpawnTask([]() { return true; });
+    ASSERT_EQ(pool.Stats().queueDepth_, 0);
+    pool.ActiveWaite(g);
+    ASSERT_EQ(pool.Stats().completed_, 0);
+}
+
+TEST(ThreadPoolTest, TestParallelBlocks) {
+    ThreadPool_ pool("blocks", 3);
+    for (ThreadPool_* p : {static_cast<ThreadPool_*>(nullptr), &pool})
+        for (int n : {0, 5, 64, 1001}) {
+            Vector_<int> hits(n, 0);
+            ParallelBlocks(p, n, 64, [&](int begin, int end) {
+                ASSERT_LE(end - begin, 64);
+                for (int i = begin; i < end; ++i)
+                    ++hits[i];
+            });
+            for (int i = 0; i < n; ++i)
+                ASSERT_EQ(hits[i], 1);
+        }
+}
@@ -0,0 +1,55 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <gtest/gtest.h>
+#include <dal/concurrency/threadpool.hpp>
+#include <cstdint>
+
+using namespace Dal;
+
+namespace {
+    struct OtherUse_ {};
+}
+
+TEST(WorkspaceTest, TestCacheAligned) {
+    Vector_<CacheAligned_<int>> v(4);
+    for (size_t i = 0; i < v.size(); ++i)
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(&v[i]) % CACHE_LINE_SIZE, 0);
+    ASSERT_EQ(sizeof(CacheAligned_<int>), CACHE_LINE_SIZE);
+}
+
+TEST(WorkspaceTest, TestSlotsPerWorker) {
+    ThreadPool_ pool("workspace", 3);
+    auto& ws = pool.Workspace<Vector_<>>();
+    ASSERT_EQ(ws.Size(), 4);
+    ASSERT_EQ(&ws, &pool.Workspace<Vector_<>>());
+    // a different tag gives a different workspace
+    ASSERT_NE(static_cast<void*>(&ws), static_cast<void*>(&pool.Workspace<Vector_<>, OtherUse_>()));
+
+    Vector_<TaskHandle_> futures;
+    for (int i = 0; i < 32; ++i)
+        futures.push_back(pool.SpawnTask([&]() {
+            auto& mine = pool.Workspace<Vector_<>>().Mine(pool.ThreadNum());
+            mine.push_back(1.0);
+            return true;
+        }));
+    for (auto& f : futures)
+        pool.ActiveWaite(f);
+
+    // every task appended to exactly one buffer, and the buffers persist
+    size_t total = ws.Mine(0).size();
+    for (size_t i = 1; i < ws.Size(); ++i)
+        total += ws[i].size();
+    ASSERT_EQ(total, 32);
+}
+
+TEST(WorkspaceTest, TestOutsiderSlot) {
+    ThreadPool_ pool("outsider", 1);
+    auto& ws = pool.Workspace<int, OtherUse_>();
+    ws.Mine(0) = 42;
+    ASSERT_EQ(ws.Mine(0), 42);
+    ws[1] = 7;
+    ASSERT_EQ(ws.Mine(1), 7);
+    ASSERT_EQ(ws.Mine(0), 42);
+}
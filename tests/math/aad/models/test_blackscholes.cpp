@@ -2,12 +2,15 @@
 // Created by wegam on 2021/12/25.
 //
 
+#include <dal/concurrency/threadpool.hpp>
 #include <dal/math/aad/models/blackscholes.hpp>
 #include <dal/math/aad/products/european.hpp>
 #include <dal/math/random/quasirandom.hpp>
 #include <dal/math/random/sobol.hpp>
 #include <dal/math/aad/simulation.hpp>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Dal;
 
@@ -34,6 +37,113 @@ TEST(BlackScholesTest, TestBlackScholes) {
     ASSERT_NEAR(calculated, expected, 1e-5);
 }
 
+TEST(BlackScholesTest, TestBlackScholesParallelOnDedicatedPool) {
+    Time_ exerciseTime = 2.0;
+    const double strike = 11.0;
+    const double spot = 10.0;
+    const double vol = 0.20;
+    const double rate = 0.034;
+    const double div = 0.021;
+    const int n_paths = 200000;
+
+    European_<double> prd(strike, exerciseTime);
+    BlackScholes_<double> mdl(spot, vol, false, rate, div);
+
+    ThreadPool_ pool("pricing", 2);
+    std::unique_ptr<PseudoRandom_> rand(New(RNGType_("MRG32"), 1234));
+    auto res = MCParallelSimulation(prd, mdl, rand, n_paths, &pool);
+    ASSERT_EQ(res.Rows(), n_paths);
+    auto sum = 0.0;
+    for (auto row = 0; row < res.Rows(); ++row)
+        sum += res(row, 0);
+    ASSERT_NEAR(sum / n_paths, 0.806119, 1e-2);
+}
+TEST(BlackScholesTest, TestBlackScholesConcurrentCallers) {
+    // two threads outside the pool run each other's batches inline, both as ThreadNum() 0
+    European_<double> prd(11.0, 2.0);
+    BlackScholes_<double> mdl(10.0, 0.2, false, 0.034, 0.021);
+    const int n_paths = 300000;
+    ThreadPool_ pool("pricing", 1);
+    std::unique_ptr<PseudoRandom_> rand(New(RNGType_("MRG32"), 1234));
+    const Matrix_<> expected = MCParallelSimulation(prd, mdl, rand, n_paths, &pool);
+
+    Matrix_<> res[2];
+    auto caller = [&](int i) {
+        std::unique_ptr<PseudoRandom_> mine(New(RNGType_("MRG32"), 1234));
+        res[i] = MCParallelSimulation(prd, mdl, mine, n_paths, &pool);
+    };
+    std::thread a(caller, 0), b(caller, 1);
+    a.join();
+    b.join();
+    for (const auto& r : res) {
+        ASSERT_EQ(r.Rows(), n_paths);
+        for (int row = 0; row < n_paths; ++row)
+            ASSERT_EQ(r(row, 0), expected(row, 0));
+    }
+}
+
+TEST(BlackScholesTest, TestBlackScholesCancelled) {
+    European_<double> prd(11.0, 2.0);
+    BlackScholes_<double> mdl(10.0, 0.2, false, 0.034, 0.021);
+    CancellationToken_ token;
+    token.Cancel();
+
+    std::unique_ptr<Random_> rand(NewSobol(1, 0));
+    auto res = MCSimulation(prd, mdl, rand, 1000, token);
+    ASSERT_EQ(res.Rows(), 0);
+
+    ThreadPool_ pool("pricing", 2);
+    std::unique_ptr<PseudoRandom_> rand2(New(RNGType_("MRG32"), 1234));
+    res = MCParallelSimulation(prd, mdl, rand2, 1000, &pool, token);
+    ASSERT_EQ(res.Rows(), 0);
+}
+
+namespace {
+    // cancels the token from inside the payoff once a fixed number of paths has been priced
+    class CancelAfter_ : public European_<double> {
+        CancellationToken_ token_;
+        int nPaths_;
+        mutable std::atomic<int> priced_;
+
+    public:
+        CancelAfter_(const CancellationToken_& token, int n_paths)
+            : European_<double>(11.0, 2.0), token_(token), nPaths_(n_paths), priced_(0) {}
+
+    protected:
+        void PayoffsImpl(const Scenario_<double>& path, Matrix_<double>::Row_& payoffs) const override {
+            European_<double>::PayoffsImpl(path, payoffs);
+            if (++priced_ == nPaths_)
+                token_.Cancel();
+        }
+    };
+} // namespace
+
+TEST(BlackScholesTest, TestBlackScholesCancelledGivesPrefix) {
+    BlackScholes_<double> mdl(10.0, 0.2, false, 0.034, 0.021);
+    const European_<double> full(11.0, 2.0);
+    const int n_paths = 20000;
+    const int n_priced = 1234;
+
+    std::unique_ptr<Random_> rand(NewSobol(1, n_paths));
+    const Matrix_<> expected = MCSimulation(full, mdl, rand, n_paths);
+    CancellationToken_ token;
+    rand.reset(NewSobol(1, n_paths));
+    auto res = MCSimulation(CancelAfter_(token, n_priced), mdl, rand, n_paths, token);
+    ASSERT_EQ(res.Rows(), n_priced);
+    for (int row = 0; row < n_priced; ++row)
+        ASSERT_EQ(res(row, 0), expected(row, 0));
+
+    // fewer paths than a batch, so a single task prices them in order
+    ThreadPool_ pool("pricing", 2);
+    std::unique_ptr<PseudoRandom_> rand2(New(RNGType_("MRG32"), 1234));
+    const Matrix_<> expected2 = MCParallelSimulation(full, mdl, rand2, n_paths, &pool);
+    CancellationToken_ token2;
+    res = MCParallelSimulation(CancelAfter_(token2, n_priced), mdl, rand2, n_paths, &pool, token2);
+    ASSERT_EQ(res.Rows(), n_priced);
+    ASSERT_EQ(res.Cols(), 1);
+    for (int row = 0; row < n_priced; ++row)
+        ASSERT_EQ(res(row, 0), expected2(row, 0));
+}
 
 TEST(BlackScholesTest, TestBlackScholesAAD) {
 
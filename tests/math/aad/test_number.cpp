@@ -394,4 +394,27 @@ TEST(AADNumberTest, TestNumberFabs) {
     Number_::tape_->Rewind();
 }
 
+TEST(AADNumberTest, TestNumberNormalCdf) {
+    Number_::tape_->Clear();
+    Number_ s1(-0.7);
+
+    auto value = NormalCdf(s1);
+    ASSERT_NEAR(value.Value(), 0.5 * std::erfc(0.7 / std::sqrt(2.0)), 1e-14);
+    value.PropagateToStart();
+    ASSERT_NEAR(s1.Adjoint(), std::exp(-0.245) / std::sqrt(2.0 * M_PI), 1e-14);
+    Number_::tape_->Rewind();
+}
+
+
+TEST(AADNumberTest, TestNumberNormalDens) {
+    Number_::tape_->Clear();
+    Number_ s1(-0.7);
+
+    auto value = NormalDens(s1);
+    ASSERT_NEAR(value.Value(), std::exp(-0.245) / std::sqrt(2.0 * M_PI), 1e-14);
+    value.PropagateToStart();
+    ASSERT_NEAR(s1.Adjoint(), 0.7 * std::exp(-0.245) / std::sqrt(2.0 * M_PI), 1e-14);
+    Number_::tape_->Rewind();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/analytics/black.hpp>
+#include <dal/platform/simd.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    // strikes and expiries across the wings, with expired and zero-vol options and both types
+    Black::Book_ MakeBook(int size) {
+        Black::Book_ ret_val;
+        for (int k = 0; k < size; ++k) {
+            const double strike = 100.0 * std::exp(2.0 * std::sin(0.37 * k));
+            const double expiry = k % 29 == 0 ? 0.0 : 0.01 + 0.1 * (k % 41);
+            const double vol = k % 31 == 0 ? 0.0 : 0.05 + 0.01 * (k % 53);
+            ret_val.Add(k % 3 != 0, 100.0, strike, expiry, vol, std::exp(-0.03 * expiry));
+        }
+        return ret_val;
+    }
+
+    void CheckAgainstScalar(const Black::Book_& book, const Black::BookGreeks_& greeks) {
+        for (int k = 0; k < book.Size(); ++k) {
+            const auto g = Black::Greeks(book.omega_[k] > 0.0, book.forward_[k], book.strike_[k], book.expiry_[k],
+                                         book.vol_[k], book.discount_[k]);
+            ASSERT_NEAR(greeks.price_[k], g.price_, 1e-12 * (1.0 + g.price_));
+            ASSERT_NEAR(greeks.delta_[k], g.delta_, 1e-13);
+            ASSERT_NEAR(greeks.gamma_[k], g.gamma_, 1e-13 * (1.0 + g.gamma_));
+            ASSERT_NEAR(greeks.vega_[k], g.vega_, 1e-12 * (1.0 + g.vega_));
+            ASSERT_NEAR(greeks.theta_[k], g.theta_, 1e-12 * (1.0 - g.theta_));
+        }
+    }
+} // namespace
+
+TEST(BlackTest, TestScalarGreeks) {
+    // at the money, the call is F (2 N(sigma sqrt(T) / 2) - 1)
+    ASSERT_NEAR(Black::Price(true, 100.0, 100.0, 1.0, 0.2, 1.0), 7.965567455405804, 1e-12);
+    const double f = 102.0, strike = 95.0, t = 1.5, vol = 0.25, df = 0.96;
+    const double call = Black::Price(true, f, strike, t, vol, df);
+    const double put = Black::Price(false, f, strike, t, vol, df);
+    ASSERT_NEAR(call - put, df * (f - strike), 1e-12);
+
+    const double h = 1e-4;
+    for (bool isCall : {true, false}) {
+        const auto g = Black::Greeks(isCall, f, strike, t, vol, df);
+        auto price = [&](double ff, double tt, double vv) { return Black::Price(isCall, ff, strike, tt, vv, df); };
+        ASSERT_NEAR(g.price_, isCall ? call : put, 1e-14);
+        ASSERT_NEAR(g.delta_, (price(f + h, t, vol) - price(f - h, t, vol)) / (2.0 * h), 1e-8);
+        ASSERT_NEAR(g.gamma_, (price(f + h, t, vol) - 2.0 * g.price_ + price(f - h, t, vol)) / (h * h), 1e-5);
+        ASSERT_NEAR(g.vega_, (price(f, t, vol + h) - price(f, t, vol - h)) / (2.0 * h), 1e-6);
+        ASSERT_NEAR(g.theta_, -(price(f, t + h, vol) - price(f, t - h, vol)) / (2.0 * h), 1e-6);
+    }
+
+    // expired: the intrinsic value
+    const auto expired = Black::Greeks(false, f, strike, 0.0, vol, df);
+    ASSERT_DOUBLE_EQ(expired.price_, 0.0);
+    ASSERT_DOUBLE_EQ(Black::Price(true, f, strike, 1.0, 0.0, df), df * (f - strike));
+    ASSERT_DOUBLE_EQ(Black::Greeks(true, f, strike, 0.0, vol, df).delta_, df);
+}
+
+TEST(BlackTest, TestBatchAllSimdLevels) {
+    // the size leaves a remainder for the scalar lanes at every vector width
+    const Black::Book_ book = MakeBook(1003);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Black::BookGreeks_ greeks;
+        Black::Greeks(book, &greeks);
+        CheckAgainstScalar(book, greeks);
+        Vector_<> prices;
+        Black::Price(book, &prices);
+        for (int k = 0; k < book.Size(); ++k)
+            ASSERT_DOUBLE_EQ(prices[k], greeks.price_[k]);
+    }
+}
+
+TEST(BlackTest, TestBatchParallel) {
+    ThreadPool_ pool("black", 3);
+    const Black::Book_ book = MakeBook(10007);
+    Black::BookGreeks_ serial, parallel;
+    Black::Greeks(book, &serial);
+    Black::Greeks(book, &parallel, &pool);
+    for (int k = 0; k < book.Size(); ++k) {
+        ASSERT_EQ(parallel.price_[k], serial.price_[k]);
+        ASSERT_EQ(parallel.theta_[k], serial.theta_[k]);
+    }
+    Black::Book_ bad = book;
+    bad.vol_.pop_back();
+    ASSERT_THROW(Black::Greeks(bad, &serial), Exception_);
+}
+
+TEST(BlackTest, TestNumberAdjoints) {
+    Number_::tape_->Clear();
+    Number_ f(102.0), strike(95.0), t(1.5), vol(0.25), df(0.96);
+    Number_ price = Black::Price(true, f, strike, t, vol, df);
+    price.PropagateToStart();
+    const auto g = Black::Greeks(true, 102.0, 95.0, 1.5, 0.25, 0.96);
+    ASSERT_NEAR(price.Value(), g.price_, 1e-14);
+    ASSERT_NEAR(f.Adjoint(), g.delta_, 1e-12);
+    ASSERT_NEAR(vol.Adjoint(), g.vega_, 1e-11);
+    ASSERT_NEAR(t.Adjoint(), -g.theta_, 1e-11);
+    ASSERT_NEAR(df.Adjoint(), g.price_ / 0.96, 1e-12);
+    Number_::tape_->Rewind();
+}
@@ -0,0 +1,94 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/analytics/black.hpp>
+#include <dal/math/analytics/impliedvol.hpp>
+#include <dal/platform/simd.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    // a chain across strikes, expiries and vols, priced with Black's formula; returns the vols used
+    // options too far out of the money for the price to carry the vol are left out
+    Vector_<> MakeChain(int size, Black::Quotes_* quotes) {
+        Vector_<> ret_val;
+        for (int k = 0; ret_val.size() < size; ++k) {
+            const double strike = 100.0 * std::exp(1.5 * std::sin(0.37 * k));
+            const double expiry = 0.02 + 0.25 * (k % 37);
+            const double vol = 0.03 + 0.02 * (k % 61);
+            const double df = std::exp(-0.02 * expiry);
+            const bool call = k % 2 == 0;
+            if (Black::Greeks(call, 100.0, strike, expiry, vol, df).vega_ < 1e-8)
+                continue;
+            quotes->Add(call, 100.0, strike, expiry, df, Black::Price(call, 100.0, strike, expiry, vol, df));
+            ret_val.push_back(vol);
+        }
+        return ret_val;
+    }
+
+    // the vol can only be recovered as far as the price determines it
+    double Tolerance(const Black::Quotes_& quotes, int k, double vol) {
+        const auto g = Black::Greeks(quotes.omega_[k] > 0.0, quotes.forward_[k], quotes.strike_[k], quotes.expiry_[k],
+                                     vol, quotes.discount_[k]);
+        return 1e-10 * vol + 1e-14 * quotes.forward_[k] / g.vega_;
+    }
+} // namespace
+
+TEST(ImpliedVolTest, TestScalarRoundTrip) {
+    for (bool call : {true, false})
+        for (double strike : {20.0, 60.0, 95.0, 100.0, 105.0, 150.0, 400.0})
+            for (double expiry : {0.01, 0.5, 2.0, 10.0, 30.0})
+                for (double vol : {0.01, 0.1, 0.3, 1.0, 2.5}) {
+                    const double price = Black::Price(call, 100.0, strike, expiry, vol, 0.9);
+                    const double vega = Black::Greeks(call, 100.0, strike, expiry, vol, 0.9).vega_;
+                    if (vega < 1e-8)
+                        continue;
+                    const double implied = Black::ImpliedVol(call, 100.0, strike, expiry, 0.9, price);
+                    ASSERT_NEAR(implied, vol, 1e-10 * vol + 1e-12 / vega);
+                }
+
+    // outside the no-arbitrage bounds, and at the intrinsic value
+    ASSERT_TRUE(std::isnan(Black::ImpliedVol(true, 100.0, 90.0, 1.0, 1.0, 9.0)));
+    ASSERT_TRUE(std::isnan(Black::ImpliedVol(false, 100.0, 90.0, 1.0, 1.0, 100.0)));
+    ASSERT_TRUE(std::isnan(Black::ImpliedVol(true, 100.0, 90.0, 1.0, 1.0, 100.0)));
+    ASSERT_TRUE(std::isnan(Black::ImpliedVol(true, 100.0, 90.0, 0.0, 1.0, 12.0)));
+    ASSERT_TRUE(std::isnan(Black::ImpliedVol(true, -1.0, 90.0, 1.0, 1.0, 12.0)));
+    ASSERT_EQ(Black::ImpliedVol(false, 100.0, 90.0, 1.0, 0.5, 0.0), 0.0);
+}
+
+TEST(ImpliedVolTest, TestBatchAllSimdLevels) {
+    // the size leaves a remainder for the scalar solver at every vector width
+    Black::Quotes_ quotes;
+    const Vector_<> vols = MakeChain(2003, &quotes);
+    quotes.Add(true, 100.0, 90.0, 1.0, 1.0, 9.0);
+    quotes.Add(true, 100.0, 90.0, 0.0, 1.0, 12.0);
+    quotes.Add(false, 100.0, 90.0, 1.0, 1.0, 0.0);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Vector_<> implied;
+        Black::ImpliedVol(quotes, &implied);
+        ASSERT_EQ(implied.size(), quotes.Size());
+        for (int k = 0; k < vols.size(); ++k)
+            ASSERT_NEAR(implied[k], vols[k], Tolerance(quotes, k, vols[k]));
+        ASSERT_TRUE(std::isnan(implied[vols.size()]));
+        ASSERT_TRUE(std::isnan(implied[vols.size() + 1]));
+        ASSERT_EQ(implied[vols.size() + 2], 0.0);
+    }
+}
+
+TEST(ImpliedVolTest, TestBatchParallel) {
+    ThreadPool_ pool("implied", 3);
+    Black::Quotes_ quotes;
+    MakeChain(10007, &quotes);
+    Vector_<> serial, parallel;
+    Black::ImpliedVol(quotes, &serial);
+    Black::ImpliedVol(quotes, &parallel, &pool);
+    for (int k = 0; k < quotes.Size(); ++k)
+        ASSERT_EQ(parallel[k], serial[k]);
+    quotes.price_.pop_back();
+    ASSERT_THROW(Black::ImpliedVol(quotes, &serial), Exception_);
+}
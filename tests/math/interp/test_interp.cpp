@@ -2,7 +2,11 @@
 // Created by wegam on 2020/11/10.
 //
 
+#include <algorithm>
 #include <dal/math/interp/interp.hpp>
+#include <dal/math/interp/pieces.hpp>
+#include <dal/platform/simd.hpp>
+#include <dal/utilities/algorithms.hpp>
 #include <dal/platform/platform.hpp>
 #include <gtest/gtest.h>
 
@@ -62,3 +66,45 @@ TEST(InterpTest, TestNewLinear) {
     ASSERT_DOUBLE_EQ(f[4], (*interp)(x[4] + 1.));
     ASSERT_DOUBLE_EQ((f[2] + f[3]) / 2., (*interp)((x[2] + x[3]) / 2.));
 }
+
+namespace {
+    // sorted, nearly sorted and reversed orders, with queries beyond both ends and on the knots
+    Vector_<Vector_<>> QueryOrders(double lo, double hi, const Vector_<>& knots) {
+        Vector_<> sorted = Dal::Vector::XRange(lo, hi, 103);
+        sorted.Append(knots);
+        std::sort(sorted.begin(), sorted.end());
+        Vector_<> nearly(sorted);
+        for (int k = 0; k + 1 < nearly.size(); k += 3)
+            std::swap(nearly[k], nearly[k + 1]);
+        Vector_<> reversed(sorted.rbegin(), sorted.rend());
+        return {sorted, nearly, reversed};
+    }
+} // namespace
+
+TEST(InterpTest, TestLocate) {
+    const Vector_<> knots = {1.0, 2.0, 2.0, 3.5, 4.0, 7.0};
+    for (const auto& xs : QueryOrders(0.0, 8.0, knots)) {
+        Vector_<int> index;
+        Dal::Interp::Locate(knots, xs, &index);
+        ASSERT_EQ(index.size(), xs.size());
+        for (int k = 0; k < xs.size(); ++k)
+            ASSERT_EQ(index[k], Dal::LowerBound(knots, xs[k]) - knots.begin());
+    }
+}
+
+TEST(InterpTest, TestEvaluateLinear) {
+    Vector_<> x = {1., 2., 3., 4., 5.};
+    Vector_<> f = {2.5, 3.5, 1.7, 2.8, 3.6};
+    Handle_<Interp1_> interp(NewLinear("interp", x, f));
+
+    for (auto level : {Dal::SimdLevel_::SCALAR, Dal::SimdLevel_::AVX2, Dal::SimdLevel_::AVX512}) {
+        const Dal::SimdLevelGuard_ guard(level);
+        for (const auto& xs : QueryOrders(0.0, 6.0, x)) {
+            Vector_<> values;
+            interp->Evaluate(xs, &values);
+            ASSERT_EQ(values.size(), xs.size());
+            for (int k = 0; k < xs.size(); ++k)
+                ASSERT_NEAR(values[k], (*interp)(xs[k]), 1e-13);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/interp/interp.hpp>
+#include <dal/math/interp/interp1t.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    const Vector_<> X = {0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0};
+    const Vector_<> F = {0.021, 0.0225, 0.024, 0.027, 0.0285, 0.03, 0.031, 0.0305};
+    const Vector_<> QUERIES = {0.1, 0.3, 0.75, 1.0, 2.5, 4.0, 6.2, 9.9, 12.0};
+
+    // a curve read at several points, as a model's Init would
+    template <class T_> T_ Sum(const Interp1T_<T_>& interp) {
+        T_ ret_val(0.0);
+        for (double q : QUERIES)
+            ret_val = ret_val + interp(q) * q;
+        return ret_val;
+    }
+
+    template <template <class> class I_, class... Args_> void CheckNodeSensitivities(const Args_&... args) {
+        Number_::tape_->Clear();
+        Vector_<Number_> f(F.size());
+        for (int j = 0; j < F.size(); ++j)
+            f[j] = Number_(F[j]);
+        Number_ result = Sum(I_<Number_>(X, f, args...));
+        ASSERT_NEAR(result.Value(), Sum(I_<double>(X, F, args...)), 1e-14);
+        result.PropagateToStart();
+
+        const double bump = 1.0e-6;
+        for (int j = 0; j < F.size(); ++j) {
+            Vector_<> up(F), down(F);
+            up[j] += bump;
+            down[j] -= bump;
+            const double fd = (Sum(I_<double>(X, up, args...)) - Sum(I_<double>(X, down, args...))) / (2.0 * bump);
+            ASSERT_NEAR(f[j].Adjoint(), fd, 1e-7);
+        }
+        Number_::tape_->Rewind();
+    }
+} // namespace
+
+TEST(Interp1TTest, TestLinearMatchesInterp1Linear) {
+    const Interp1Linear_ expected("linear", X, F);
+    const Interp1LinearT_<> interp(X, F);
+    for (double q : QUERIES)
+        ASSERT_DOUBLE_EQ(interp(q), expected(q));
+}
+
+TEST(Interp1TTest, TestCubicMatchesNewCubic) {
+    const Interp::Boundary_ lhs(1, 0.002), rhs(2, 0.0);
+    std::unique_ptr<Interp1_> expected(Interp::NewCubic("cubic", X, F, lhs, rhs));
+    const Cubic1T_<> interp(X, F, lhs, rhs);
+    for (double q : QUERIES)
+        ASSERT_NEAR(interp(q), (*expected)(q), 1e-15);
+}
+
+TEST(Interp1TTest, TestLinearNodeSensitivities) { CheckNodeSensitivities<Interp1LinearT_>(); }
+
+TEST(Interp1TTest, TestCubicNodeSensitivities) {
+    for (int lhs : {1, 2, 3})
+        for (int rhs : {1, 2, 3})
+            CheckNodeSensitivities<Cubic1T_>(Interp::Boundary_(lhs, 0.001), Interp::Boundary_(rhs, -0.002));
+}
@@ -0,0 +1,109 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/interp/interp2.hpp>
+#include <dal/math/interp/interpcubic.hpp>
+#include <dal/math/vectors.hpp>
+#include <dal/storage/splat.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    const Vector_<> X = {0.25, 0.5, 1.0, 2.0, 5.0};
+    const Vector_<> Y = {0.6, 0.8, 0.9, 1.0, 1.1, 1.25, 1.5};
+    const int NX = static_cast<int>(X.size());
+    const int NY = static_cast<int>(Y.size());
+
+    Matrix_<> Grid(double (*f)(double, double)) {
+        Matrix_<> ret_val(X.size(), Y.size());
+        for (int i = 0; i < NX; ++i)
+            for (int j = 0; j < NY; ++j)
+                ret_val(i, j) = f(X[i], Y[j]);
+        return ret_val;
+    }
+
+    double Smile(double t, double k) { return 0.2 + 0.1 * Square(std::log(k)) / std::sqrt(t) - 0.02 * t; }
+
+    // a slice agrees with the surface, whether evaluated point by point or in a batch
+    void CheckSlices(const Interp2_& surface) {
+        const Vector_<> xs = {0.1, 0.25, 0.4, 1.7, 5.0, 7.0};
+        const Vector_<> ys = Vector::XRange(0.4, 1.7, 53);
+        const Vector_<Interp2Slice_> slices = Interp::Slices(surface, xs);
+        const int nx = static_cast<int>(xs.size()), ny = static_cast<int>(ys.size());
+        for (int i = 0; i < nx; ++i) {
+            Vector_<> batch;
+            slices[i].Evaluate(ys, &batch);
+            for (int k = 0; k < ny; ++k) {
+                const double expected = surface(xs[i], ys[k]);
+                ASSERT_NEAR(slices[i](ys[k]), expected, 1e-13);
+                ASSERT_NEAR(batch[k], expected, 1e-13);
+            }
+        }
+    }
+} // namespace
+
+TEST(Interp2Test, TestBilinear) {
+    Handle_<Interp2_> surface(Interp::NewBilinear("bilinear", X, Y, Grid([](double x, double y) {
+                                                      return 1.0 + 2.0 * x - y + 0.5 * x * y;
+                                                  })));
+    for (double x : {0.3, 0.75, 1.9, 4.0})
+        for (double y : {0.65, 0.95, 1.3})
+            ASSERT_NEAR((*surface)(x, y), 1.0 + 2.0 * x - y + 0.5 * x * y, 1e-13);
+    // flat beyond the grid
+    ASSERT_NEAR((*surface)(0.1, 0.3), (*surface)(0.25, 0.6), 1e-14);
+    ASSERT_NEAR((*surface)(9.0, 1.3), (*surface)(5.0, 1.3), 1e-14);
+    CheckSlices(*surface);
+    ASSERT_THROW(Interp::NewBilinear("bad", X, Y, Matrix_<>(2, 2)), Exception_);
+}
+
+TEST(Interp2Test, TestBicubic) {
+    const Matrix_<> z = Grid([](double x, double y) { return std::sin(x) * std::exp(-y); });
+    Handle_<Interp2_> surface(Interp::NewBicubic("bicubic", X, Y, z));
+    // on a y knot, the surface is the natural spline through that column
+    const Interp::Boundary_ natural(2, 0.0);
+    for (int j = 0; j < NY; ++j) {
+        Handle_<Interp1_> column(Interp::NewCubic("column", X, Copy(z.Col(j)), natural, natural));
+        for (double x : Vector::XRange(0.25, 5.0, 20))
+            ASSERT_NEAR((*surface)(x, Y[j]), (*column)(x), 1e-12);
+    }
+    for (int i = 0; i < NX; ++i)
+        for (int j = 0; j < NY; ++j)
+            ASSERT_NEAR((*surface)(X[i], Y[j]), z(i, j), 1e-13);
+    CheckSlices(*surface);
+}
+
+TEST(Interp2Test, TestTotalVariance) {
+    const Matrix_<> z = Grid(Smile);
+    Handle_<Interp2_> surface(Interp::NewTotalVariance("vols", X, Y, z));
+    for (int i = 0; i < NX; ++i)
+        for (int j = 0; j < NY; ++j)
+            ASSERT_NEAR((*surface)(X[i], Y[j]), z(i, j), 1e-13);
+    // total variance is linear between expiries, and vol is flat outside them
+    for (int j = 0; j < NY; ++j) {
+        const double t = 1.4, b = (t - 1.0) / (2.0 - 1.0);
+        const double w = (1.0 - b) * Square(z(2, j)) * 1.0 + b * Square(z(3, j)) * 2.0;
+        ASSERT_NEAR((*surface)(t, Y[j]), std::sqrt(w / t), 1e-13);
+        ASSERT_NEAR((*surface)(0.05, Y[j]), z(0, j), 1e-13);
+        ASSERT_NEAR((*surface)(10.0, Y[j]), z(X.size() - 1, j), 1e-13);
+    }
+    for (double k : Vector::XRange(0.6, 1.5, 19))
+        ASSERT_NEAR((*surface)(1.0, k), Smile(1.0, k), 2e-3);
+    CheckSlices(*surface);
+    ASSERT_THROW(Interp::NewTotalVariance("bad", {0.0, 1.0, 2.0}, Y, Matrix_<>(3, Y.size())), Exception_);
+}
+
+TEST(Interp2Test, TestSplatRoundTrip) {
+    const Matrix_<> z = Grid(Smile);
+    for (const Handle_<Interp2_>& src : {Handle_<Interp2_>(Interp::NewBilinear("bilinear", X, Y, z)),
+                                         Handle_<Interp2_>(Interp::NewBicubic("bicubic", X, Y, z)),
+                                         Handle_<Interp2_>(Interp::NewTotalVariance("vols", X, Y, z))}) {
+        Handle_<Interp2_> dst = handle_cast<Interp2_>(UnSplat(Splat(*src), true));
+        ASSERT_EQ(dst->name_, src->name_);
+        for (double x : {0.1, 0.7, 3.0})
+            for (double y : {0.5, 0.85, 1.2})
+                ASSERT_DOUBLE_EQ((*dst)(x, y), (*src)(x, y));
+    }
+}
@@ -2,9 +2,11 @@
 // Created by wegam on 2020/12/17.
 //
 
+#include <algorithm>
 #include <cmath>
 #include <dal/math/interp/interpcubic.hpp>
 #include <dal/math/vectors.hpp>
+#include <dal/platform/simd.hpp>
 #include <gtest/gtest.h>
 
 using namespace Dal;
@@ -43,4 +45,44 @@ TEST(InterpTest, TestNewCubic) {
         ErrorFunction_ func(interp);
         ASSERT_DOUBLE_EQ(func(x[0]), 0.0);
     }
-}
\ No newline at end of file
+}
+TEST(InterpTest, TestEvaluateCubic) {
+    const Vector_<> x = Vector::XRange(-1.7, 1.9, 17);
+    Handle_<Interp1_> interp(
+        Interp::NewCubic("interp", x, Gaussian(x), Interp::Boundary_(1, 0.3), Interp::Boundary_(2, 0.)));
+    // beyond the knots the end cubics are extrapolated
+    Vector_<> sorted = Vector::XRange(-2.5, 2.5, 211);
+    Vector_<> shuffled(sorted);
+    std::reverse(shuffled.begin(), shuffled.begin() + 100);
+
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        for (const auto& xs : {sorted, shuffled, x}) {
+            Vector_<> values;
+            interp->Evaluate(xs, &values);
+            for (int k = 0; k < xs.size(); ++k)
+                ASSERT_NEAR(values[k], (*interp)(xs[k]), 1e-13);
+        }
+    }
+}
+
+TEST(InterpTest, TestCubicBuilder) {
+    const Vector_<> x = Vector::XRange(-1.7, 1.9, 13);
+    // enough curves to leave a remainder for the scalar lanes at every vector width
+    Matrix_<> f(x.size(), 37);
+    for (int i = 0; i < x.size(); ++i)
+        for (int j = 0; j < f.Cols(); ++j)
+            f(i, j) = std::exp(-x[i] * x[i] * (1.0 + 0.1 * j)) + 0.01 * j * x[i];
+    for (int order : {1, 2, 3}) {
+        const Interp::Boundary_ lhs(order, 0.3), rhs(order, -0.2);
+        const Interp::CubicBuilder_ builder(x, lhs, rhs);
+        const auto splines = builder.Build("curve", f);
+        ASSERT_EQ(splines.size(), f.Cols());
+        for (int j = 0; j < f.Cols(); ++j) {
+            Handle_<Interp1_> single(Interp::NewCubic("single", x, Copy(f.Col(j)), lhs, rhs));
+            for (double z : Vector::XRange(-2.0, 2.0, 41))
+                ASSERT_NEAR((*splines[j])(z), (*single)(z), 1e-12);
+        }
+    }
+    ASSERT_THROW(Interp::CubicBuilder_(x, Interp::Boundary_(4, 0.0), Interp::Boundary_(2, 0.0)), Exception_);
+}
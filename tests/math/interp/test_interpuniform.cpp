@@ -0,0 +1,76 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/interp/interpcubic.hpp>
+#include <dal/math/interp/interpuniform.hpp>
+#include <dal/math/vectors.hpp>
+#include <dal/storage/splat.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    void CheckAgainst(const Interp1_& interp, const Interp1_& expected, const Vector_<>& xs, double tol) {
+        Vector_<> batch;
+        interp.Evaluate(xs, &batch);
+        for (int k = 0; k < xs.size(); ++k) {
+            ASSERT_NEAR(interp(xs[k]), expected(xs[k]), tol);
+            ASSERT_NEAR(batch[k], interp(xs[k]), 1e-14);
+        }
+    }
+} // namespace
+
+TEST(InterpUniformTest, TestUniformMatchesLinear) {
+    const Vector_<> x = Vector::XRange(-1.0, 2.0, 13);
+    Vector_<> f(x.size());
+    for (int i = 0; i < x.size(); ++i)
+        f[i] = std::sin(3.0 * x[i]);
+    Handle_<Interp1_> uniform(Interp::NewUniform("uniform", -1.0, 2.0, f));
+    Handle_<Interp1_> linear(Interp::NewLinear("linear", x, f));
+    Vector_<> xs = Vector::XRange(-1.5, 2.5, 157);
+    xs.Append(x);
+    CheckAgainst(*uniform, *linear, xs, 1e-13);
+    ASSERT_THROW(Interp::NewUniform("bad", 1.0, 1.0, f), Exception_);
+}
+
+TEST(InterpUniformTest, TestLogUniformMatchesLinear) {
+    Vector_<> x(9), f(9);
+    for (int i = 0; i < 9; ++i) {
+        x[i] = 0.25 * std::pow(2.0, 0.5 * i);
+        f[i] = std::log(1.0 + x[i]) * (i % 2 ? 1.0 : 1.1);
+    }
+    Handle_<Interp1_> logUniform(Interp::NewLogUniform("log", x.front(), x.back(), f));
+    Handle_<Interp1_> linear(Interp::NewLinear("linear", x, f));
+    CheckAgainst(*logUniform, *linear, Vector::XRange(0.1, 5.0, 211), 1e-13);
+    ASSERT_THROW(Interp::NewLogUniform("bad", 0.0, 1.0, f), Exception_);
+}
+
+TEST(InterpUniformTest, TestTableInFrontOfCubic) {
+    const Vector_<> x = Vector::XRange(-2.0, 2.0, 9);
+    Vector_<> f(x.size());
+    for (int i = 0; i < x.size(); ++i)
+        f[i] = std::exp(-x[i] * x[i]);
+    Handle_<Interp1_> cubic(Interp::NewCubic("cubic", x, f, Interp::Boundary_(2, 0.0), Interp::Boundary_(2, 0.0)));
+    Handle_<Interp1_> table(Interp::NewTable("table", cubic, -1.0, 1.0, 2001));
+    // linear at spacing 1e-3 on a function with |f''| < 2
+    CheckAgainst(*table, *cubic, Vector::XRange(-1.0, 1.0, 333), 2.5e-7);
+    // outside the range the base is used
+    for (double z : {-1.5, 1.0001, 1.9})
+        ASSERT_DOUBLE_EQ((*table)(z), (*cubic)(z));
+}
+
+TEST(InterpUniformTest, TestSplatRoundTrip) {
+    const Vector_<> x = Vector::XRange(0.0, 1.0, 5);
+    const Vector_<> f = {1.0, 0.5, 0.75, 0.25, 0.0};
+    Handle_<Interp1_> base(Interp::NewCubic("cubic", x, f, Interp::Boundary_(1, 0.0), Interp::Boundary_(1, 0.0)));
+    Handle_<Interp1_> table(Interp::NewTable("table", base, 0.2, 0.8, 65));
+    Handle_<Interp1_> logUniform(Interp::NewLogUniform("log", 0.5, 4.0, f));
+    for (const auto& src : {table, logUniform}) {
+        Handle_<Interp1_> dst = handle_cast<Interp1_>(UnSplat(Splat(*src), true));
+        ASSERT_EQ(dst->name_, src->name_);
+        for (double z : Vector::XRange(-0.5, 4.5, 41))
+            ASSERT_DOUBLE_EQ((*dst)(z), (*src)(z));
+    }
+}
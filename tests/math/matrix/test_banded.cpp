@@ -2,9 +2,13 @@
 // Created by wegam on 2021/2/24.
 //
 
+#include <cmath>
 #include <dal/math/matrix/banded.hpp>
 #include <dal/math/matrix/sparse.hpp>
+#include <dal/math/matrix/squarematrix.hpp>
+#include <dal/platform/simd.hpp>
 #include <gtest/gtest.h>
+#include <memory>
 
 using namespace Dal;
 
@@ -45,4 +49,176 @@ TEST(BandedTest, TestLowerBandAccumulator) {
     Vector_<> v_in{1.0, 2.0};
     acc.Add(v_in, offset);
     acc.Add(2.0 * v_in, offset);
-}
\ No newline at end of file
+}
+
+namespace {
+    Matrix_<> RightHandSides(int n, int m) {
+        Matrix_<> ret_val(n, m);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < m; ++j)
+                ret_val(i, j) = std::sin(1.0 + 0.3 * i + 0.7 * j);
+        return ret_val;
+    }
+
+    // checks that every column x of xs solves mult(x) = b
+    template <class F_> void CheckColumns(const Matrix_<>& bs, const Matrix_<>& xs, const F_& mult) {
+        ASSERT_EQ(xs.Rows(), bs.Rows());
+        ASSERT_EQ(xs.Cols(), bs.Cols());
+        Vector_<> x(xs.Rows()), b;
+        for (int j = 0; j < xs.Cols(); ++j) {
+            std::copy(xs.Col(j).begin(), xs.Col(j).end(), x.begin());
+            mult(x, &b);
+            for (int i = 0; i < bs.Rows(); ++i)
+                ASSERT_NEAR(b[i], bs(i, j), 1.0e-10);
+        }
+    }
+} // namespace
+
+TEST(BandedTest, TestTriDiagonalSolveMany) {
+    const int n = 20, m = 13;
+    std::unique_ptr<Sparse::Square_> mat(Sparse::NewBandDiagonal(n, 1, 1));
+    for (int i = 0; i < n; ++i) {
+        mat->Set(i, i, 4.0 + 0.1 * i);
+        if (i > 0)
+            mat->Set(i, i - 1, -1.0 - 0.05 * i);
+        if (i < n - 1)
+            mat->Set(i, i + 1, 0.5 + 0.02 * i);
+    }
+    std::unique_ptr<SquareMatrixDecomposition_> decomp(mat->Decompose());
+    const Matrix_<> b = RightHandSides(n, m);
+    Matrix_<> x;
+    decomp->SolveLeft(b, &x);
+    CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyLeft(v, r); });
+    decomp->SolveRight(b, &x);
+    CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyRight(v, r); });
+
+    // in place
+    x = b;
+    decomp->SolveLeft(x, &x);
+    CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyLeft(v, r); });
+}
+
+TEST(BandedTest, TestBandedCholeskySolveManyAndQForm) {
+    const int n = 25, m = 9;
+    std::unique_ptr<Sparse::Square_> mat(Sparse::NewBandDiagonal(n, 2, 2));
+    for (int i = 0; i < n; ++i) {
+        mat->Set(i, i, 5.0 + 0.1 * i);
+        for (int k = 1; k <= 2 && i + k < n; ++k) {
+            mat->Set(i, i + k, 1.0 / (k + 1.0 + 0.01 * i));
+            mat->Set(i + k, i, 1.0 / (k + 1.0 + 0.01 * i));
+        }
+    }
+    std::unique_ptr<Sparse::SymmetricDecomposition_> decomp(mat->DecomposeSymmetric());
+    ASSERT_TRUE(decomp);
+    const Matrix_<> b = RightHandSides(n, m);
+    Matrix_<> x;
+    decomp->Solve(b, &x);
+    CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyLeft(v, r); });
+
+    Matrix_<> j(4, n);
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < n; ++c)
+            j(r, c) = std::cos(0.4 * r * c + r);
+    SquareMatrix_<> form;
+    decomp->QForm(j, &form);
+    Vector_<> row(n), w;
+    for (int r = 0; r < 4; ++r) {
+        std::copy(j[r].begin(), j[r].end(), row.begin());
+        decomp->Solve(row, &w);
+        for (int s = 0; s < 4; ++s) {
+            double expected = 0.0;
+            for (int c = 0; c < n; ++c)
+                expected += w[c] * j(s, c);
+            ASSERT_NEAR(form(r, s), expected, 1.0e-10);
+        }
+    }
+}
+
+namespace {
+    // convection-diffusion stencil of half-width k: not symmetric, but diagonally dominant
+    void FillStencil(Sparse::Square_* mat, int k, double drift) {
+        const int n = mat->Size();
+        for (int i = 0; i < n; ++i) {
+            mat->Set(i, i, 2.0 * k + 1.0);
+            for (int d = 1; d <= k; ++d) {
+                if (i - d >= 0)
+                    mat->Set(i, i - d, -1.0 / d - drift);
+                if (i + d < n)
+                    mat->Set(i, i + d, -1.0 / d + 0.5 * drift);
+            }
+        }
+    }
+} // namespace
+
+TEST(BandedTest, TestBandedLUAllSimdLevels) {
+    const int n = 40, m = 6, k = 6;
+    std::unique_ptr<Sparse::Square_> mat(Sparse::NewBandDiagonal(n, k, k));
+    FillStencil(mat.get(), k, 0.3);
+    ASSERT_FALSE(mat->IsSymmetric());
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        std::unique_ptr<SquareMatrixDecomposition_> decomp(mat->Decompose());
+        const Matrix_<> b = RightHandSides(n, m);
+        Matrix_<> x;
+        decomp->SolveLeft(b, &x);
+        CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyLeft(v, r); });
+        decomp->SolveRight(b, &x);
+        CheckColumns(b, x, [&](const Vector_<>& v, Vector_<>* r) { mat->MultiplyRight(v, r); });
+
+        Vector_<> v(b.Col(1).begin(), b.Col(1).end()), y, r, expected;
+        decomp->SolveLeft(v, &y);
+        mat->MultiplyLeft(y, &r);
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(r[i], v[i], 1.0e-10);
+        decomp->SolveRight(v, &y);
+        mat->MultiplyRight(y, &r);
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(r[i], v[i], 1.0e-10);
+        decomp->MultiplyLeft(v, &r);
+        mat->MultiplyLeft(v, &expected);
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(r[i], expected[i], 1.0e-10);
+        decomp->MultiplyRight(v, &r);
+        mat->MultiplyRight(v, &expected);
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(r[i], expected[i], 1.0e-10);
+    }
+}
+
+TEST(BandedTest, TestBandedFactorReuse) {
+    const int n = 30, k = 3;
+    std::unique_ptr<Sparse::Square_> mat(Sparse::NewBandDiagonal(n, k, k));
+    FillStencil(mat.get(), k, 0.0);
+    ASSERT_TRUE(mat->IsSymmetric());
+    const Matrix_<> b = RightHandSides(n, 1);
+    const Vector_<> v(b.Col(0).begin(), b.Col(0).end());
+    Vector_<> x0, x1, r;
+
+    // a decomposition handed out keeps its factors when the matrix changes
+    std::unique_ptr<SquareMatrixDecomposition_> before(mat->Decompose());
+    before->SolveLeft(v, &x0);
+    std::unique_ptr<SquareMatrixDecomposition_> same(mat->Decompose());
+    same->SolveLeft(v, &x1);
+    ASSERT_EQ(x0, x1);
+    FillStencil(mat.get(), k, 0.2);
+    std::unique_ptr<SquareMatrixDecomposition_> after(mat->Decompose());
+    before->SolveLeft(v, &x1);
+    ASSERT_EQ(x0, x1);
+    after->SolveLeft(v, &x1);
+    mat->MultiplyLeft(x1, &r);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(r[i], v[i], 1.0e-10);
+
+    // once released, the factors are recomputed in place
+    before.reset();
+    same.reset();
+    after.reset();
+    for (int step = 0; step < 3; ++step) {
+        mat->Add(step, step, 1.0);
+        std::unique_ptr<SquareMatrixDecomposition_> decomp(mat->Decompose());
+        decomp->SolveLeft(v, &x1);
+        mat->MultiplyLeft(x1, &r);
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(r[i], v[i], 1.0e-10);
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/cholesky.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Dal;
+
+namespace {
+    // covariance of a few factors loading on n names, of rank min(n, n_factor) (plus ridge on the diagonal)
+    Matrix_<> FactorCovariance(int n, int n_factor, double ridge) {
+        Matrix_<> ret_val(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j) {
+                for (int f = 0; f < n_factor; ++f)
+                    ret_val(i, j) += std::cos(0.3 * i * (f + 1) + f) * std::cos(0.3 * j * (f + 1) + f);
+                if (i == j)
+                    ret_val(i, j) += ridge;
+            }
+        return ret_val;
+    }
+} // namespace
+
+TEST(CholeskyTest, TestSolveAndMultiply) {
+    const int n = 150; // spans several panels
+    const Matrix_<> a = FactorCovariance(n, 5, 0.5);
+    std::unique_ptr<SymmetricMatrixDecomposition_> chol(NewCholesky(a));
+    ASSERT_EQ(chol->Size(), n);
+    ASSERT_EQ(chol->Rank(), n);
+
+    Vector_<> x(n), b, y;
+    for (int i = 0; i < n; ++i)
+        x[i] = std::sin(1.0 + i);
+    chol->Multiply(x, &b);
+    for (int i = 0; i < n; ++i) {
+        double expected = 0.0;
+        for (int j = 0; j < n; ++j)
+            expected += a(i, j) * x[j];
+        ASSERT_NEAR(b[i], expected, 1.0e-10);
+    }
+    chol->Solve(b, &y);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(y[i], x[i], 1.0e-9);
+}
+
+TEST(CholeskyTest, TestSolveMany) {
+    const int n = 140, m = 70;
+    const Matrix_<> a = FactorCovariance(n, 6, 0.3);
+    std::unique_ptr<SymmetricMatrixDecomposition_> chol(NewCholesky(a));
+    Matrix_<> b(n, m);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j)
+            b(i, j) = std::sin(0.1 * i * j + j);
+    Matrix_<> x;
+    chol->Solve(b, &x);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j) {
+            double ax = 0.0;
+            for (int k = 0; k < n; ++k)
+                ax += a(i, k) * x(k, j);
+            ASSERT_NEAR(ax, b(i, j), 1.0e-9);
+        }
+}
+
+TEST(CholeskyTest, TestSemiDefinite) {
+    const int n = 90;
+    const Matrix_<> a = FactorCovariance(n, 3, 0.0);
+    std::unique_ptr<SymmetricMatrixDecomposition_> chol(NewCholesky(a, 1.0e-10));
+    ASSERT_EQ(chol->Rank(), 3);
+
+    // L L^T reproduces the matrix from Rank() draws per vector
+    Matrix_<> iid(3, 3), correlated;
+    for (int k = 0; k < 3; ++k)
+        iid(k, k) = 1.0;
+    chol->MakeCorrelated(iid, &correlated);
+    ASSERT_EQ(correlated.Rows(), 3);
+    ASSERT_EQ(correlated.Cols(), n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            double llt = 0.0;
+            for (int k = 0; k < 3; ++k)
+                llt += correlated(k, i) * correlated(k, j);
+            ASSERT_NEAR(llt, a(i, j), 1.0e-9);
+        }
+
+    Vector_<> x(n, 1.0), y;
+    ASSERT_THROW(chol->Solve(x, &y), Exception_);
+}
+
+TEST(CholeskyTest, TestBatchMakeCorrelatedMatchesVector) {
+    const int n = 40, nPath = 300;
+    const Matrix_<> a = FactorCovariance(n, 4, 0.1);
+    std::unique_ptr<SymmetricMatrixDecomposition_> chol(NewCholesky(a));
+    Matrix_<> iid(nPath, n), batch;
+    for (int p = 0; p < nPath; ++p)
+        for (int k = 0; k < n; ++k)
+            iid(p, k) = std::sin(0.7 * p + 1.3 * k);
+    chol->MakeCorrelated(iid, &batch);
+
+    Vector_<> z(n), one;
+    for (int p = 0; p < nPath; p += 37) {
+        std::copy(iid[p].begin(), iid[p].end(), z.begin());
+        auto end = chol->MakeCorrelated(z.begin(), &one);
+        ASSERT_EQ(end, z.end());
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(batch(p, i), one[i], 1.0e-12);
+    }
+}
+
+TEST(CholeskyTest, TestIndefinite) {
+    Matrix_<> a(2, 2);
+    a(0, 0) = 1.0;
+    a(1, 1) = -1.0;
+    ASSERT_THROW(NewCholesky(a), Exception_);
+    a(1, 1) = 0.0;
+    a(0, 1) = a(1, 0) = 2.0;
+    ASSERT_THROW(NewCholesky(a), Exception_);
+}
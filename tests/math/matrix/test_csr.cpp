@@ -0,0 +1,162 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/csr.hpp>
+#include <dal/math/matrix/lu.hpp>
+#include <dal/math/matrix/sparse.hpp>
+#include <dal/math/matrix/squarematrix.hpp>
+#include <dal/platform/simd.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Dal;
+
+namespace {
+    // 5-point operator on a k x k grid: diffusion, plus upwind convection if drift is non-zero
+    Sparse::Triplets_ Grid(int k, double drift) {
+        Sparse::Triplets_ ret_val(k * k);
+        for (int i = 0; i < k; ++i)
+            for (int j = 0; j < k; ++j) {
+                const int r = i * k + j;
+                ret_val.Add(r, r, 4.0 + drift);
+                if (i > 0)
+                    ret_val.Add(r, r - k, -1.0 - drift);
+                if (i < k - 1)
+                    ret_val.Add(r, r + k, -1.0);
+                if (j > 0)
+                    ret_val.Add(r, r - 1, -1.0);
+                if (j < k - 1)
+                    ret_val.Add(r, r + 1, -1.0);
+            }
+        return ret_val;
+    }
+
+    Matrix_<> Dense(const Sparse::Square_& a) {
+        Matrix_<> ret_val(a.Size(), a.Size());
+        for (int i = 0; i < a.Size(); ++i)
+            for (int j = 0; j < a.Size(); ++j)
+                ret_val(i, j) = a(i, j);
+        return ret_val;
+    }
+
+    Vector_<> RightHandSide(int n) {
+        Vector_<> ret_val(n);
+        for (int i = 0; i < n; ++i)
+            ret_val[i] = std::sin(0.3 * i) + 0.5;
+        return ret_val;
+    }
+} // namespace
+
+TEST(CompressedRowTest, TestAssembly) {
+    Sparse::Triplets_ t(3);
+    t.Add(2, 0, 1.0);
+    t.Add(0, 1, 2.0);
+    t.Add(2, 0, 0.5);
+    t.Add(1, 1, 3.0);
+    ASSERT_EQ(t.Entries(), 4);
+    ASSERT_THROW(t.Add(3, 0, 1.0), Exception_);
+
+    std::unique_ptr<Sparse::Square_> a(Sparse::NewCompressedRow(t));
+    ASSERT_EQ(a->Size(), 3);
+    ASSERT_DOUBLE_EQ((*a)(2, 0), 1.5);
+    ASSERT_DOUBLE_EQ((*a)(0, 1), 2.0);
+    ASSERT_DOUBLE_EQ((*a)(0, 0), 0.0);
+    a->Add(1, 1, 1.0);
+    ASSERT_DOUBLE_EQ((*a)(1, 1), 4.0);
+    a->Set(0, 1, -2.0);
+    ASSERT_DOUBLE_EQ((*a)(0, 1), -2.0);
+    ASSERT_THROW(a->Set(0, 0, 1.0), Exception_);
+    ASSERT_FALSE(a->IsSymmetric());
+}
+
+TEST(CompressedRowTest, TestMultiplyAllSimdLevels) {
+    ThreadPool_ pool("spmv", 2);
+    const int k = 70; // more rows than one parallel chunk
+    std::unique_ptr<Sparse::Square_> a(Sparse::NewCompressedRow(Grid(k, 0.7), Sparse::SolverControl_(), &pool));
+    const Matrix_<> dense = Dense(*a);
+    const Vector_<> x = RightHandSide(k * k);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Vector_<> b, bt;
+        a->MultiplyLeft(x, &b);
+        a->MultiplyRight(x, &bt);
+        for (int i = 0; i < k * k; i += 7) {
+            double expected = 0.0, expectedT = 0.0;
+            for (int j = 0; j < k * k; ++j) {
+                expected += dense(i, j) * x[j];
+                expectedT += dense(j, i) * x[j];
+            }
+            ASSERT_NEAR(b[i], expected, 1.0e-12);
+            ASSERT_NEAR(bt[i], expectedT, 1.0e-12);
+        }
+    }
+}
+
+TEST(CompressedRowTest, TestConjugateGradients) {
+    const int k = 12;
+    for (auto pre : {Sparse::Preconditioner_::NONE, Sparse::Preconditioner_::JACOBI, Sparse::Preconditioner_::ILU0}) {
+        std::unique_ptr<Sparse::Square_> a(Sparse::NewCompressedRow(Grid(k, 0.0), Sparse::SolverControl_(pre)));
+        ASSERT_TRUE(a->IsSymmetric());
+        std::unique_ptr<Sparse::SymmetricDecomposition_> cg(a->DecomposeSymmetric());
+        ASSERT_TRUE(cg);
+        const Vector_<> b = RightHandSide(k * k);
+        Vector_<> x, expected;
+        cg->Solve(b, &x);
+        std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(Dense(*a)));
+        lu->SolveLeft(b, &expected);
+        for (int i = 0; i < k * k; ++i)
+            ASSERT_NEAR(x[i], expected[i], 1.0e-9);
+    }
+}
+
+TEST(CompressedRowTest, TestBiCGSTAB) {
+    const int k = 12;
+    for (auto pre : {Sparse::Preconditioner_::JACOBI, Sparse::Preconditioner_::ILU0}) {
+        std::unique_ptr<Sparse::Square_> a(Sparse::NewCompressedRow(Grid(k, 1.5), Sparse::SolverControl_(pre)));
+        ASSERT_FALSE(a->IsSymmetric());
+        std::unique_ptr<SquareMatrixDecomposition_> solver(a->Decompose());
+        std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(Dense(*a)));
+        const Vector_<> b = RightHandSide(k * k);
+        Vector_<> x, xt, expected, expectedT;
+        solver->SolveLeft(b, &x);
+        solver->SolveRight(b, &xt);
+        lu->SolveLeft(b, &expected);
+        lu->SolveRight(b, &expectedT);
+        for (int i = 0; i < k * k; ++i) {
+            ASSERT_NEAR(x[i], expected[i], 1.0e-9);
+            ASSERT_NEAR(xt[i], expectedT[i], 1.0e-9);
+        }
+    }
+}
+
+TEST(CompressedRowTest, TestSymmetricIndefinite) {
+    // eigenvalues 3 and -1: conjugate gradients breaks down, with or without a positive diagonal
+    for (double diag : {1.0, -1.0}) {
+        Sparse::Triplets_ t(2);
+        t.Add(0, 0, diag);
+        t.Add(0, 1, 2.0);
+        t.Add(1, 0, 2.0);
+        t.Add(1, 1, diag);
+        std::unique_ptr<Sparse::Square_> a(Sparse::NewCompressedRow(t));
+        ASSERT_TRUE(a->IsSymmetric());
+        std::unique_ptr<Sparse::SymmetricDecomposition_> solver(a->DecomposeSymmetric());
+        const Vector_<> b = {1.0, 0.0};
+        Vector_<> x, expected;
+        solver->Solve(b, &x);
+        std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(Dense(*a)));
+        lu->SolveLeft(b, &expected);
+        for (int i = 0; i < 2; ++i)
+            ASSERT_NEAR(x[i], expected[i], 1.0e-9);
+    }
+}
+
+TEST(CompressedRowTest, TestNoConvergence) {
+    std::unique_ptr<Sparse::Square_> a(
+        Sparse::NewCompressedRow(Grid(20, 0.0), Sparse::SolverControl_(Sparse::Preconditioner_::NONE, 1.0e-14, 3)));
+    std::unique_ptr<SquareMatrixDecomposition_> cg(a->Decompose());
+    Vector_<> x;
+    ASSERT_THROW(cg->SolveLeft(RightHandSide(400), &x), Exception_);
+}
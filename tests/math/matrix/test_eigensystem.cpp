@@ -0,0 +1,134 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/eigensystem.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Dal;
+
+namespace {
+    Matrix_<> Correlation(int n, double decay) {
+        Matrix_<> ret_val(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                ret_val(i, j) = std::exp(-decay * std::abs(i - j));
+        return ret_val;
+    }
+} // namespace
+
+TEST(EigensystemTest, TestSymmetricEigen) {
+    const int n = 7;
+    Matrix_<> a(n, n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j <= i; ++j)
+            a(i, j) = a(j, i) = std::sin(1.0 + i * 0.7 + j * 1.3);
+    Vector_<> values;
+    Matrix_<> vecs;
+    SymmetricEigen(a, &values, &vecs);
+    for (int j = 1; j < n; ++j)
+        ASSERT_GE(values[j - 1], values[j]);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            double rebuilt = 0.0, inner = 0.0;
+            for (int k = 0; k < n; ++k) {
+                rebuilt += vecs(i, k) * values[k] * vecs(j, k);
+                inner += vecs(k, i) * vecs(k, j);
+            }
+            ASSERT_NEAR(rebuilt, a(i, j), 1.0e-12);
+            ASSERT_NEAR(inner, i == j ? 1.0 : 0.0, 1.0e-12);
+        }
+}
+
+TEST(EigensystemTest, TestNearestCorrelation) {
+    // pairwise-estimated correlations need not be consistent
+    Matrix_<> a(3, 3);
+    a(0, 0) = a(1, 1) = a(2, 2) = 1.0;
+    a(0, 1) = a(1, 0) = 0.9;
+    a(1, 2) = a(2, 1) = 0.9;
+    a(0, 2) = a(2, 0) = -0.5;
+    Vector_<> values;
+    Matrix_<> vecs;
+    SymmetricEigen(a, &values, &vecs);
+    ASSERT_LT(values[2], 0.0);
+
+    const Matrix_<> c = NearestCorrelation(a);
+    SymmetricEigen(c, &values, &vecs);
+    ASSERT_GT(values[2], -1.0e-10);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_DOUBLE_EQ(c(i, i), 1.0);
+        for (int j = 0; j < 3; ++j)
+            ASSERT_DOUBLE_EQ(c(i, j), c(j, i));
+    }
+    ASSERT_LT(c(0, 1), 0.9);
+    ASSERT_GT(c(0, 2), -0.5);
+
+    // a valid correlation is its own nearest
+    const Matrix_<> valid = Correlation(4, 0.3);
+    const Matrix_<> same = NearestCorrelation(valid);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            ASSERT_NEAR(same(i, j), valid(i, j), 1.0e-9);
+}
+
+TEST(EigensystemTest, TestPrincipalComponents) {
+    const int n = 10, rank = 3;
+    const Matrix_<> a = Correlation(n, 0.1);
+    std::unique_ptr<SymmetricMatrixDecomposition_> full(NewPrincipalComponents(a, n));
+    std::unique_ptr<SymmetricMatrixDecomposition_> pca(NewPrincipalComponents(a, rank, 1.0e-12, true));
+    ASSERT_EQ(full->Rank(), n);
+    ASSERT_EQ(pca->Size(), n);
+    ASSERT_EQ(pca->Rank(), rank);
+
+    // the full model reproduces the matrix and inverts it
+    Vector_<> x(n), b, back;
+    for (int i = 0; i < n; ++i)
+        x[i] = std::cos(0.4 * i);
+    full->Multiply(x, &b);
+    for (int i = 0; i < n; ++i) {
+        double expected = 0.0;
+        for (int j = 0; j < n; ++j)
+            expected += a(i, j) * x[j];
+        ASSERT_NEAR(b[i], expected, 1.0e-12);
+    }
+    full->Solve(b, &back);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(back[i], x[i], 1.0e-9);
+    ASSERT_THROW(pca->Solve(b, &back), Exception_);
+
+    // the reduced model keeps a unit diagonal, and more factors fit the off-diagonal better
+    std::unique_ptr<SymmetricMatrixDecomposition_> single(NewPrincipalComponents(a, 1, 1.0e-12, true));
+    Vector_<> unit(n), b1;
+    double err = 0.0, err1 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        unit.Fill(0.0);
+        unit[i] = 1.0;
+        pca->Multiply(unit, &b);
+        single->Multiply(unit, &b1);
+        ASSERT_NEAR(b[i], 1.0, 1.0e-12);
+        ASSERT_NEAR(b1[i], 1.0, 1.0e-12);
+        for (int j = 0; j < n; ++j) {
+            err += Square(b[j] - a(i, j));
+            err1 += Square(b1[j] - a(i, j));
+        }
+    }
+    ASSERT_LT(err, 0.25 * err1);
+
+    const int paths = 5;
+    Matrix_<> iid(paths, rank), correlated;
+    for (int p = 0; p < paths; ++p)
+        for (int k = 0; k < rank; ++k)
+            iid(p, k) = std::sin(1.0 + p * 0.9 + k * 2.1);
+    pca->MakeCorrelated(iid, &correlated);
+    ASSERT_EQ(correlated.Rows(), paths);
+    ASSERT_EQ(correlated.Cols(), n);
+    for (int p = 0; p < paths; ++p) {
+        Vector_<> draws(iid.Row(p).begin(), iid.Row(p).end()), single;
+        ASSERT_TRUE(pca->MakeCorrelated(draws.begin(), &single) == draws.end());
+        for (int i = 0; i < n; ++i)
+            ASSERT_NEAR(correlated(p, i), single[i], 1.0e-13);
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/matrix/lu.hpp>
+#include <dal/math/matrix/matrixs.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Dal;
+
+namespace {
+    Matrix_<> General(int n) {
+        Matrix_<> ret_val(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                ret_val(i, j) = std::sin(0.37 * i * j + 0.1 * i + 0.3 * j);
+        return ret_val;
+    }
+} // namespace
+
+TEST(LUTest, TestSolveAndMultiply) {
+    const int n = 130; // spans several panels
+    const Matrix_<> a = General(n);
+    std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(a));
+    ASSERT_EQ(lu->Size(), n);
+
+    Vector_<> x(n), b, bt, y;
+    for (int i = 0; i < n; ++i)
+        x[i] = std::cos(0.5 * i);
+    lu->MultiplyLeft(x, &b);
+    lu->MultiplyRight(x, &bt);
+    for (int i = 0; i < n; ++i) {
+        double expected = 0.0, expectedT = 0.0;
+        for (int j = 0; j < n; ++j) {
+            expected += a(i, j) * x[j];
+            expectedT += a(j, i) * x[j];
+        }
+        ASSERT_NEAR(b[i], expected, 1.0e-10);
+        ASSERT_NEAR(bt[i], expectedT, 1.0e-10);
+    }
+
+    lu->SolveLeft(b, &y);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(y[i], x[i], 1.0e-8);
+    lu->SolveRight(bt, &y);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(y[i], x[i], 1.0e-8);
+    // aliased input and output
+    lu->SolveLeft(b, &b);
+    for (int i = 0; i < n; ++i)
+        ASSERT_NEAR(b[i], x[i], 1.0e-8);
+}
+
+TEST(LUTest, TestSolveMany) {
+    const int n = 100, m = 45;
+    const Matrix_<> a = General(n);
+    std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(a));
+    Matrix_<> b(n, m);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j)
+            b(i, j) = std::cos(0.2 * i + 0.9 * j);
+    Matrix_<> x, xt;
+    lu->SolveLeft(b, &x);
+    lu->SolveRight(b, &xt);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j) {
+            double ax = 0.0, atx = 0.0;
+            for (int k = 0; k < n; ++k) {
+                ax += a(i, k) * x(k, j);
+                atx += a(k, i) * xt(k, j);
+            }
+            ASSERT_NEAR(ax, b(i, j), 1.0e-8);
+            ASSERT_NEAR(atx, b(i, j), 1.0e-8);
+        }
+}
+
+TEST(LUTest, TestNeedsPivoting) {
+    Matrix_<> a(2, 2);
+    a(0, 1) = 1.0;
+    a(1, 0) = 2.0;
+    std::unique_ptr<SquareMatrixDecomposition_> lu(NewLU(a));
+    Vector_<> x;
+    lu->SolveLeft(Vector_<>({3.0, 4.0}), &x);
+    ASSERT_NEAR(x[0], 2.0, 1.0e-14);
+    ASSERT_NEAR(x[1], 3.0, 1.0e-14);
+}
+
+TEST(LUTest, TestSingular) {
+    Matrix_<> a(3, 3);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            a(i, j) = i + j;
+    ASSERT_THROW(NewLU(a), Exception_);
+}
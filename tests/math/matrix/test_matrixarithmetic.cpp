@@ -2,8 +2,11 @@
 // Created by Cheng Li on 2018/8/14.
 //
 
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
 #include <dal/math/matrix/matrixarithmetic.hpp>
 #include <dal/math/matrix/matrixs.hpp>
+#include <dal/platform/simd.hpp>
 #include <gtest/gtest.h>
 
 using namespace Dal;
@@ -35,4 +38,120 @@ TEST(MatrixArithmeticTest, TestVols) {
         for (int j = 0; j < n; ++j)
             ASSERT_NEAR(corr(i, j), expectedCorr(i, j), 1e-5);
 }
-#endif
\ No newline at end of file
+#endif
+namespace {
+    Matrix_<> Filled(int rows, int cols, double seed) {
+        Matrix_<> ret_val(rows, cols);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                ret_val(i, j) = std::sin(seed + 0.37 * i + 1.13 * j);
+        return ret_val;
+    }
+
+    Matrix_<> NaiveProduct(const Matrix_<>& a, const Matrix_<>& b) {
+        Matrix_<> ret_val(a.Rows(), b.Cols());
+        for (int i = 0; i < a.Rows(); ++i)
+            for (int j = 0; j < b.Cols(); ++j)
+                for (int k = 0; k < a.Cols(); ++k)
+                    ret_val(i, j) += a(i, k) * b(k, j);
+        return ret_val;
+    }
+
+    Matrix_<> Transpose(const Matrix_<>& a) {
+        Matrix_<> ret_val(a.Cols(), a.Rows());
+        for (int i = 0; i < a.Rows(); ++i)
+            for (int j = 0; j < a.Cols(); ++j)
+                ret_val(j, i) = a(i, j);
+        return ret_val;
+    }
+
+    void AssertNear(const Matrix_<>& lhs, const Matrix_<>& rhs, double tol) {
+        ASSERT_EQ(lhs.Rows(), rhs.Rows());
+        ASSERT_EQ(lhs.Cols(), rhs.Cols());
+        for (int i = 0; i < lhs.Rows(); ++i)
+            for (int j = 0; j < lhs.Cols(); ++j)
+                ASSERT_NEAR(lhs(i, j), rhs(i, j), tol);
+    }
+} // namespace
+
+TEST(MatrixArithmeticTest, TestMultiplyAllSimdLevels) {
+    // odd sizes exercise the edge blocks of every kernel; k > 256 spans two panels
+    const Matrix_<> a = Filled(101, 263, 0.1);
+    const Matrix_<> b = Filled(263, 37, 0.7);
+    const Matrix_<> expected = NaiveProduct(a, b);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Matrix_<> c;
+        Matrix::Multiply(a, b, &c);
+        AssertNear(c, expected, 1.0e-10);
+    }
+}
+
+TEST(MatrixArithmeticTest, TestMultiplySmall) {
+    const Matrix_<> a = Filled(3, 4, 0.2);
+    const Matrix_<> b = Filled(4, 2, 0.3);
+    Matrix_<> c(7, 7);
+    Matrix::Multiply(a, b, &c);
+    AssertNear(c, NaiveProduct(a, b), 1.0e-14);
+}
+
+TEST(MatrixArithmeticTest, TestMultiplyParallel) {
+    ThreadPool_ pool("gemm", 3);
+    const Matrix_<> a = Filled(300, 70, 0.4);
+    const Matrix_<> b = Filled(70, 90, 0.5);
+    Matrix_<> c;
+    Matrix::Multiply(a, b, &c, &pool);
+    AssertNear(c, NaiveProduct(a, b), 1.0e-11);
+}
+
+TEST(MatrixArithmeticTest, TestMultiplyTransposed) {
+    const Matrix_<> x = Filled(200, 45, 0.6);
+    Matrix_<> xtx;
+    Matrix::MultiplyTransposed(x, x, &xtx);
+    AssertNear(xtx, NaiveProduct(Transpose(x), x), 1.0e-10);
+    for (int i = 0; i < xtx.Rows(); ++i)
+        for (int j = 0; j < i; ++j)
+            ASSERT_NEAR(xtx(i, j), xtx(j, i), 1.0e-10);
+}
+
+TEST(MatrixArithmeticTest, TestGemv) {
+    ThreadPool_ pool("gemv", 2);
+    const Matrix_<> a = Filled(1200, 7, 0.8);
+    Vector_<> x(7), xt(1200);
+    for (int j = 0; j < 7; ++j)
+        x[j] = 1.0 + j;
+    for (int i = 0; i < 1200; ++i)
+        xt[i] = std::cos(0.01 * i);
+
+    Vector_<> y, yt;
+    Matrix::Gemv(a, x, &y, false, &pool);
+    Matrix::Gemv(a, xt, &yt, true, &pool);
+    ASSERT_EQ(y.size(), 1200);
+    ASSERT_EQ(yt.size(), 7);
+    for (int i = 0; i < 1200; ++i) {
+        double expected = 0.0;
+        for (int j = 0; j < 7; ++j)
+            expected += a(i, j) * x[j];
+        ASSERT_NEAR(y[i], expected, 1.0e-12);
+    }
+    for (int j = 0; j < 7; ++j) {
+        double expected = 0.0;
+        for (int i = 0; i < 1200; ++i)
+            expected += a(i, j) * xt[i];
+        ASSERT_NEAR(yt[j], expected, 1.0e-10);
+    }
+}
+
+TEST(MatrixArithmeticTest, TestAddOuterProduct) {
+    Matrix_<> a = Filled(5, 11, 0.9);
+    const Matrix_<> original = a;
+    Vector_<> x(5), y(11);
+    for (int i = 0; i < 5; ++i)
+        x[i] = i - 2.0;
+    for (int j = 0; j < 11; ++j)
+        y[j] = 0.5 * j;
+    Matrix::AddOuterProduct(x, y, &a, 2.0);
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 11; ++j)
+            ASSERT_NEAR(a(i, j), original(i, j) + 2.0 * x[i] * y[j], 1.0e-14);
+}
@@ -5,6 +5,7 @@
 #include <dal/math/matrix/matrixs.hpp>
 #include <dal/platform/platform.hpp>
 #include <gtest/gtest.h>
+#include <cstdint>
 
 using matrix_t = Dal::Matrix_<>;
 
@@ -208,4 +209,72 @@ TEST(MatrixTest, TestMatrixColBeginEnd) {
     auto iter = col.end();
     ASSERT_EQ(col.end() - col.begin(), m1.Rows());
 }
-#endif
\ No newline at end of file
+#endif
+TEST(MatrixTest, TestMatrixAlignedContiguous) {
+    matrix_t m1(3, 5);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(m1.Data()) % Dal::CACHE_LINE_SIZE, 0);
+    ASSERT_EQ(m1.Stride(), 5);
+    m1(2, 3) = 1.;
+    ASSERT_DOUBLE_EQ(m1.Data()[2 * 5 + 3], 1.);
+    ASSERT_EQ(m1.Row(2).Data(), m1.Data() + 10);
+    ASSERT_EQ(m1.Col(3).Stride(), 5);
+}
+
+TEST(MatrixTest, TestMatrixResizeKeepsBlock) {
+    matrix_t m1(3, 4);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j)
+            m1(i, j) = 10. * i + j;
+
+    m1.Resize(4, 2);
+    ASSERT_EQ(m1.Rows(), 4);
+    ASSERT_EQ(m1.Cols(), 2);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 2; ++j)
+            ASSERT_DOUBLE_EQ(m1(i, j), 10. * i + j);
+    ASSERT_DOUBLE_EQ(m1(3, 0), 0.);
+    ASSERT_DOUBLE_EQ(m1(3, 1), 0.);
+
+    m1.Resize(2, 5);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j)
+            ASSERT_DOUBLE_EQ(m1(i, j), 10. * i + j);
+        for (int j = 2; j < 5; ++j)
+            ASSERT_DOUBLE_EQ(m1(i, j), 0.);
+    }
+
+    // fewer rows, same columns: buffer is reused
+    const double* data = m1.Data();
+    m1.Resize(1, 5);
+    ASSERT_EQ(m1.Data(), data);
+    ASSERT_DOUBLE_EQ(m1(0, 1), 1.);
+}
+
+TEST(MatrixTest, TestMatrixColumnMajor) {
+    using cm_t = Dal::Matrix_<double, Dal::MatrixLayout_::COL_MAJOR>;
+    cm_t m1(3, 2);
+    m1(1, 1) = 2.;
+    m1(2, 0) = 3.;
+    ASSERT_EQ(m1.Stride(), 3);
+    ASSERT_DOUBLE_EQ(m1.Data()[1 * 3 + 1], 2.);
+    ASSERT_DOUBLE_EQ(m1.Data()[2], 3.);
+
+    cm_t::Col_ col = m1.Col(1);
+    ASSERT_EQ(col.end() - col.begin(), 3);
+    ASSERT_DOUBLE_EQ(col[1], 2.);
+
+    cm_t::Row_ row = m1.Row(2);
+    ASSERT_EQ(row.size(), 2);
+    auto iter = row.begin();
+    ASSERT_DOUBLE_EQ(*iter, 3.);
+    ASSERT_DOUBLE_EQ(*++iter, 0.);
+    *iter = 4.;
+    ASSERT_DOUBLE_EQ(m1(2, 1), 4.);
+
+    m1.Resize(4, 3);
+    ASSERT_DOUBLE_EQ(m1(1, 1), 2.);
+    ASSERT_DOUBLE_EQ(m1(2, 0), 3.);
+    ASSERT_DOUBLE_EQ(m1(2, 1), 4.);
+    ASSERT_DOUBLE_EQ(m1(3, 0), 0.);
+    ASSERT_DOUBLE_EQ(m1(0, 2), 0.);
+}
@@ -0,0 +1,159 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/matrix/banded.hpp>
+#include <dal/math/matrix/sparse.hpp>
+#include <dal/math/matrix/tridiagonal.hpp>
+#include <dal/platform/simd.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Dal;
+
+namespace {
+    // diagonally dominant systems which differ from column to column
+    TriDiagonalBatch_ MakeBatch(int size, int count) {
+        TriDiagonalBatch_ ret_val(size, count);
+        for (int i = 0; i < size; ++i)
+            for (int s = 0; s < count; ++s) {
+                ret_val.Below()(i, s) = i > 0 ? -1.0 + 0.3 * std::sin(0.1 * i + s) : 0.0;
+                ret_val.Above()(i, s) = i < size - 1 ? -0.8 + 0.2 * std::cos(0.2 * i * s) : 0.0;
+                ret_val.Diag()(i, s) = 2.5 + 0.01 * s + 0.05 * i;
+            }
+        return ret_val;
+    }
+
+    Matrix_<> RightHandSides(int size, int count) {
+        Matrix_<> ret_val(size, count);
+        for (int i = 0; i < size; ++i)
+            for (int s = 0; s < count; ++s)
+                ret_val(i, s) = std::sin(0.3 * i + 0.7 * s);
+        return ret_val;
+    }
+
+    // compares each system against the single-system tri-diagonal decomposition
+    void CheckAgainstSingle(const TriDiagonalBatch_& batch, const Matrix_<>& b, const Matrix_<>& x) {
+        const int n = batch.Size();
+        for (int s = 0; s < batch.Count(); ++s) {
+            std::unique_ptr<Sparse::Square_> single(Sparse::NewBandDiagonal(n, 1, 1));
+            Vector_<> bs(n), xs;
+            for (int i = 0; i < n; ++i) {
+                single->Set(i, i, batch.Diag()(i, s));
+                if (i > 0)
+                    single->Set(i, i - 1, batch.Below()(i, s));
+                if (i < n - 1)
+                    single->Set(i, i + 1, batch.Above()(i, s));
+                bs[i] = b(i, s);
+            }
+            std::unique_ptr<SquareMatrixDecomposition_> decomp(single->Decompose());
+            decomp->SolveLeft(bs, &xs);
+            for (int i = 0; i < n; ++i)
+                ASSERT_NEAR(x(i, s), xs[i], 1.0e-12);
+        }
+    }
+} // namespace
+
+TEST(TriDiagonalBatchTest, TestSolveAllSimdLevels) {
+    // the count leaves a remainder for the scalar lanes at every vector width
+    const TriDiagonalBatch_ batch = MakeBatch(33, 77);
+    const Matrix_<> b = RightHandSides(33, 77);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Matrix_<> x;
+        batch.Solve(b, &x);
+        CheckAgainstSingle(batch, b, x);
+    }
+}
+
+TEST(TriDiagonalBatchTest, TestSolveInPlaceAndParallel) {
+    ThreadPool_ pool("tridiagonal", 3);
+    const TriDiagonalBatch_ batch = MakeBatch(20, 301);
+    const Matrix_<> b = RightHandSides(20, 301);
+    Matrix_<> x = b;
+    batch.Solve(x, &x, &pool);
+    CheckAgainstSingle(batch, b, x);
+}
+
+TEST(TriDiagonalBatchTest, TestFactorReuse) {
+    const TriDiagonalBatch_ batch = MakeBatch(40, 45);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        const TriDiagonalBatchFactor_ factor(batch);
+        ASSERT_EQ(factor.Size(), 40);
+        ASSERT_EQ(factor.Count(), 45);
+        for (double shift : {0.0, 1.3}) {
+            Matrix_<> b = RightHandSides(40, 45);
+            for (int i = 0; i < 40; ++i)
+                for (int s = 0; s < 45; ++s)
+                    b(i, s) += shift * i;
+            Matrix_<> x;
+            factor.Solve(b, &x);
+            CheckAgainstSingle(batch, b, x);
+        }
+    }
+}
+
+TEST(TriDiagonalBatchTest, TestSizeOne) {
+    TriDiagonalBatch_ batch(1, 3);
+    for (int s = 0; s < 3; ++s)
+        batch.Diag()(0, s) = 2.0 + s;
+    Matrix_<> b(1, 3);
+    b.Fill(6.0);
+    Matrix_<> x;
+    batch.Solve(b, &x);
+    for (int s = 0; s < 3; ++s)
+        ASSERT_NEAR(x(0, s), 6.0 / (2.0 + s), 1.0e-15);
+    ASSERT_THROW(batch.Solve(Matrix_<>(2, 3), &x), Exception_);
+}
+
+TEST(TriDiagonalBatchTest, TestSharedFactor) {
+    // one system for every right-hand side: the batch with identical columns is the reference
+    TriDiagonalBatch_ batch = MakeBatch(25, 51);
+    Vector_<> below(25), diag(25), above(25);
+    for (int i = 0; i < 25; ++i) {
+        below[i] = batch.Below()(i, 0);
+        diag[i] = batch.Diag()(i, 0);
+        above[i] = batch.Above()(i, 0);
+        for (int s = 1; s < 51; ++s) {
+            batch.Below()(i, s) = below[i];
+            batch.Diag()(i, s) = diag[i];
+            batch.Above()(i, s) = above[i];
+        }
+    }
+    const Matrix_<> b = RightHandSides(25, 51);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        const TriDiagonalFactor_ factor(below, diag, above);
+        ASSERT_EQ(factor.Size(), 25);
+        Matrix_<> x;
+        factor.Solve(b, &x);
+        CheckAgainstSingle(batch, b, x);
+    }
+
+    ThreadPool_ pool("tridiagonal", 3);
+    Matrix_<> x = b;
+    TriDiagonalFactor_(below, diag, above).Solve(x, &x, &pool);
+    CheckAgainstSingle(batch, b, x);
+}
+
+TEST(TriDiagonalBatchTest, TestZeroPivot) {
+    // the second pivot of system s vanishes: 1 - 1 * 1 / 1
+    // s = 3 falls in a vector of the first block, s = 130 in the scalar remainder of the last one
+    ThreadPool_ pool("tridiagonal", 2);
+    const Matrix_<> b = RightHandSides(5, 131);
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        for (int s : {3, 130}) {
+            TriDiagonalBatch_ batch = MakeBatch(5, 131);
+            batch.Diag()(0, s) = batch.Diag()(1, s) = batch.Below()(1, s) = batch.Above()(0, s) = 1.0;
+            Matrix_<> x;
+            ASSERT_THROW(batch.Solve(b, &x), Exception_);
+            ASSERT_THROW(batch.Solve(b, &x, &pool), Exception_);
+            ASSERT_THROW(TriDiagonalBatchFactor_(batch, &pool), Exception_);
+        }
+        ASSERT_THROW(TriDiagonalFactor_({0.0, 1.0}, {1.0, 1.0}, {1.0, 0.0}), Exception_);
+    }
+}
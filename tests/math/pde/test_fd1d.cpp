@@ -0,0 +1,103 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/pde/fd1d.hpp>
+#include <dal/math/specialfunctions.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    double BlackScholesCall(double spot, double strike, double rate, double div, double vol, double t) {
+        const double sd = vol * std::sqrt(t);
+        const double d1 = (std::log(spot / strike) + (rate - div) * t) / sd + 0.5 * sd;
+        return spot * std::exp(-div * t) * NCDF(d1) - strike * std::exp(-rate * t) * NCDF(d1 - sd);
+    }
+
+    // log-normal with a vol which steps up at t = 0.5
+    class StepVol_ : public PDE::Diffusion1D_ {
+    public:
+        static double Vol(double t) { return t < 0.5 ? 0.15 : 0.3; }
+        double Drift(double t, double) const override { return 0.02 - 0.5 * Square(Vol(t)); }
+        double Variance(double t, double) const override { return Square(Vol(t)); }
+        double Discount(double, double) const override { return 0.02; }
+    };
+
+    Vector_<> LogGrid(double spot, double strike, double std_dev, int n) {
+        return PDE::ConcentratedGrid(std::log(spot) - 6.0 * std_dev, std::log(spot) + 6.0 * std_dev, n,
+                                     std::log(strike));
+    }
+} // namespace
+
+TEST(FD1DTest, TestConcentratedGrid) {
+    const Vector_<> grid = PDE::ConcentratedGrid(-1.0, 2.0, 51, 0.3, 0.05);
+    ASSERT_EQ(grid.size(), 51);
+    ASSERT_DOUBLE_EQ(grid.front(), -1.0);
+    ASSERT_DOUBLE_EQ(grid.back(), 2.0);
+    ASSERT_NE(std::find(grid.begin(), grid.end(), 0.3), grid.end());
+    for (int i = 1; i < grid.size(); ++i)
+        ASSERT_GT(grid[i], grid[i - 1]);
+    // densest around the center
+    ASSERT_LT(grid[26] - grid[25], 0.2 * (grid[1] - grid[0]));
+    ASSERT_THROW(PDE::ConcentratedGrid(0.0, 1.0, 11, 1.5), Exception_);
+}
+
+TEST(FD1DTest, TestEuropeanCallsAndPuts) {
+    const double spot = 100.0, rate = 0.03, div = 0.01, vol = 0.2, t = 1.0;
+    const Vector_<> strikes = {80.0, 100.0, 125.0};
+    const Vector_<> grid = LogGrid(spot, 100.0, vol, 301);
+    const Vector_<> times = Vector::XRange(0.0, t, 101);
+
+    // calls and puts at all strikes in one pass
+    Matrix_<> values(grid.size(), 2 * strikes.size());
+    for (int i = 0; i < grid.size(); ++i)
+        for (int k = 0; k < strikes.size(); ++k) {
+            values(i, 2 * k) = Max(std::exp(grid[i]) - strikes[k], 0.0);
+            values(i, 2 * k + 1) = Max(strikes[k] - std::exp(grid[i]), 0.0);
+        }
+    PDE::RollBack(PDE::LogNormal_(rate, div, vol), grid, times, &values);
+    const Vector_<> prices = PDE::ValuesAt(grid, values, std::log(spot));
+
+    for (int k = 0; k < strikes.size(); ++k) {
+        const double call = BlackScholesCall(spot, strikes[k], rate, div, vol, t);
+        const double put = call - spot * std::exp(-div * t) + strikes[k] * std::exp(-rate * t);
+        ASSERT_NEAR(prices[2 * k], call, 2.0e-3);
+        ASSERT_NEAR(prices[2 * k + 1], put, 2.0e-3);
+    }
+}
+
+TEST(FD1DTest, TestRannacherSmoothing) {
+    // a digital payoff makes undamped Crank-Nicolson oscillate near the strike
+    const double spot = 1.0, vol = 0.2, t = 0.25;
+    const Vector_<> grid = LogGrid(spot, 1.0, vol * std::sqrt(t), 201);
+    const Vector_<> times = Vector::XRange(0.0, t, 26);
+    Matrix_<> smoothed(grid.size(), 1), raw;
+    for (int i = 0; i < grid.size(); ++i)
+        smoothed(i, 0) = grid[i] > 0.0 ? 1.0 : (grid[i] < 0.0 ? 0.0 : 0.5);
+    raw = smoothed;
+    PDE::RollBack(PDE::LogNormal_(0.0, 0.0, vol), grid, times, &smoothed);
+    PDE::RollBack(PDE::LogNormal_(0.0, 0.0, vol), grid, times, &raw, PDE::ThetaScheme_(0.5, 0));
+
+    const double expected = NCDF(-0.5 * vol * std::sqrt(t));
+    const double errSmoothed = std::fabs(PDE::ValuesAt(grid, smoothed, 0.0)[0] - expected);
+    const double errRaw = std::fabs(PDE::ValuesAt(grid, raw, 0.0)[0] - expected);
+    ASSERT_LT(errSmoothed, 1.0e-3);
+    ASSERT_LT(errSmoothed, errRaw);
+    for (int i = 1; i < grid.size(); ++i)
+        ASSERT_GE(smoothed(i, 0), smoothed(i - 1, 0) - 1.0e-10);
+}
+
+TEST(FD1DTest, TestTimeDependentDiffusion) {
+    const double spot = 100.0, strike = 105.0, t = 1.0;
+    const double vol = std::sqrt(0.5 * (Square(StepVol_::Vol(0.0)) + Square(StepVol_::Vol(1.0))));
+    const Vector_<> grid = LogGrid(spot, strike, vol, 301);
+    const Vector_<> times = Vector::XRange(0.0, t, 101);
+    Matrix_<> values(grid.size(), 1);
+    for (int i = 0; i < grid.size(); ++i)
+        values(i, 0) = Max(std::exp(grid[i]) - strike, 0.0);
+    PDE::RollBack(StepVol_(), grid, times, &values);
+    ASSERT_NEAR(PDE::ValuesAt(grid, values, std::log(spot))[0],
+                BlackScholesCall(spot, strike, 0.02, 0.0, vol, t), 5.0e-3);
+}
@@ -0,0 +1,89 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/concurrency/threadpool.hpp>
+#include <dal/math/pde/fd1d.hpp>
+#include <dal/math/pde/fd2d.hpp>
+#include <dal/math/specialfunctions.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+namespace {
+    // two log-normal assets, x = log(S1) and y = log(S2), without carry
+    class TwoAssets_ : public PDE::Diffusion2D_ {
+    public:
+        double vol1_, vol2_, rho_;
+        TwoAssets_(double vol1, double vol2, double rho) : vol1_(vol1), vol2_(vol2), rho_(rho) {}
+        double DriftX(double, double, double) const override { return -0.5 * vol1_ * vol1_; }
+        double DriftY(double, double, double) const override { return -0.5 * vol2_ * vol2_; }
+        double VarianceX(double, double, double) const override { return vol1_ * vol1_; }
+        double VarianceY(double, double, double) const override { return vol2_ * vol2_; }
+        double Covariance(double, double, double) const override { return rho_ * vol1_ * vol2_; }
+        double Discount(double, double, double) const override { return 0.0; }
+        bool IsTimeHomogeneous() const override { return true; }
+    };
+
+    double Margrabe(double s1, double s2, const TwoAssets_& model, double t) {
+        const double sd =
+            std::sqrt((Square(model.vol1_) + Square(model.vol2_) - 2.0 * model.rho_ * model.vol1_ * model.vol2_) * t);
+        const double d1 = std::log(s1 / s2) / sd + 0.5 * sd;
+        return s1 * NCDF(d1) - s2 * NCDF(d1 - sd);
+    }
+
+    // the exchange option max(S1 - S2, 0) on a grid centered at the spots
+    double ExchangeOption(const TwoAssets_& model,
+                          double t,
+                          const PDE::ADIScheme_& scheme,
+                          ThreadPool_* pool = nullptr,
+                          Matrix_<>* grid_values = nullptr) {
+        const Vector_<> x = PDE::ConcentratedGrid(-6.0 * model.vol1_, 6.0 * model.vol1_, 81, 0.0, 0.2);
+        const Vector_<> y = PDE::ConcentratedGrid(-6.0 * model.vol2_, 6.0 * model.vol2_, 81, 0.0, 0.2);
+        Matrix_<> values(x.size(), y.size());
+        for (int i = 0; i < x.size(); ++i)
+            for (int j = 0; j < y.size(); ++j)
+                values(i, j) = Max(std::exp(x[i]) - std::exp(y[j]), 0.0);
+        PDE::RollBack(model, x, y, Vector::XRange(0.0, t, 51), &values, scheme, pool);
+        if (grid_values)
+            *grid_values = values;
+        return PDE::ValueAt(x, y, values, 0.0, 0.0);
+    }
+} // namespace
+
+TEST(FD2DTest, TestExchangeOptionAllSchemes) {
+    const TwoAssets_ model(0.2, 0.3, 0.5);
+    const double expected = Margrabe(1.0, 1.0, model, 1.0);
+    for (auto type : {PDE::ADIType_::DOUGLAS, PDE::ADIType_::CRAIG_SNEYD, PDE::ADIType_::HUNDSDORFER_VERWER})
+        ASSERT_NEAR(ExchangeOption(model, 1.0, PDE::ADIScheme_(type)), expected, 1.0e-3);
+}
+
+TEST(FD2DTest, TestHestonLowVolOfVol) {
+    // with almost no vol of variance, started at its mean, Heston is Black-Scholes
+    const double spot = 100.0, strike = 110.0, rate = 0.03, div = 0.01, v0 = 0.04, t = 1.0;
+    const PDE::Heston_ model(rate, div, 1.5, v0, 0.001, -0.5);
+    const Vector_<> x = PDE::ConcentratedGrid(std::log(spot) - 1.2, std::log(spot) + 1.2, 121, std::log(strike));
+    const Vector_<> y = Vector::XRange(0.0, 0.12, 25);
+    Matrix_<> values(x.size(), y.size());
+    for (int i = 0; i < x.size(); ++i)
+        for (int j = 0; j < y.size(); ++j)
+            values(i, j) = Max(std::exp(x[i]) - strike, 0.0);
+    PDE::RollBack(model, x, y, Vector::XRange(0.0, t, 51), &values);
+
+    const double sd = std::sqrt(v0 * t);
+    const double d1 = (std::log(spot / strike) + (rate - div) * t) / sd + 0.5 * sd;
+    const double expected = spot * std::exp(-div * t) * NCDF(d1) - strike * std::exp(-rate * t) * NCDF(d1 - sd);
+    ASSERT_NEAR(PDE::ValueAt(x, y, values, std::log(spot), v0), expected, 5.0e-3);
+}
+
+TEST(FD2DTest, TestParallelLines) {
+    ThreadPool_ pool("adi", 3);
+    const TwoAssets_ model(0.25, 0.15, -0.3);
+    Matrix_<> serial, parallel;
+    ExchangeOption(model, 0.5, PDE::ADIScheme_(), nullptr, &serial);
+    ExchangeOption(model, 0.5, PDE::ADIScheme_(), &pool, &parallel);
+    for (int i = 0; i < serial.Rows(); ++i)
+        for (int j = 0; j < serial.Cols(); ++j)
+            ASSERT_DOUBLE_EQ(parallel(i, j), serial(i, j));
+}
@@ -0,0 +1,146 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/aad/aad.hpp>
+#include <dal/math/matrix/squarematrix.hpp>
+#include <dal/math/vectors.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+static_assert(Expr::IS_EXPRESSION<decltype(Vector_<>() * 2.0 + Vector_<>())>);
+static_assert(!Expr::IS_OPERAND<double>);
+
+TEST(ExpressionTest, TestVectorExpression) {
+    const Vector_<> b = {1.0, 2.0, 3.0, 4.0};
+    const Vector_<> c = {0.5, -1.0, 2.0, 0.0};
+    const Vector_<> d = {3.0, 3.0, 3.0, 3.0};
+    const double s = 2.5;
+
+    Vector_<> a = b * c + d * s;
+    ASSERT_EQ(a.size(), 4);
+    for (int i = 0; i < 4; ++i)
+        ASSERT_DOUBLE_EQ(a[i], b[i] * c[i] + d[i] * s);
+
+    a = (a - b) / d - 1.0;
+    for (int i = 0; i < 4; ++i)
+        ASSERT_DOUBLE_EQ(a[i], (b[i] * c[i] + d[i] * s - b[i]) / d[i] - 1.0);
+
+    // the destination may appear in its own expression, element for element
+    a = -a * 2.0;
+    a += b * c;
+    a -= 1.0;
+    a *= d;
+    for (int i = 0; i < 4; ++i) {
+        const double expected = ((b[i] * c[i] + d[i] * s - b[i]) / d[i] - 1.0) * -2.0;
+        ASSERT_DOUBLE_EQ(a[i], (expected + b[i] * c[i] - 1.0) * d[i]);
+    }
+
+    const Vector_<> e = Expr::Map(b, [](double x) { return std::sqrt(x); }) * 2.0;
+    for (int i = 0; i < 4; ++i)
+        ASSERT_DOUBLE_EQ(e[i], 2.0 * std::sqrt(b[i]));
+}
+
+TEST(ExpressionTest, TestMatrixExpression) {
+    Matrix_<> x(3, 4), y(3, 4);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j) {
+            x(i, j) = i + 0.1 * j;
+            y(i, j) = 1.0 - j;
+        }
+
+    Matrix_<> z = x * 2.0 - y;
+    ASSERT_EQ(z.Rows(), 3);
+    ASSERT_EQ(z.Cols(), 4);
+    z += x * y;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j)
+            ASSERT_DOUBLE_EQ(z(i, j), 2.0 * x(i, j) - y(i, j) + x(i, j) * y(i, j));
+
+    Matrix_<double, MatrixLayout_::COL_MAJOR> w(3, 4);
+    w = x + y;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j)
+            ASSERT_DOUBLE_EQ(w(i, j), x(i, j) + y(i, j));
+
+    // rows and columns are views: assignment writes through them
+    z.Row(1) = x.Row(0) + y.Row(2) * 3.0;
+    z.Col(3) = -x.Col(0);
+    for (int j = 0; j < 3; ++j)
+        ASSERT_DOUBLE_EQ(z(1, j), x(0, j) + 3.0 * y(2, j));
+    for (int i = 0; i < 3; ++i)
+        ASSERT_DOUBLE_EQ(z(i, 3), -x(i, 0));
+    const Vector_<> r = x.Row(2) * y.Row(2);
+    ASSERT_DOUBLE_EQ(r[3], x(2, 3) * y(2, 3));
+
+    SquareMatrix_<> p(2), q(2);
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j) {
+            p(i, j) = i + j;
+            q(i, j) = i - j;
+        }
+    SquareMatrix_<> t = p * q + 1.0;
+    t -= p;
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            ASSERT_DOUBLE_EQ(t(i, j), p(i, j) * q(i, j) + 1.0 - p(i, j));
+    ASSERT_THROW(t = x + y, Exception_);
+}
+
+TEST(ExpressionTest, TestTemporaryOperands) {
+    Matrix_<> x(2, 3);
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 3; ++j)
+            x(i, j) = 1.0 + i - 0.5 * j;
+
+    // temporaries are moved into the expression, so it may be kept past the statement which built it
+    const auto rows = x.Row(0) * 2.0 + x.Row(1);
+    const auto negated = -Vector_<>({1.0, 2.0, 3.0});
+    const auto copied = negated;
+    const auto mapped = Expr::Map(Vector_<>({4.0, 9.0, 16.0}), [](double v) { return std::sqrt(v); });
+    Vector_<> sum = rows + copied * mapped;
+    for (int j = 0; j < 3; ++j)
+        ASSERT_DOUBLE_EQ(sum[j], 2.0 * x(0, j) + x(1, j) - (j + 1.0) * (j + 2.0));
+}
+
+TEST(ExpressionTest, TestNumberExpression) {
+    Number_::tape_->Clear();
+    Vector_<Number_> b = {Number_(1.0), Number_(2.0), Number_(3.0)};
+    Vector_<Number_> c = {Number_(4.0), Number_(5.0), Number_(6.0)};
+    Number_ s(0.5);
+
+    Vector_<Number_> a = b * c + b * s;
+    ASSERT_NEAR(a[1].Value(), 2.0 * 5.0 + 2.0 * 0.5, 1e-14);
+    a[1].PropagateToStart();
+    ASSERT_NEAR(b[1].Adjoint(), 5.5, 1e-14);
+    ASSERT_NEAR(c[1].Adjoint(), 2.0, 1e-14);
+    ASSERT_NEAR(s.Adjoint(), 2.0, 1e-14);
+    ASSERT_NEAR(b[0].Adjoint(), 0.0, 1e-14);
+    Number_::tape_->Rewind();
+}
+
+TEST(ExpressionTest, TestShapesMustConform) {
+    const Vector_<> b = {1.0, 2.0, 3.0};
+    const Vector_<> c = {1.0, 2.0};
+    Vector_<> a;
+    ASSERT_THROW(a = b + c, Exception_);
+    ASSERT_THROW(a = -b * Expr::Map(c, [](double x) { return x; }), Exception_);
+    a = b;
+    ASSERT_THROW(a += c, Exception_);
+    ASSERT_THROW(a -= c * 2.0, Exception_);
+    ASSERT_THROW(a *= c, Exception_);
+    a += 1.0;
+    ASSERT_DOUBLE_EQ(a[2], 4.0);
+
+    Matrix_<> x(2, 3), y(3, 2), z(2, 3);
+    x.Fill(1.0);
+    y.Fill(2.0);
+    z.Fill(3.0);
+    ASSERT_THROW(z = x + y, Exception_);
+    ASSERT_THROW(z += y * 2.0, Exception_);
+    ASSERT_THROW(z.Row(0) = x.Col(0) + 1.0, Exception_);
+    z.Row(0) = b + x.Row(1);
+    ASSERT_DOUBLE_EQ(z(0, 2), 4.0);
+}
@@ -59,4 +59,69 @@ TEST(RootFinderTest, TestBracketedBrentWithNonBracketedInterval) {
     F1_ func;
     ASSERT_THROW(BracketedBrent_(std::make_pair(0.0, func(0.0)), std::make_pair(0.2, func(0.2)), 1e-8),
                  Exception_);
-}
\ No newline at end of file
+}
+TEST(RootFinderTest, TestBatchBrentMatchesSingleProblems) {
+    // cube roots of a, from guesses on either side
+    const Vector_<> a = {0.001, 0.5, 2.0, 27.0, 1000.0, 5.0, -8.0};
+    const Vector_<> guesses = {1.0, 0.0, 3.0, -2.0, 1.0, 10.0, 0.5};
+    const Converged_ check(1e-12, 1e-12);
+    Vector_<int> sizes;
+    BatchBrent_ batch(guesses, 1e-12);
+    const int open = batch.Solve(
+        [&](const Vector_<>& x, const Vector_<int>& which, Vector_<>* y) {
+            sizes.push_back(static_cast<int>(x.size()));
+            for (int j = 0; j < x.size(); ++j)
+                (*y)[j] = x[j] * x[j] * x[j] - a[which[j]];
+        },
+        check);
+    ASSERT_EQ(open, 0);
+    // converged problems retire, so the objective sees fewer of them
+    ASSERT_EQ(sizes.front(), a.size());
+    ASSERT_LT(sizes.back(), a.size());
+    for (int i = 1; i < sizes.size(); ++i)
+        ASSERT_LE(sizes[i], sizes[i - 1]);
+
+    // each lane follows exactly the path it would take on its own
+    for (int i = 0; i < a.size(); ++i) {
+        Brent_ finder(guesses[i], 1e-12);
+        double x = finder.NextX();
+        while (!check(finder, x * x * x - a[i]))
+            x = finder.NextX();
+        ASSERT_TRUE(batch.Converged(i));
+        ASSERT_EQ(batch.X()[i], x);
+        ASSERT_NEAR(batch.X()[i], std::cbrt(a[i]), 1e-10);
+    }
+}
+
+TEST(RootFinderTest, TestBatchBrentBracketed) {
+    F1_ func;
+    const Vector_<std::pair<double, double>> low = {{0.0, func(0.0)}, {-3.0, func(-3.0)}, {0.5, func(0.5)}};
+    const Vector_<std::pair<double, double>> high = {{2.0, func(2.0)}, {-0.5, func(-0.5)}, {1.5, func(1.5)}};
+    BatchBrent_ batch(low, high, 1e-10);
+    const auto f = [&](const Vector_<>& x, const Vector_<int>&, Vector_<>* y) {
+        for (int j = 0; j < x.size(); ++j)
+            (*y)[j] = func(x[j]);
+    };
+    ASSERT_EQ(batch.Solve(f, Converged_(1e-10, 1e-10)), 0);
+    ASSERT_NEAR(batch.X()[0], 1.0, 1e-8);
+    ASSERT_NEAR(batch.X()[1], -1.0, 1e-8);
+    ASSERT_NEAR(batch.X()[2], 1.0, 1e-8);
+
+    ASSERT_THROW(BatchBrent_(low, Vector_<std::pair<double, double>>(1, high[0])), Exception_);
+    ASSERT_THROW(BatchBrent_({std::make_pair(0.0, func(0.0))}, {std::make_pair(0.2, func(0.2))}), Exception_);
+}
+
+TEST(RootFinderTest, TestBatchBrentRetiresFailures) {
+    // the second problem has no root, and the third is undefined
+    BatchBrent_ batch(Vector_<>({0.5, 0.5, 0.5}), 1e-10);
+    const auto f = [](const Vector_<>& x, const Vector_<int>& which, Vector_<>* y) {
+        for (int j = 0; j < x.size(); ++j)
+            (*y)[j] = which[j] == 0 ? x[j] - 2.0 : which[j] == 1 ? 1.0 + x[j] * x[j] : std::log(-1.0 - x[j] * x[j]);
+    };
+    ASSERT_EQ(batch.Solve(f, Converged_(1e-10, 1e-10), 50), 1);
+    ASSERT_TRUE(batch.Converged(0));
+    ASSERT_NEAR(batch.X()[0], 2.0, 1e-10);
+    ASSERT_FALSE(batch.Converged(1));
+    ASSERT_FALSE(batch.Converged(2));
+    ASSERT_TRUE(std::isnan(batch.Y()[2]));
+}
@@ -0,0 +1,73 @@
+//
+// Created by wegam on 2026/10/19.
+//
+
+#include <cmath>
+#include <dal/math/simdmath.hpp>
+#include <gtest/gtest.h>
+
+using namespace Dal;
+
+#if DAL_SIMD_X86
+namespace {
+    // relative error of each vector function against the library one, over n points of [lo, hi]
+    template <class F_> double WorstError(F_ vector_f, double (*scalar_f)(double), double lo, double hi, int n) {
+        double ret_val = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double x = lo + (hi - lo) * i / (n - 1.0);
+            const double expected = scalar_f(x), actual = vector_f(x);
+            if (actual != expected)
+                ret_val = std::max(ret_val, std::fabs(actual - expected) / std::max(std::fabs(expected), 1e-300));
+        }
+        return ret_val;
+    }
+
+    DAL_TARGET_AVX2 double ApplyAvx2(int which, double x) {
+        const __m256d v = _mm256_set1_pd(x);
+        const __m256d r = which == 0 ? Simd::ExpAvx2(v) : which == 1 ? Simd::LogAvx2(v) : Simd::ErfcAvx2(v);
+        return _mm256_cvtsd_f64(r);
+    }
+
+    DAL_TARGET_AVX512 double ApplyAvx512(int which, double x) {
+        const __m512d v = _mm512_set1_pd(x);
+        const __m512d r = which == 0 ? Simd::ExpAvx512(v) : which == 1 ? Simd::LogAvx512(v) : Simd::ErfcAvx512(v);
+        return _mm512_cvtsd_f64(r);
+    }
+
+    void CheckFunctions(double (*apply)(int, double)) {
+        auto exp = [&](double x) { return apply(0, x); };
+        auto log = [&](double x) { return apply(1, x); };
+        auto erfc = [&](double x) { return apply(2, x); };
+        ASSERT_LT(WorstError(exp, std::exp, -745.0, 709.7, 100001), 5e-16);
+        ASSERT_LT(WorstError(log, std::log, 1e-300, 1e300, 100001), 5e-16);
+        ASSERT_LT(WorstError(log, std::log, 0.5, 2.0, 100001), 1e-15);
+        ASSERT_LT(WorstError(erfc, std::erfc, -6.0, 27.0, 100001), 2e-15);
+        for (double x : {0.0, -0.0, HUGE_VAL, -HUGE_VAL}) {
+            ASSERT_EQ(exp(x), std::exp(x));
+            ASSERT_EQ(erfc(x), std::erfc(x));
+            if (x >= 0.0) {
+                ASSERT_EQ(log(x), std::log(x));
+            }
+        }
+        ASSERT_TRUE(std::isnan(log(-1.0)));
+        for (int which = 0; which < 3; ++which)
+            ASSERT_TRUE(std::isnan(apply(which, NAN)));
+    }
+} // namespace
+
+TEST(SimdMathTest, TestAgainstLibrary) {
+    if (SimdSupported() != SimdLevel_::SCALAR)
+        CheckFunctions(ApplyAvx2);
+    if (SimdSupported() == SimdLevel_::AVX512)
+        CheckFunctions(ApplyAvx512);
+}
+#endif
+
+TEST(SimdMathTest, TestLevelGuard) {
+    const SimdLevel_ before = SimdLevel();
+    {
+        const SimdLevelGuard_ guard(SimdLevel_::SCALAR);
+        ASSERT_EQ(SimdLevel(), SimdLevel_::SCALAR);
+    }
+    ASSERT_EQ(SimdLevel(), before);
+}
@@ -6,6 +6,7 @@
 #include <dal/platform/platform.hpp>
 #include <dal/math/vectors.hpp>
 #include <dal/math/specialfunctions.hpp>
+#include <dal/platform/simd.hpp>
 #include <dal/utilities/algorithms.hpp>
 
 using namespace Dal;
@@ -32,3 +33,33 @@ TEST(SpecialFunctionsTest, TestNCDF) {
     for (size_t i = 0; i != n; ++i)
         ASSERT_NEAR(x[i], z[i], 1e-6);
 }
+
+TEST(SpecialFunctionsTest, TestArrayKernels) {
+    // odd size, so that every vector width leaves a scalar remainder
+    const auto x = Vector::XRange(-12.0, 9.0, 4001);
+    const int n = static_cast<int>(x.size());
+    for (auto level : {SimdLevel_::SCALAR, SimdLevel_::AVX2, SimdLevel_::AVX512}) {
+        const SimdLevelGuard_ guard(level);
+        Vector_<> low(n), high(n), full(n), density(n), erfc(n);
+        NCDF(&x[0], &low[0], n, NormalAccuracy_::LOW);
+        NCDF(&x[0], &high[0], n, NormalAccuracy_::HIGH);
+        NCDF(&x[0], &full[0], n);
+        NPDF(&x[0], &density[0], n);
+        for (int i = 0; i < n; ++i) {
+            const double expected = 0.5 * std::erfc(-x[i] / std::sqrt(2.0));
+            ASSERT_NEAR(low[i], expected, 1e-7);
+            ASSERT_NEAR(high[i], expected, 1e-12);
+            ASSERT_NEAR(full[i], expected, 1e-13 * expected + 1e-16);
+            ASSERT_NEAR(density[i], NPDF(x[i]), 1e-15 * density[i]);
+        }
+        for (auto accuracy : {NormalAccuracy_::LOW, NormalAccuracy_::HIGH, NormalAccuracy_::FULL}) {
+            Erfc(&x[0], &erfc[0], n, accuracy);
+            const double tol = accuracy == NormalAccuracy_::LOW ? 2e-7 : 2e-12;
+            for (int i = 0; i < n; ++i)
+                ASSERT_NEAR(erfc[i], std::erfc(x[i]), accuracy == NormalAccuracy_::FULL ? 2e-15 * erfc[i] : tol);
+        }
+    }
+
+    // the scalar imprecise version is the LOW tier
+    ASSERT_NEAR(NCDF(-1.3, false), NCDF(-1.3), 1e-7);
+}